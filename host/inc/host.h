@@ -0,0 +1,69 @@
+
+//  Host Build - Simulated Peripherals. The Firmware's Register Structs Live at
+//  Their Real Addresses (Memory Mapped by Host_Init), so the Sources Build
+//  Unchanged; Host_Run Hands the Core to init()/Sched_Run() on its Own Stack
+//  and Every WFI Advances Simulated Time One mS Through the Models Below, or
+//  to the Next USART Character Event if That Comes First. The Core Itself
+//  Takes no Simulated Time.
+
+#define HOST_FLASH_BYTES				0x8000u		//  STM32C031x6
+#define HOST_FLASH_PAGES				(HOST_FLASH_BYTES / FLASH_PAGE_BYTES)
+#define HOST_PERIPH_BYTES				0x30000u	//  APB and AHB Peripherals
+#define HOST_IOPORT_BYTES				0x2000u		//  GPIO Ports
+#define HOST_SCS_BYTES					0x1000u		//  SysTick, NVIC, SCB
+#define HOST_STACK_BYTES				0x40000u	//  Firmware Stack (Far More Than the Target Has)
+#define HOST_POLL_NS						20000u		//  Hardware Thread Poll Period
+#define HOST_ADC_CHANNELS				19u
+#define HOST_ADC_NADIR					1000u			//  Gas Signal Defaults - Zenith Above Nadir so
+#define HOST_ADC_ZENITH					3000u			//  norm_sig_avg is Live Without -n/-z
+#define HOST_ADC_SEQ_RANKS			8u				//  CHSELR Sequence Mode Ranks
+#define HOST_DMA_CHANNELS				3u
+#define HOST_FLASH_ERASE_US			22000u		//  Datasheet Typical Page Erase
+#define HOST_FLASH_PROGRAM_US		85u				//  Datasheet Typical Double Word Program
+#define HOST_US_PER_MS					1000u
+#define HOST_NS_PER_MS					1000000u
+#define HOST_NS_PER_S						1000000000ull
+#define HOST_UART_QUEUE					1024u			//  Characters Waiting to Arrive
+
+//  Model State and Knobs - Set Before or Between Host_Run Calls
+typedef struct
+{
+	uint64_t ullMs;											//  Simulated Time Since Host_Init
+	uint64_t ullNs;											//  Same, to the Last USART Event
+	uint16_t uiAdc[HOST_ADC_CHANNELS];	//  Conversion Result per Channel
+	uint16_t uiAdcLampOn;								//  Gas Signal Channel While TIM14 Drives the Lamp
+	uint16_t (*pAdcSample)(uint8_t);		//  Overrides uiAdc When Set - Channel In, Result Out
+	void (*pTick)(void);								//  Called Every mS After the Peripherals
+	void (*pUartTx)(uint8_t, uint64_t);	//  Each Character Sent, and the nS its Stop Bit Ends
+	uint32_t ulFlashEraseUs;
+	uint32_t ulFlashProgramUs;
+	uint32_t ulFlashErases;
+	uint32_t ulFlashPrograms;						//  Double Words
+	uint32_t ulFlashErrors;
+	uint32_t ulFlashPageErases[HOST_FLASH_PAGES];
+	uint32_t ulFlashWatchBase;					//  Operations in the Watched Range are Counted
+	uint32_t ulFlashWatchBytes;					//  and May be Cut Short - 0 Watches All
+	uint32_t ulFlashOps;								//  Watched Operations Done
+	uint32_t ulFlashCutOp;							//  Power Fails in This Watched Operation (From 1), 0 = Never
+	uint16_t uiFlashCutByte;						//  Once This Many of its Bytes Have Changed
+	void (*pPowerFail)(void);						//  Called at the Cut With the Flash Torn - Should Not Return
+	uint32_t ulAdcScans;
+	uint32_t ulUartRxChars;							//  Every Character on the Line, Muted or Not
+	uint32_t ulUartTxChars;
+	uint32_t ulUartOverruns;
+	uint64_t ullCpuNs;									//  Host Time the Firmware Ran (Outside WFI)
+} HostState;
+
+extern HostState sHost;
+
+/* Exported functions prototypes ---------------------------------------------*/
+void Host_Init(void);
+void Host_Run(uint32_t);
+void Host_Irq(IRQn_Type);
+bool Host_DmaWrite(uint32_t, uint32_t);
+bool Host_DmaRead(uint32_t, uint32_t *);
+uint64_t Host_UartSend(const uint8_t *, uint16_t, uint64_t, uint32_t);
+uint64_t Host_UartCharNs(void);
+bool Host_FlashLoad(const char *);
+bool Host_FlashSave(const char *);
+
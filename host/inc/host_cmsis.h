@@ -0,0 +1,88 @@
+
+//  Host Build Only - Forced Ahead of Every Source (-include). Stands in for
+//  cmsis_gcc.h, Whose Intrinsics are Arm Instructions: the Interrupt Mask is a
+//  Variable, WFI Hands the Core to the Simulated Peripherals (Host_Idle) and
+//  the NVIC Enables Live in host.c, as its Set/Clear Registers Can Not be
+//  Modelled as Plain Memory.
+#include <stdint.h>
+
+#define __CMSIS_GCC_H												//  Keep cmsis_compiler.h Off the Arm Version
+#define CMSIS_NVIC_VIRTUAL
+#define CMSIS_NVIC_VIRTUAL_HEADER_FILE		"host_nvic.h"
+
+#define __ASM											__asm
+#define __INLINE									inline
+#define __STATIC_INLINE						static inline
+#define __STATIC_FORCEINLINE			__attribute__((always_inline)) static inline
+#define __NO_RETURN								__attribute__((__noreturn__))
+#define __USED										__attribute__((used))
+#define __WEAK										__attribute__((weak))
+#define __PACKED									__attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT						struct __attribute__((packed, aligned(1)))
+#define __PACKED_UNION						union __attribute__((packed, aligned(1)))
+#define __ALIGNED(x)							__attribute__((aligned(x)))
+#define __RESTRICT								__restrict
+#define __COMPILER_BARRIER()			__ASM volatile("":::"memory")
+
+extern volatile uint32_t ulHostPrimask;
+void Host_Idle(void);
+
+__STATIC_FORCEINLINE void __enable_irq(void)
+{
+	__COMPILER_BARRIER();
+	ulHostPrimask = 0;
+}
+
+__STATIC_FORCEINLINE void __disable_irq(void)
+{
+	ulHostPrimask = 1;
+	__COMPILER_BARRIER();
+}
+
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void)
+{
+	return ulHostPrimask;
+}
+
+__STATIC_FORCEINLINE void __set_PRIMASK(uint32_t ulPriMask)
+{
+	__COMPILER_BARRIER();
+	ulHostPrimask = ulPriMask & 1u;
+}
+
+#define __NOP()										__COMPILER_BARRIER()
+#define __WFI()										Host_Idle()
+#define __WFE()										Host_Idle()
+#define __SEV()										__COMPILER_BARRIER()
+#define __ISB()										__sync_synchronize()
+#define __DSB()										__sync_synchronize()
+#define __DMB()										__sync_synchronize()
+
+#define __REV(x)									__builtin_bswap32(x)
+#define __REV16(x)								((uint32_t)((((uint32_t)(x) & 0xff00ff00u) >> 8) | (((uint32_t)(x) & 0x00ff00ffu) << 8)))
+#define __REVSH(x)								((int16_t)__builtin_bswap16((uint16_t)(x)))
+
+__STATIC_FORCEINLINE uint32_t __ROR(uint32_t ulValue, uint32_t ulShift)
+{
+	ulShift %= 32u;
+	return (ulShift == 0u) ? ulValue : (ulValue >> ulShift) | (ulValue << (32u - ulShift));
+}
+
+__STATIC_FORCEINLINE uint32_t __RBIT(uint32_t ulValue)
+{
+	uint32_t ulResult = 0;
+	uint8_t i;
+
+	for(i = 0; i < 32u; i++)
+	{
+		ulResult = (ulResult << 1) | (ulValue & 1u);
+		ulValue >>= 1;
+	}
+	return ulResult;
+}
+
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t ulValue)
+{
+	return (ulValue == 0u) ? 32u : (uint8_t)__builtin_clz(ulValue);
+}
+
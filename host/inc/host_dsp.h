@@ -0,0 +1,98 @@
+
+//  Host Build Only - Counted Arithmetic for nextgen_replay. The Replay Builds
+//  src/dsp.cpp Twice More (host_dsp_float.c and host_dsp_q31.c, Through
+//  host_dsp_build.h) With float, int64_t and uint64_t Standing for the Types
+//  Below, so Each Operation That is a Run Time Library Call on the Cortex-M0+
+//  - Soft Float, 64 Bit Multiplies and Shifts - is Counted as it Runs. The
+//  Values are Computed Exactly as Before.
+#include <type_traits>
+
+typedef struct
+{
+	uint32_t ulFAdd;										//  Float Add and Subtract
+	uint32_t ulFMul;
+	uint32_t ulFDiv;
+	uint32_t ulFCmp;
+	uint32_t ulFConv;										//  Integer to Float and Back
+	uint32_t ulLMul;										//  64 Bit Multiply
+	uint32_t ulLShift;									//  64 Bit Shift
+} HostDspOps;
+
+extern HostDspOps sHostDspOps;
+
+//  One Build of the DSP Module - Each Call Reads the Holding Registers,
+//  raw_sig and detector_temperature, and Publishes to the Input Registers
+typedef struct
+{
+	const char *pName;
+	void (*pLoad)(void);								//  dsp_load_coefficients
+	void (*pInit)(void);								//  dsp_initialize_gas_ppm
+	void (*pCalc)(void);								//  dsp_calculate_gas_ppm
+} HostDspBuild;
+
+extern const HostDspBuild sHostDspFloat;
+extern const HostDspBuild sHostDspQ31;
+
+#define HOST_DSP_INTEGRAL(T)				typename = typename std::enable_if<std::is_integral<T>::value>::type
+
+//  float - Mixed Operations With a Plain float Have Their Own Overloads, as
+//  Either Side Could Otherwise Convert
+struct HostFloat
+{
+	float f;
+
+	HostFloat() = default;
+	HostFloat(float fValue) : f(fValue) {}
+	HostFloat(double dValue) : f((float)dValue) {}			//  Constants, Folded by the Target Compiler
+	template<typename T, HOST_DSP_INTEGRAL(T)> HostFloat(T tValue) : f((float)tValue) { sHostDspOps.ulFConv ++; }
+	operator float() const { return f; }
+	template<typename T, HOST_DSP_INTEGRAL(T)> explicit operator T() const { sHostDspOps.ulFConv ++; return (T)f; }
+
+	HostFloat operator-() const { return HostFloat(-f); }		//  Sign Bit Only
+	HostFloat &operator+=(HostFloat b) { sHostDspOps.ulFAdd ++; f += b.f; return *this; }
+	HostFloat &operator-=(HostFloat b) { sHostDspOps.ulFAdd ++; f -= b.f; return *this; }
+	HostFloat &operator*=(HostFloat b) { sHostDspOps.ulFMul ++; f *= b.f; return *this; }
+	HostFloat &operator/=(HostFloat b) { sHostDspOps.ulFDiv ++; f /= b.f; return *this; }
+};
+
+#define HOST_FLOAT_OP(Op, Result, Count) \
+	inline Result operator Op(HostFloat a, HostFloat b) { sHostDspOps.Count ++; return Result(a.f Op b.f); } \
+	inline Result operator Op(HostFloat a, float b) { sHostDspOps.Count ++; return Result(a.f Op b); } \
+	inline Result operator Op(float a, HostFloat b) { sHostDspOps.Count ++; return Result(a Op b.f); }
+
+HOST_FLOAT_OP(+, HostFloat, ulFAdd)
+HOST_FLOAT_OP(-, HostFloat, ulFAdd)
+HOST_FLOAT_OP(*, HostFloat, ulFMul)
+HOST_FLOAT_OP(/, HostFloat, ulFDiv)
+HOST_FLOAT_OP(<, bool, ulFCmp)
+HOST_FLOAT_OP(>, bool, ulFCmp)
+HOST_FLOAT_OP(<=, bool, ulFCmp)
+HOST_FLOAT_OP(>=, bool, ulFCmp)
+HOST_FLOAT_OP(==, bool, ulFCmp)
+HOST_FLOAT_OP(!=, bool, ulFCmp)
+
+//  int64_t and uint64_t - Adds and Compares are Inline on the Target, so
+//  Only Multiplies and Shifts Count. Converting Out is Explicit, so the
+//  Operators Here are the Only Candidates.
+template<typename W> struct HostWide
+{
+	W w;
+
+	HostWide() = default;
+	HostWide(W wValue) : w(wValue) {}
+	template<typename T, HOST_DSP_INTEGRAL(T)> explicit operator T() const { return (T)w; }
+
+	HostWide operator-() const { return HostWide(-w); }
+	friend HostWide operator+(HostWide a, HostWide b) { return HostWide(a.w + b.w); }
+	friend HostWide operator-(HostWide a, HostWide b) { return HostWide(a.w - b.w); }
+	friend HostWide operator*(HostWide a, HostWide b) { sHostDspOps.ulLMul ++; return HostWide(a.w * b.w); }
+	friend HostWide operator<<(HostWide a, int iShift) { sHostDspOps.ulLShift ++; return HostWide(a.w << iShift); }
+	friend HostWide operator>>(HostWide a, int iShift) { sHostDspOps.ulLShift ++; return HostWide(a.w >> iShift); }
+	friend bool operator<(HostWide a, HostWide b) { return a.w < b.w; }
+	friend bool operator>(HostWide a, HostWide b) { return a.w > b.w; }
+	friend bool operator<=(HostWide a, HostWide b) { return a.w <= b.w; }
+	friend bool operator>=(HostWide a, HostWide b) { return a.w >= b.w; }
+	friend bool operator==(HostWide a, HostWide b) { return a.w == b.w; }
+	friend bool operator!=(HostWide a, HostWide b) { return a.w != b.w; }
+};
+
@@ -0,0 +1,58 @@
+
+//  Host Build Only - Included by a DSP Build (host_dsp_float.c, host_dsp_q31.c)
+//  After main.h and HOST_DSP_NAMESPACE. src/dsp.cpp is Compiled Inside That
+//  Namespace With the Counted Types in host_dsp.h, so Each Build Keeps its
+//  Own Filter State, Adapt Counter and Copy of the Holding Registers (Taken
+//  at Every Call) and Publishes to the Real Input Registers.
+#include "host_dsp.h"
+#include <string.h>
+
+#define float												HostFloat
+#define int64_t											HostWide<int64_t>
+#define uint64_t										HostWide<uint64_t>
+
+namespace HOST_DSP_NAMESPACE
+{
+typedef struct
+{
+	HOLDING_REGISTER_MAP(REG_MEMBER)
+} HostDspRegs;
+
+static_assert(sizeof(HostDspRegs) == sizeof(HoldRegs), "HostFloat Must Lay Out as float");
+
+static HostDspRegs sHRegs;
+static uint16_t dsp_adapt_counter;		//  gas_daq.c Owns the Firmware's
+
+#include "../../src/dsp.cpp"
+
+static void HostDsp_Sync(void)
+{
+	memcpy((void *)&sHRegs, &::sHRegs, sizeof(HoldRegs));
+}
+
+static void HostDsp_Load(void)
+{
+	HostDsp_Sync();
+	dsp_load_coefficients();
+}
+
+static void HostDsp_Init(void)
+{
+	HostDsp_Sync();
+	dsp_initialize_gas_ppm();
+}
+
+static void HostDsp_Calc(void)
+{
+	HostDsp_Sync();
+	dsp_calculate_gas_ppm();
+}
+}
+
+#undef float
+#undef int64_t
+#undef uint64_t
+
+const HostDspBuild HOST_DSP_BUILD = { HOST_DSP_BUILD_NAME, HOST_DSP_NAMESPACE::HostDsp_Load,
+																			HOST_DSP_NAMESPACE::HostDsp_Init, HOST_DSP_NAMESPACE::HostDsp_Calc };
+
@@ -0,0 +1,24 @@
+
+//  Host Build Only - CMSIS_NVIC_VIRTUAL_HEADER_FILE. ISER/ICER and ISPR/ICPR
+//  are Write One to Set/Clear, so Enables and Pendings are Kept in host.c;
+//  Priorities Stay in the (Memory Backed) IPR Registers.
+void Host_NVIC_EnableIRQ(int32_t);
+void Host_NVIC_DisableIRQ(int32_t);
+uint32_t Host_NVIC_GetEnableIRQ(int32_t);
+void Host_NVIC_SetPendingIRQ(int32_t);
+void Host_NVIC_ClearPendingIRQ(int32_t);
+uint32_t Host_NVIC_GetPendingIRQ(int32_t);
+__NO_RETURN void Host_SystemReset(void);
+
+#define NVIC_SetPriorityGrouping		__NVIC_SetPriorityGrouping
+#define NVIC_GetPriorityGrouping		__NVIC_GetPriorityGrouping
+#define NVIC_EnableIRQ(IRQn)				Host_NVIC_EnableIRQ((int32_t)(IRQn))
+#define NVIC_GetEnableIRQ(IRQn)			Host_NVIC_GetEnableIRQ((int32_t)(IRQn))
+#define NVIC_DisableIRQ(IRQn)				Host_NVIC_DisableIRQ((int32_t)(IRQn))
+#define NVIC_GetPendingIRQ(IRQn)		Host_NVIC_GetPendingIRQ((int32_t)(IRQn))
+#define NVIC_SetPendingIRQ(IRQn)		Host_NVIC_SetPendingIRQ((int32_t)(IRQn))
+#define NVIC_ClearPendingIRQ(IRQn)	Host_NVIC_ClearPendingIRQ((int32_t)(IRQn))
+#define NVIC_SetPriority						__NVIC_SetPriority
+#define NVIC_GetPriority						__NVIC_GetPriority
+#define NVIC_SystemReset						Host_SystemReset
+
@@ -0,0 +1,181 @@
+/**
+  ******************************************************************************
+  * 											Next Generation CO2 Sensor
+  * 											Cortex-M0+ Cycle Benchmark - Bench Image
+  *
+  *   Cross Compiled for thumbv6m With the Firmware Sources (CMakeLists.txt,
+  *   Target nextgen_bench) and Run by nextgen_iss, Which Counts the Cycles of
+  *   Each Case Below. A Case Times One Call of a Hot Function Through a
+  *   Wrapper; "call overhead" is the Wrapper Alone.
+  ******************************************************************************
+  */
+
+//  Includes
+#include  "main.h"
+#include  "bench.h"
+
+#define BENCH_READ_REGS					10u					//  Registers per FC03 / FC04 Request
+#define BENCH_CRC_LONG					(BUFFER_SIZE - 1u)
+
+extern void (*__init_array_start[])(void);
+extern void (*__init_array_end[])(void);
+
+static Buffer sBenchRx;
+static Buffer sBenchTx;
+static uint16_t uiBenchWritable;								//  First Read Write Holding Register
+static volatile uint32_t ulBenchSink;
+
+static void Bench_Nothing(void);
+static void Bench_Request(uint8_t, uint16_t, uint16_t);
+static void Bench_SetupCrcShort(void);
+static void Bench_SetupCrcLong(void);
+static void Bench_Crc(void);
+static void Bench_SetupRead(void);
+static void Bench_SetupReadInput(void);
+static void Bench_SetupWrite(void);
+static void Bench_Modbus(void);
+static void Bench_RecordSize(void);
+
+const BenchCase sBenchCases[] =
+{
+	{ "call overhead",                   NULL,                 Bench_Nothing,      16 },
+	{ "Calc_crc 8 bytes",                Bench_SetupCrcShort,  Bench_Crc,          16 },
+	{ "Calc_crc 127 bytes",              Bench_SetupCrcLong,   Bench_Crc,          16 },
+	{ "Handle_Rcvd_Msg FC03 10 regs",    Bench_SetupRead,      Bench_Modbus,       16 },
+	{ "Handle_Rcvd_Msg FC04 10 regs",    Bench_SetupReadInput, Bench_Modbus,       16 },
+	{ "Handle_Rcvd_Msg FC16 1 reg",      Bench_SetupWrite,     Bench_Modbus,       16 },
+	{ "FlashGetRecordSize",              NULL,                 Bench_RecordSize,   16 },
+	{ "dsp_poly gas2 (float)",           NULL,                 BenchDsp_PolyFloat, 16 },
+	{ "dsp_poly_q31 gas2",               NULL,                 BenchDsp_PolyQ31,   16 },
+	{ "dsp_load_coefficients (float)",   NULL,                 BenchDsp_LoadFloat, 4 },
+	{ "dsp_load_coefficients (q31)",     NULL,                 BenchDsp_LoadQ31,   4 },
+	{ "dsp_calculate_gas_ppm (float)",   NULL,                 BenchDsp_CalcFloat, 64 },
+	{ "dsp_calculate_gas_ppm (q31)",     NULL,                 BenchDsp_CalcQ31,   64 }
+};
+
+const uint32_t ulBenchCases = sizeof(sBenchCases) / sizeof(sBenchCases[0]);
+
+/**
+  * @brief  Runs Once Before the Cases: Static Constructors, SysTick Free
+  *         Running (the DSP Times its Stages With it, as on the Target), the
+  *         CRC Unit, and a Settled Measurement for the DSP
+  * @param  None
+  * @retval None
+  */
+extern "C" void Bench_Init(void)
+{
+	void (**pInit)(void);
+	uint16_t i;
+
+	for(pInit = __init_array_start; pInit < __init_array_end; pInit++)
+	{
+		(*pInit)();
+	}
+	SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+	SysTick->VAL = 0;
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+	CRC_Init();
+
+	for(i = 0; i < uiHRegCount; i++)
+	{
+		if(sHRegMap[i].ucAccess == REG_READ_WRITE)
+		{
+			uiBenchWritable = i;
+			break;
+		}
+	}
+
+	raw_sig = 19850;
+	detector_temperature = 29900;
+	BenchDsp_Init();
+}
+
+static void Bench_Nothing(void)
+{
+}
+
+/**
+  * @brief  Build a Request Frame in sBenchRx, Address Through CRC
+  * @param  ucCommand - Function Code
+  * @param  uiAddress - First Register
+  * @param  uiCount - Registers
+  * @retval None
+  */
+static void Bench_Request(uint8_t ucCommand, uint16_t uiAddress, uint16_t uiCount)
+{
+	const uint8_t *pValue;
+	uint16_t uiCRC;
+	uint16_t i;
+
+	sBenchRx.Buff[0] = sHRegs.slave_address;
+	sBenchRx.Buff[1] = ucCommand;
+	sBenchRx.Buff[2] = uiAddress >> 8;
+	sBenchRx.Buff[3] = uiAddress & 0xff;
+	sBenchRx.Buff[4] = uiCount >> 8;
+	sBenchRx.Buff[5] = uiCount & 0xff;
+	sBenchRx.end = 6;
+	if(ucCommand == 16)
+	{
+		//  Write Back the Values Already There, so Every Call Does the Same
+		sBenchRx.Buff[sBenchRx.end++] = uiCount * 2u;
+		for(i = 0; i < uiCount; i++)
+		{
+			pValue = (const uint8_t *)pHRegs + sHRegMap[uiAddress - HOLDING_REGISTERS_OFFSET + i].uiOffset;
+			sBenchRx.Buff[sBenchRx.end++] = pValue[1];
+			sBenchRx.Buff[sBenchRx.end++] = pValue[0];
+		}
+	}
+	uiCRC = CRC_Calc(sBenchRx.Buff, sBenchRx.end);
+	sBenchRx.Buff[sBenchRx.end++] = uiCRC & 0xff;
+	sBenchRx.Buff[sBenchRx.end++] = uiCRC >> 8;
+	sBenchRx.ptr = 0;
+	sBenchTx.end = 0;
+	sBenchTx.ptr = 0;
+}
+
+static void Bench_SetupCrcShort(void)
+{
+	Bench_Request(3, HOLDING_REGISTERS_OFFSET, BENCH_READ_REGS);
+}
+
+static void Bench_SetupCrcLong(void)
+{
+	uint16_t i;
+
+	for(i = 0; i < BENCH_CRC_LONG; i++)
+	{
+		sBenchRx.Buff[i] = (uint8_t)i;
+	}
+	sBenchRx.end = BENCH_CRC_LONG;
+}
+
+static void Bench_Crc(void)
+{
+	ulBenchSink = Calc_crc(sBenchRx);
+}
+
+static void Bench_SetupRead(void)
+{
+	Bench_Request(3, HOLDING_REGISTERS_OFFSET, BENCH_READ_REGS);
+}
+
+static void Bench_SetupReadInput(void)
+{
+	Bench_Request(4, INPUT_REGISTERS_OFFSET, BENCH_READ_REGS);
+}
+
+static void Bench_SetupWrite(void)
+{
+	Bench_Request(16, HOLDING_REGISTERS_OFFSET + uiBenchWritable, 1);
+}
+
+static void Bench_Modbus(void)
+{
+	Handle_Rcvd_Msg(sBenchRx, sBenchTx);
+}
+
+static void Bench_RecordSize(void)
+{
+	ulBenchSink = FlashGetRecordSize();
+}
+
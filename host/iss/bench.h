@@ -0,0 +1,26 @@
+
+//  Cortex-M0+ Cycle Benchmark Only - the Case Table of the Bench Image, Which
+//  nextgen_iss (host_iss.c) Reads as Four Words per Case. Setup Runs Before
+//  Every Call and is Not Counted; Run is.
+typedef struct
+{
+	const char *pName;
+	void (*pSetup)(void);								//  NULL for None
+	void (*pRun)(void);
+	uint32_t ulCalls;
+} BenchCase;
+
+extern const BenchCase sBenchCases[];
+extern const uint32_t ulBenchCases;
+
+extern "C" void Bench_Init(void);
+
+//  bench_dsp.c - src/dsp.cpp as Both the Float and the Q31 Build
+void BenchDsp_Init(void);
+void BenchDsp_LoadFloat(void);
+void BenchDsp_LoadQ31(void);
+void BenchDsp_CalcFloat(void);
+void BenchDsp_CalcQ31(void);
+void BenchDsp_PolyFloat(void);
+void BenchDsp_PolyQ31(void);
+
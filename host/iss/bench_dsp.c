@@ -0,0 +1,60 @@
+
+//  Cortex-M0+ Cycle Benchmark Only - src/dsp.cpp Compiled Twice More, Each
+//  Build in its Own Namespace With its Own Filter State, so One Image Times
+//  Both and Reaches the Static Polynomial Evaluators
+#include  "main.h"
+#include  "bench.h"
+
+#undef DSP_FIXED_POINT
+namespace BenchDspFloat
+{
+#include "../../src/dsp.cpp"
+}
+
+#define DSP_FIXED_POINT
+namespace BenchDspQ31
+{
+#include "../../src/dsp.cpp"
+}
+
+static volatile float fBenchX = 0.5f;					//  tcor hat Half way to Span 1
+static volatile int32_t lBenchX = 0x08000000;		//  The Same, Q31 / 2^DSP_PPM_X_SHIFT
+static volatile float fBenchSink;
+static volatile int32_t lBenchSink;
+
+void BenchDsp_Init(void)
+{
+	BenchDspFloat::dsp_initialize_gas_ppm();
+	BenchDspQ31::dsp_initialize_gas_ppm();
+}
+
+void BenchDsp_LoadFloat(void)
+{
+	BenchDspFloat::dsp_load_coefficients();
+}
+
+void BenchDsp_LoadQ31(void)
+{
+	BenchDspQ31::dsp_load_coefficients();
+}
+
+void BenchDsp_CalcFloat(void)
+{
+	BenchDspFloat::dsp_calculate_gas_ppm();
+}
+
+void BenchDsp_CalcQ31(void)
+{
+	BenchDspQ31::dsp_calculate_gas_ppm();
+}
+
+void BenchDsp_PolyFloat(void)
+{
+	fBenchSink = BenchDspFloat::dsp_poly(GAS2_PPM_COEFFS, NUM_GAS2_PPM_COEFF, fBenchX);
+}
+
+void BenchDsp_PolyQ31(void)
+{
+	lBenchSink = BenchDspQ31::dsp_poly_q31(&BenchDspQ31::gas2_poly, lBenchX);
+}
+
@@ -0,0 +1,1205 @@
+/**
+  ******************************************************************************
+  * 											Next Generation CO2 Sensor
+  * 											Host Build - Simulated Peripherals
+  *
+  ******************************************************************************
+  */
+
+//  Includes
+#include  "main.h"
+#include  "stm32c0xx_it.h"
+#include  "host.h"
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+#include  <time.h>
+#include  <pthread.h>
+#include  <sys/mman.h>
+#include  <ucontext.h>
+
+//  Address Ranges Backed by Memory at Their Real Addresses
+typedef struct
+{
+	uint32_t ulBase;
+	uint32_t ulBytes;
+} HostRegion;
+
+//  A Character on its Way to the USART Receiver
+typedef struct
+{
+	uint64_t ullEndNs;										//  When its Stop Bit Ends
+	uint8_t ucData;
+} HostUartChar;
+
+enum HOST_UART_EVENT
+{
+	HOST_UART_NONE = 0,
+	HOST_UART_RX,
+	HOST_UART_RTO,
+	HOST_UART_TX
+};
+
+enum HOST_FLASH_OP
+{
+	HOST_FLASH_IDLE = 0,
+	HOST_FLASH_ERASE,
+	HOST_FLASH_PROGRAM
+};
+
+static const HostRegion sHostRegions[] =
+{
+	{ FLASH_BASE,		HOST_FLASH_BYTES },
+	{ PERIPH_BASE,	HOST_PERIPH_BYTES },
+	{ IOPORT_BASE,	HOST_IOPORT_BYTES },
+	{ SCS_BASE,			HOST_SCS_BYTES }
+};
+
+static DMA_Channel_TypeDef * const pHostDma[HOST_DMA_CHANNELS] = { DMA1_Channel1, DMA1_Channel2, DMA1_Channel3 };
+static const IRQn_Type eHostDmaIRQ[HOST_DMA_CHANNELS] = { DMA1_Channel1_IRQn, DMA1_Channel2_3_IRQn, DMA1_Channel2_3_IRQn };
+
+//  Handlers by IRQ Number (stm32c0xx_it.c)
+typedef struct
+{
+	IRQn_Type IRQn;
+	void (*pHandler)(void);
+} HostVector;
+
+static const HostVector sHostVectors[] =
+{
+	{ FLASH_IRQn,						FLASH_IRQHandler },
+	{ RTC_IRQn,							RTC_IRQHandler },
+	{ EXTI4_15_IRQn,				EXTI4_15_IRQHandler },
+	{ ADC1_IRQn,						ADC1_IRQHandler },
+	{ DMA1_Channel1_IRQn,		DMA1_Channel1_IRQHandler },
+	{ DMA1_Channel2_3_IRQn,	DMA1_Channel2_3_IRQHandler },
+	{ TIM14_IRQn,						TIM14_IRQHandler },
+	{ I2C1_IRQn,						I2C1_IRQHandler },
+	{ USART1_IRQn,					USART1_IRQHandler }
+};
+
+HostState sHost;
+volatile uint32_t ulHostPrimask = 0;
+
+static uint32_t ulHostNvicEnabled = 0;
+static uint32_t ulHostNvicPending = 0;
+static bool bHostInIrq = false;
+static bool bHostWoke = false;
+
+static uint64_t ullHostFlash[HOST_FLASH_BYTES / 8];		//  Contents as Last Programmed
+static uint8_t ucHostFlashOp = HOST_FLASH_IDLE;
+static uint32_t ulHostFlashAddress;
+static uint32_t ulHostFlashUs;											//  Left on the Operation in Progress
+
+static uint16_t uiHostDmaReload[HOST_DMA_CHANNELS];	//  CNDTR as Programmed
+static uint16_t uiHostDmaLeft[HOST_DMA_CHANNELS];		//  CNDTR as Last Left by the Model
+
+static HostUartChar sHostUartRx[HOST_UART_QUEUE];
+static uint16_t uiHostUartRxHead = 0;
+static uint16_t uiHostUartRxCount = 0;
+static uint64_t ullHostUartQueuedNs = 0;						//  Last Queued Character Ends
+static uint64_t ullHostUartLastRxNs = 0;						//  Last Character Received Ended
+static bool bHostUartRto = false;										//  Receiver Timeout Counting
+static bool bHostUartTx = false;										//  Character Going Out
+static uint64_t ullHostUartTxNs;										//  When it Ends
+static uint8_t ucHostUartTx;
+
+static ucontext_t sHostCpu;
+static ucontext_t sHostCaller;
+static uint8_t ucHostStack[HOST_STACK_BYTES] __attribute__((aligned(16)));
+static bool bHostBooted = false;
+static bool bHostInCpu = false;
+static uint64_t ullHostEnd = 0;
+static uint64_t ullHostResumeNs = 0;								//  Host Clock When the Firmware Last Left WFI
+
+void init(void);
+
+static void Host_Cpu(void);
+static void Host_Step(bool);
+static void Host_IrqDeliver(void);
+static void Host_ClearFlags(void);
+static void Host_AdcReact(void);
+static void *Host_Hardware(void *);
+static uint64_t Host_Clock(void);
+static uint16_t Host_AdcSample(uint8_t);
+static void Host_AdcScan(void);
+static DMA_Channel_TypeDef *Host_DmaChannel(uint32_t, uint8_t *, uint32_t *);
+static void Host_DmaCount(uint8_t);
+static uint32_t Host_TimerUpdates(TIM_TypeDef *);
+static void Host_RtcTick(void);
+static uint64_t Host_UartNs(uint32_t);
+static bool Host_UartEvent(uint64_t, bool);
+static void Host_UartReceive(uint64_t, uint8_t);
+static bool Host_UartTxStart(uint64_t, bool);
+static void Host_FlashTick(void);
+static bool Host_FlashStart(void);
+static void Host_FlashFinish(void);
+static bool Host_FlashCut(uint32_t, uint16_t);
+
+/**
+  * @brief  Map the Flash, Peripheral, GPIO and Core Register Ranges at Their
+  *         Target Addresses, Load Reset State and Start the Hardware Thread.
+  *         Call Once, Before Anything Touches a Register.
+  * @param  None
+  * @retval None
+  */
+void Host_Init(void)
+{
+	pthread_t sThread;
+	uint8_t i;
+
+	for(i = 0; i < sizeof(sHostRegions) / sizeof(sHostRegions[0]); i++)
+	{
+		if(mmap((void*)(uintptr_t)sHostRegions[i].ulBase, sHostRegions[i].ulBytes, PROT_READ | PROT_WRITE,
+						MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0) != (void*)(uintptr_t)sHostRegions[i].ulBase)
+		{
+			fprintf(stderr, "host: can not map 0x%08x (build non-PIE)\n", (unsigned)sHostRegions[i].ulBase);
+			exit(EXIT_FAILURE);
+		}
+	}
+	memset((void*)(uintptr_t)FLASH_BASE, 0xff, HOST_FLASH_BYTES);
+	memset(ullHostFlash, 0xff, sizeof(ullHostFlash));
+
+	//  Ready Flags the Firmware Waits on, Set From Reset
+	SET_BIT(RCC->CR, RCC_CR_HSION | RCC_CR_HSIRDY);
+	SET_BIT(RCC->CSR2, RCC_CSR2_LSIRDY);
+	SET_BIT(USART1->ISR, USART_ISR_TEACK | USART_ISR_REACK | USART_ISR_TXE_TXFNF | USART_ISR_TC);
+	SET_BIT(ADC1->ISR, ADC_ISR_CCRDY);
+
+	sHost.ulFlashEraseUs = HOST_FLASH_ERASE_US;
+	sHost.ulFlashProgramUs = HOST_FLASH_PROGRAM_US;
+	sHost.uiAdc[ADC_CHANNEL_GAS_SIGNAL] = HOST_ADC_NADIR;
+	sHost.uiAdcLampOn = HOST_ADC_ZENITH;
+	sHost.uiAdc[ADC_CHANNEL_TEMP_SIGNAL] = 2048;
+	sHost.uiAdc[ADC_CHANNEL_VIN_ADC] = 2500;
+	sHost.uiAdc[ADC_CHANNEL_V_LAMP_PLUS] = 2000;
+	sHost.uiAdc[ADC_CHANNEL_V_LAMP_MINUS] = 100;
+
+	if(pthread_create(&sThread, NULL, Host_Hardware, NULL) == 0)
+	{
+		pthread_detach(sThread);
+	}
+}
+
+/**
+  * @brief  Run the Firmware for ulMs of Simulated Time. The First Call Boots it
+  *         (init, Then the Scheduler); Later Calls Resume it Where it Idled.
+  * @param  ulMs - Simulated mS
+  * @retval None
+  */
+void Host_Run(uint32_t ulMs)
+{
+	ullHostEnd = sHost.ullMs + ulMs;
+	if(!bHostBooted)
+	{
+		getcontext(&sHostCpu);
+		sHostCpu.uc_stack.ss_sp = ucHostStack;
+		sHostCpu.uc_stack.ss_size = sizeof(ucHostStack);
+		sHostCpu.uc_link = &sHostCaller;
+		makecontext(&sHostCpu, Host_Cpu, 0);
+		bHostBooted = true;
+		ullHostResumeNs = Host_Clock();
+	}
+	bHostInCpu = true;
+	swapcontext(&sHostCaller, &sHostCpu);
+	bHostInCpu = false;
+}
+
+/**
+  * @brief  The Firmware's Reset Handler - Runs on ucHostStack
+  * @param  None
+  * @retval None
+  */
+static void Host_Cpu(void)
+{
+	init();
+	Sched_Run();
+}
+
+/**
+  * @brief  WFI. Steps the Peripherals One mS at a Time, or to the Next USART
+  *         Event Within the mS, Until an Interrupt is Taken. In Stop
+  *         (SLEEPDEEP) SysTick, the Timers and the ADC are Frozen and Only the
+  *         RTC and the USART Run. Control Returns to Host_Run's Caller When the
+  *         Requested Time is Used Up, and Resumes Here Next Time. The Host
+  *         Time Since the Last Return is Charged to the Firmware.
+  * @param  None
+  * @retval None
+  */
+void Host_Idle(void)
+{
+	bool bStop = READ_BIT(SCB->SCR, SCB_SCR_SLEEPDEEP_Msk) != 0;
+
+	sHost.ullCpuNs += Host_Clock() - ullHostResumeNs;
+	bHostWoke = false;
+	do
+	{
+		while(bHostInCpu && (sHost.ullMs >= ullHostEnd))
+		{
+			swapcontext(&sHostCpu, &sHostCaller);
+		}
+		if(!Host_UartEvent((sHost.ullMs + 1u) * HOST_NS_PER_MS, bStop))
+		{
+			Host_Step(bStop);
+		}
+	} while(!bHostWoke && bHostInCpu);
+	ullHostResumeNs = Host_Clock();
+}
+
+/**
+  * @brief  Host Monotonic Clock
+  * @param  None
+  * @retval nS
+  */
+static uint64_t Host_Clock(void)
+{
+	struct timespec sNow;
+
+	clock_gettime(CLOCK_MONOTONIC, &sNow);
+	return (uint64_t)sNow.tv_sec * HOST_NS_PER_S + (uint64_t)sNow.tv_nsec;
+}
+
+/**
+  * @brief  Advance the Peripheral Models One mS
+  * @param  bStop - Core in Stop Mode
+  * @retval None
+  */
+static void Host_Step(bool bStop)
+{
+	uint32_t ulUpdates;
+
+	sHost.ullMs ++;
+	sHost.ullNs = sHost.ullMs * HOST_NS_PER_MS;
+	Host_AdcReact();
+	Host_RtcTick();
+	if(!bStop)
+	{
+		if((SysTick->CTRL & (SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_TICKINT_Msk)) ==
+			 (SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_TICKINT_Msk))
+		{
+			SysTick_Handler();
+			bHostWoke = true;
+		}
+		for(ulUpdates = Host_TimerUpdates(TIM3); ulUpdates; ulUpdates--)
+		{
+			Host_AdcScan();								//  TRGO on Update
+		}
+		for(ulUpdates = Host_TimerUpdates(TIM14); ulUpdates; ulUpdates--)
+		{
+			if(READ_BIT(TIM14->DIER, TIM_DIER_UIE))
+			{
+				SET_BIT(TIM14->SR, TIM_SR_UIF);
+				Host_Irq(TIM14_IRQn);
+			}
+		}
+		Host_TimerUpdates(TIM17);
+	}
+	Host_FlashTick();
+	Host_ClearFlags();
+	Host_IrqDeliver();
+	if(sHost.pTick)
+	{
+		sHost.pTick();
+	}
+}
+
+/**
+  * @brief  Raise an Interrupt. Taken Now if Enabled, Otherwise Left Pending.
+  * @param  IRQn - Device Interrupt
+  * @retval None
+  */
+void Host_Irq(IRQn_Type IRQn)
+{
+	ulHostNvicPending |= 1u << IRQn;
+	Host_IrqDeliver();
+}
+
+/**
+  * @brief  Take Every Pending, Enabled Interrupt, Lowest Number First. A
+  *         Handler Raising Another Only Leaves it Pending Until it Returns.
+  *         Handler Host Time is Charged to the Firmware.
+  * @param  None
+  * @retval None
+  */
+static void Host_IrqDeliver(void)
+{
+	uint32_t ulReady;
+	uint32_t ulTimSR, ulUsartISR, ulUsartCR1;
+	uint64_t ullStart;
+	uint8_t ucIRQn, i;
+
+	if(bHostInIrq)
+	{
+		return;
+	}
+	bHostInIrq = true;
+	while((ulReady = ulHostNvicPending & ulHostNvicEnabled) != 0)
+	{
+		ucIRQn = (uint8_t)__builtin_ctz(ulReady);
+		ulHostNvicPending &= ~(1u << ucIRQn);
+		ulTimSR = TIM14->SR;
+		ulUsartISR = USART1->ISR;
+		ulUsartCR1 = USART1->CR1;
+		ullStart = Host_Clock();
+		for(i = 0; i < sizeof(sHostVectors) / sizeof(sHostVectors[0]); i++)
+		{
+			if(sHostVectors[i].IRQn == ucIRQn)
+			{
+				sHostVectors[i].pHandler();
+			}
+		}
+		sHost.ullCpuNs += Host_Clock() - ullStart;
+		if(ucIRQn == TIM14_IRQn)
+		{
+			TIM14->SR &= ulTimSR;							//  rc_w0 - Only Zeros Written Clear
+		}
+		if((ucIRQn == USART1_IRQn) && (ulUsartISR & USART_ISR_RXNE_RXFNE) && (ulUsartCR1 & USART_CR1_RXNEIE_RXFNEIE))
+		{
+			CLEAR_BIT(USART1->ISR, USART_ISR_RXNE_RXFNE);	//  The Handler Read RDR
+		}
+		Host_ClearFlags();
+		bHostWoke = true;
+	}
+	bHostInIrq = false;
+}
+
+/**
+  * @brief  Apply the Flag Clear Registers (Write One to Clear) to the Status
+  *         Registers They Stand for, and the USART Requests
+  * @param  None
+  * @retval None
+  */
+static void Host_ClearFlags(void)
+{
+	uint32_t ulICR = USART1->ICR;
+
+	CLEAR_BIT(DMA1->ISR, DMA1->IFCR);
+	DMA1->IFCR = 0;
+	CLEAR_BIT(RTC->SR, RTC->SCR);
+	RTC->SCR = 0;
+
+	//  ICR Bits Line up With ISR, Except TXFECF
+	CLEAR_BIT(USART1->ISR, (ulICR & ~USART_ICR_TXFECF) | ((ulICR & USART_ICR_TXFECF) ? USART_ISR_TXFE : 0u));
+	USART1->ICR = 0;
+	if(READ_BIT(USART1->RQR, USART_RQR_MMRQ) && READ_BIT(USART1->CR1, USART_CR1_MME))
+	{
+		SET_BIT(USART1->ISR, USART_ISR_RWU);
+	}
+	if(READ_BIT(USART1->RQR, USART_RQR_RXFRQ))
+	{
+		CLEAR_BIT(USART1->ISR, USART_ISR_RXNE_RXFNE);
+	}
+	USART1->RQR = 0;
+}
+
+void Host_NVIC_EnableIRQ(int32_t IRQn)
+{
+	if(IRQn >= 0)
+	{
+		ulHostNvicEnabled |= 1u << IRQn;
+	}
+}
+
+void Host_NVIC_DisableIRQ(int32_t IRQn)
+{
+	if(IRQn >= 0)
+	{
+		ulHostNvicEnabled &= ~(1u << IRQn);
+	}
+}
+
+uint32_t Host_NVIC_GetEnableIRQ(int32_t IRQn)
+{
+	return (IRQn >= 0) ? (ulHostNvicEnabled >> IRQn) & 1u : 0u;
+}
+
+void Host_NVIC_SetPendingIRQ(int32_t IRQn)
+{
+	if(IRQn >= 0)
+	{
+		ulHostNvicPending |= 1u << IRQn;
+	}
+}
+
+void Host_NVIC_ClearPendingIRQ(int32_t IRQn)
+{
+	if(IRQn >= 0)
+	{
+		ulHostNvicPending &= ~(1u << IRQn);
+	}
+}
+
+uint32_t Host_NVIC_GetPendingIRQ(int32_t IRQn)
+{
+	return (IRQn >= 0) ? (ulHostNvicPending >> IRQn) & 1u : 0u;
+}
+
+void Host_SystemReset(void)
+{
+	fprintf(stderr, "host: system reset at %llu mS\n", (unsigned long long)sHost.ullMs);
+	exit(EXIT_FAILURE);
+}
+
+/**
+  * @brief  ADC Handshakes the Firmware Spins on: Calibration, Stop, Disable
+  *         and Ready. Idempotent, so Safe to Run From Both Threads.
+  * @param  None
+  * @retval None
+  */
+static void Host_AdcReact(void)
+{
+	uint32_t ulCR = ADC1->CR;
+
+	if(ulCR & ADC_CR_ADCAL)
+	{
+		CLEAR_BIT(ADC1->CR, ADC_CR_ADCAL);
+		SET_BIT(ADC1->ISR, ADC_ISR_EOCAL);
+	}
+	if(ulCR & ADC_CR_ADSTP)
+	{
+		CLEAR_BIT(ADC1->CR, ADC_CR_ADSTP | ADC_CR_ADSTART);
+	}
+	if(ulCR & ADC_CR_ADDIS)
+	{
+		CLEAR_BIT(ADC1->CR, ADC_CR_ADDIS | ADC_CR_ADEN | ADC_CR_ADSTART);
+	}
+	else if((ulCR & ADC_CR_ADEN) && !(ADC1->ISR & ADC_ISR_ADRDY))
+	{
+		SET_BIT(ADC1->ISR, ADC_ISR_ADRDY);
+	}
+	if(!(ADC1->ISR & ADC_ISR_CCRDY))
+	{
+		SET_BIT(ADC1->ISR, ADC_ISR_CCRDY);
+	}
+}
+
+/**
+  * @brief  Hardware Thread - Answers the ADC Handshakes While the Firmware
+  *         Busy Waits Outside WFI (ADC1_Activate, ADC_Set_Oversampling)
+  * @param  pArg - Unused
+  * @retval None
+  */
+static void *Host_Hardware(void *pArg)
+{
+	struct timespec sPoll = { 0, HOST_POLL_NS };
+
+	(void)pArg;
+	while(1)
+	{
+		Host_AdcReact();
+		nanosleep(&sPoll, NULL);
+	}
+	return NULL;
+}
+
+/**
+  * @brief  One Conversion Result
+  * @param  ucChannel - ADC Channel
+  * @retval 12 Bit Result
+  */
+static uint16_t Host_AdcSample(uint8_t ucChannel)
+{
+	if(sHost.pAdcSample)
+	{
+		return sHost.pAdcSample(ucChannel);
+	}
+	if((ucChannel == ADC_CHANNEL_GAS_SIGNAL) && (TIM14->CCR1 != 0))
+	{
+		return sHost.uiAdcLampOn;
+	}
+	return (ucChannel < HOST_ADC_CHANNELS) ? sHost.uiAdc[ucChannel] : 0;
+}
+
+/**
+  * @brief  A TIM3 TRGO: if the Regular Group is Armed on it, Convert the
+  *         Sequence (CHSELR Ranks or Channel Bits) and Hand Each Result to
+  *         the DMA. Oversampling Returns the Same Average, so it is Not
+  *         Modelled.
+  * @param  None
+  * @retval None
+  */
+static void Host_AdcScan(void)
+{
+	uint32_t ulCFGR1 = ADC1->CFGR1;
+	uint32_t ulCHSELR = ADC1->CHSELR;
+	uint8_t i, ucChannel;
+
+	if(!(ADC1->CR & ADC_CR_ADSTART) || !(ulCFGR1 & ADC_CFGR1_EXTEN) ||
+		 ((ulCFGR1 & ADC_CFGR1_EXTSEL) != (LL_ADC_REG_TRIG_EXT_TIM3_TRGO & ADC_CFGR1_EXTSEL)))
+	{
+		return;
+	}
+	for(i = 0; i < ((ulCFGR1 & ADC_CFGR1_CHSELRMOD) ? HOST_ADC_SEQ_RANKS : HOST_ADC_CHANNELS); i++)
+	{
+		if(ulCFGR1 & ADC_CFGR1_CHSELRMOD)
+		{
+			ucChannel = (ulCHSELR >> (4u * i)) & 0x0fu;
+			if(ucChannel == 0x0fu)
+			{
+				break;													//  End of Sequence
+			}
+		}
+		else if(ulCHSELR & (1u << i))
+		{
+			ucChannel = i;
+		}
+		else
+		{
+			continue;
+		}
+		ADC1->DR = Host_AdcSample(ucChannel);
+		if(ulCFGR1 & ADC_CFGR1_DMAEN)
+		{
+			Host_DmaWrite(LL_DMAMUX_REQ_ADC1, ADC1->DR);
+		}
+	}
+	sHost.ulAdcScans ++;
+}
+
+/**
+  * @brief  One Peripheral to Memory Transfer on Whichever DMA Channel the
+  *         DMAMUX Routes the Request to
+  * @param  ulRequest - LL_DMAMUX_REQ_
+  * @param  ulData - Peripheral Data
+  * @retval false if no Enabled Channel Takes the Request
+  */
+bool Host_DmaWrite(uint32_t ulRequest, uint32_t ulData)
+{
+	DMA_Channel_TypeDef *pChannel;
+	uint32_t ulAddress;
+	uint8_t i;
+
+	if((pChannel = Host_DmaChannel(ulRequest, &i, &ulAddress)) == NULL)
+	{
+		return false;
+	}
+	switch(pChannel->CCR & DMA_CCR_MSIZE)
+	{
+	case 0:
+		*(volatile uint8_t*)(uintptr_t)ulAddress = (uint8_t)ulData;
+		break;
+	case DMA_CCR_MSIZE_0:
+		*(volatile uint16_t*)(uintptr_t)ulAddress = (uint16_t)ulData;
+		break;
+	default:
+		*(volatile uint32_t*)(uintptr_t)ulAddress = ulData;
+	}
+	Host_DmaCount(i);
+	return true;
+}
+
+/**
+  * @brief  One Memory to Peripheral Transfer, as Host_DmaWrite
+  * @param  ulRequest - LL_DMAMUX_REQ_
+  * @param  pData - Memory Data Out
+  * @retval false if no Enabled Channel Has Data for the Request
+  */
+bool Host_DmaRead(uint32_t ulRequest, uint32_t *pData)
+{
+	DMA_Channel_TypeDef *pChannel;
+	uint32_t ulAddress;
+	uint8_t i;
+
+	if((pChannel = Host_DmaChannel(ulRequest, &i, &ulAddress)) == NULL)
+	{
+		return false;
+	}
+	switch(pChannel->CCR & DMA_CCR_MSIZE)
+	{
+	case 0:
+		*pData = *(volatile uint8_t*)(uintptr_t)ulAddress;
+		break;
+	case DMA_CCR_MSIZE_0:
+		*pData = *(volatile uint16_t*)(uintptr_t)ulAddress;
+		break;
+	default:
+		*pData = *(volatile uint32_t*)(uintptr_t)ulAddress;
+	}
+	Host_DmaCount(i);
+	return true;
+}
+
+/**
+  * @brief  The Enabled Channel With Transfers Left the DMAMUX Routes a Request
+  *         to, and the Memory Address of its Next Transfer. A CNDTR Other
+  *         Than the Model Left Means the Firmware Reprogrammed the Channel.
+  * @param  ulRequest - LL_DMAMUX_REQ_
+  * @param  pIndex - Channel Index Out
+  * @param  pAddress - Memory Address Out
+  * @retval Channel, NULL if None
+  */
+static DMA_Channel_TypeDef *Host_DmaChannel(uint32_t ulRequest, uint8_t *pIndex, uint32_t *pAddress)
+{
+	DMA_Channel_TypeDef *pChannel;
+	uint8_t i;
+
+	for(i = 0; i < HOST_DMA_CHANNELS; i++)
+	{
+		if((DMAMUX1_Channel0[i].CCR & DMAMUX_CxCR_DMAREQ_ID) == ulRequest)
+		{
+			break;
+		}
+	}
+	if(i == HOST_DMA_CHANNELS)
+	{
+		return NULL;
+	}
+	pChannel = pHostDma[i];
+	if(!(pChannel->CCR & DMA_CCR_EN) || (pChannel->CNDTR == 0))
+	{
+		return NULL;
+	}
+	if(pChannel->CNDTR != uiHostDmaLeft[i])
+	{
+		uiHostDmaReload[i] = (uint16_t)pChannel->CNDTR;
+	}
+
+	*pIndex = i;
+	*pAddress = pChannel->CMAR;
+	if(pChannel->CCR & DMA_CCR_MINC)
+	{
+		*pAddress += (uiHostDmaReload[i] - pChannel->CNDTR) << ((pChannel->CCR & DMA_CCR_MSIZE) >> DMA_CCR_MSIZE_Pos);
+	}
+	return pChannel;
+}
+
+/**
+  * @brief  Count a Transfer Done: Raises Half and Full Transfer Interrupts and
+  *         Reloads in Circular Mode
+  * @param  i - Channel Index
+  * @retval None
+  */
+static void Host_DmaCount(uint8_t i)
+{
+	DMA_Channel_TypeDef *pChannel = pHostDma[i];
+	uint32_t ulFlags = 0;
+
+	pChannel->CNDTR --;
+	if((uiHostDmaReload[i] > 1u) && (pChannel->CNDTR == uiHostDmaReload[i] / 2u))
+	{
+		ulFlags |= DMA_ISR_HTIF1 | DMA_ISR_GIF1;
+	}
+	if(pChannel->CNDTR == 0)
+	{
+		ulFlags |= DMA_ISR_TCIF1 | DMA_ISR_GIF1;
+		if(pChannel->CCR & DMA_CCR_CIRC)
+		{
+			pChannel->CNDTR = uiHostDmaReload[i];
+		}
+	}
+	uiHostDmaLeft[i] = (uint16_t)pChannel->CNDTR;
+
+	if(ulFlags)
+	{
+		SET_BIT(DMA1->ISR, ulFlags << (4u * i));
+		if(((ulFlags & DMA_ISR_HTIF1) && (pChannel->CCR & DMA_CCR_HTIE)) ||
+			 ((ulFlags & DMA_ISR_TCIF1) && (pChannel->CCR & DMA_CCR_TCIE)))
+		{
+			Host_Irq(eHostDmaIRQ[i]);
+		}
+	}
+}
+
+/**
+  * @brief  Count a Timer One mS On From its Clock (SYSCLK / (PSC + 1))
+  * @param  pTimer - TIM
+  * @retval Update Events in the mS
+  */
+static uint32_t Host_TimerUpdates(TIM_TypeDef *pTimer)
+{
+	uint32_t ulCount, ulPeriod;
+
+	if(!READ_BIT(pTimer->CR1, TIM_CR1_CEN))
+	{
+		return 0;
+	}
+	ulPeriod = pTimer->ARR + 1u;
+	ulCount = pTimer->CNT + SystemCoreClock / (pTimer->PSC + 1u) / HOST_US_PER_MS;
+	pTimer->CNT = ulCount % ulPeriod;
+	return ulCount / ulPeriod;
+}
+
+/**
+  * @brief  RTC Sub Seconds - Power_Init Clocks SS at 1 kHz, so it Counts Down
+  *         One per Step. Alarm A Fires on the SS Bits MASKSS Leaves Compared.
+  * @param  None
+  * @retval None
+  */
+static void Host_RtcTick(void)
+{
+	uint32_t ulPrediv = READ_BIT(RTC->PRER, RTC_PRER_PREDIV_S);
+	uint32_t ulSS = READ_BIT(RTC->SSR, RTC_SSR_SS);
+	uint32_t ulMask;
+
+	if(ulPrediv == 0)
+	{
+		return;																//  Not Configured
+	}
+	ulSS = ((ulSS == 0) || (ulSS > ulPrediv)) ? ulPrediv : ulSS - 1u;
+	RTC->SSR = ulSS;
+
+	if(READ_BIT(RTC->CR, RTC_CR_ALRAE))
+	{
+		ulMask = (1u << (READ_BIT(RTC->ALRMASSR, RTC_ALRMASSR_MASKSS) >> RTC_ALRMASSR_MASKSS_Pos)) - 1u;
+		if(((ulSS ^ RTC->ALRMASSR) & ulMask) == 0)
+		{
+			SET_BIT(RTC->SR, RTC_SR_ALRAF);
+			if(READ_BIT(RTC->CR, RTC_CR_ALRAIE))
+			{
+				Host_Irq(RTC_IRQn);
+			}
+		}
+	}
+}
+
+/**
+  * @brief  Queue Characters for the USART Receiver, as a Bus Master or Other
+  *         Slave Would Send Them, at the Baud Rate the Firmware Set. They
+  *         Follow Anything Already Queued.
+  * @param  pData - Characters
+  * @param  uiLength - Count
+  * @param  ullStartNs - Earliest Start of the First Start Bit
+  * @param  ulGapNs - Line Idle Between Characters
+  * @retval nS the Last Stop Bit Ends, 0 if the Queue is Full
+  */
+uint64_t Host_UartSend(const uint8_t *pData, uint16_t uiLength, uint64_t ullStartNs, uint32_t ulGapNs)
+{
+	uint64_t ullCharNs = Host_UartCharNs();
+	uint64_t ullNs = ullStartNs;
+	uint16_t i;
+
+	if(uiHostUartRxCount + uiLength > HOST_UART_QUEUE)
+	{
+		return 0;
+	}
+	if(ullNs < sHost.ullNs)
+	{
+		ullNs = sHost.ullNs;
+	}
+	if((uiHostUartRxCount != 0) && (ullNs < ullHostUartQueuedNs))
+	{
+		ullNs = ullHostUartQueuedNs;
+	}
+	for(i = 0; i < uiLength; i++)
+	{
+		if(i != 0)
+		{
+			ullNs += ulGapNs;
+		}
+		ullNs += ullCharNs;
+		sHostUartRx[(uiHostUartRxHead + uiHostUartRxCount) % HOST_UART_QUEUE].ullEndNs = ullNs;
+		sHostUartRx[(uiHostUartRxHead + uiHostUartRxCount) % HOST_UART_QUEUE].ucData = pData[i];
+		uiHostUartRxCount ++;
+	}
+	ullHostUartQueuedNs = ullNs;
+	return ullNs;
+}
+
+/**
+  * @brief  One Character Time: Start, Data (Parity Included) and Stop Bits
+  * @param  None
+  * @retval nS
+  */
+uint64_t Host_UartCharNs(void)
+{
+	uint32_t ulCR1 = USART1->CR1;
+	uint32_t ulHalfBits = 2u * (1u + ((ulCR1 & USART_CR1_M1) ? 7u : (ulCR1 & USART_CR1_M0) ? 9u : 8u));
+
+	switch(READ_BIT(USART1->CR2, USART_CR2_STOP))
+	{
+	case USART_CR2_STOP_0:
+		ulHalfBits += 1u;
+		break;
+	case USART_CR2_STOP_1:
+		ulHalfBits += 4u;
+		break;
+	case USART_CR2_STOP:
+		ulHalfBits += 3u;
+		break;
+	default:
+		ulHalfBits += 2u;
+	}
+	return Host_UartNs(ulHalfBits);
+}
+
+/**
+  * @brief  Line Time at the Programmed Baud Rate (BRR From the Kernel Clock)
+  * @param  ulHalfBits - Half Bit Times
+  * @retval nS
+  */
+static uint64_t Host_UartNs(uint32_t ulHalfBits)
+{
+	uint32_t ulBaud = LL_USART_GetBaudRate(USART1, LL_RCC_GetUSARTClockFreq(LL_RCC_USART1_CLKSOURCE),
+																				 LL_USART_GetPrescaler(USART1), LL_USART_GetOverSampling(USART1));
+
+	if(ulBaud == 0)
+	{
+		return HOST_NS_PER_MS;								//  Not Configured - Anything Will Do
+	}
+	return (uint64_t)ulHalfBits * HOST_NS_PER_S / (2u * ulBaud);
+}
+
+/**
+  * @brief  Run the USART Up to the Next Event Before a Time: a Character
+  *         Received, the Receiver Timeout or a Character Sent. A Transmission
+  *         Starts as Soon as the TX DMA Has Data, Which Needs the Core Out of
+  *         Stop - the DMA is Not Clocked There.
+  * @param  ullBeforeNs - Handle Only an Event Before This
+  * @param  bStop - Core in Stop Mode
+  * @retval true if an Event Was Handled
+  */
+static bool Host_UartEvent(uint64_t ullBeforeNs, bool bStop)
+{
+	uint64_t ullNext = 0, ullNs;
+	uint8_t ucEvent = HOST_UART_NONE;
+	HostUartChar sChar;
+
+	Host_UartTxStart(sHost.ullNs, bStop);
+	if(uiHostUartRxCount != 0)
+	{
+		ullNext = sHostUartRx[uiHostUartRxHead].ullEndNs;
+		ucEvent = HOST_UART_RX;
+	}
+	if(bHostUartRto)
+	{
+		ullNs = ullHostUartLastRxNs + Host_UartNs(2u * READ_BIT(USART1->RTOR, USART_RTOR_RTO));
+		if((ucEvent == HOST_UART_NONE) || (ullNs < ullNext - Host_UartCharNs()))		//  Unless a Start Bit Comes First
+		{
+			ullNext = ullNs;
+			ucEvent = HOST_UART_RTO;
+		}
+	}
+	if(bHostUartTx && ((ucEvent == HOST_UART_NONE) || (ullHostUartTxNs < ullNext)))
+	{
+		ullNext = ullHostUartTxNs;
+		ucEvent = HOST_UART_TX;
+	}
+	if((ucEvent == HOST_UART_NONE) || (ullNext >= ullBeforeNs))
+	{
+		return false;
+	}
+	if(ullNext > sHost.ullNs)
+	{
+		sHost.ullNs = ullNext;
+	}
+
+	switch(ucEvent)
+	{
+	case HOST_UART_RX:
+		sChar = sHostUartRx[uiHostUartRxHead];
+		uiHostUartRxHead = (uiHostUartRxHead + 1u) % HOST_UART_QUEUE;
+		uiHostUartRxCount --;
+		Host_UartReceive(sChar.ullEndNs, sChar.ucData);
+		break;
+
+	case HOST_UART_RTO:
+		bHostUartRto = false;
+		SET_BIT(USART1->ISR, USART_ISR_RTOF);
+		if(READ_BIT(USART1->CR1, USART_CR1_RTOIE))
+		{
+			Host_Irq(USART1_IRQn);
+		}
+		break;
+
+	default:
+		bHostUartTx = false;
+		sHost.ulUartTxChars ++;
+		if(sHost.pUartTx)
+		{
+			sHost.pUartTx(ucHostUartTx, ullHostUartTxNs);
+		}
+		if(!Host_UartTxStart(ullHostUartTxNs, bStop))
+		{
+			SET_BIT(USART1->ISR, USART_ISR_TC);
+			if(READ_BIT(USART1->CR1, USART_CR1_TCIE))
+			{
+				Host_Irq(USART1_IRQn);
+			}
+		}
+	}
+	Host_ClearFlags();
+	Host_IrqDeliver();
+	return true;
+}
+
+/**
+  * @brief  A Character Has Arrived. A Whole Idle Character Before it Wakes the
+  *         Receiver From Mute (Idle Line Wakeup); Muted Characters are Dropped.
+  *         Otherwise the RX DMA Takes it, or it Waits in RDR With RXNE.
+  *         Either Way it Restarts the Receiver Timeout.
+  * @param  ullEndNs - When its Stop Bit Ended
+  * @param  ucData - Character
+  * @retval None
+  */
+static void Host_UartReceive(uint64_t ullEndNs, uint8_t ucData)
+{
+	uint32_t ulCR1 = USART1->CR1;
+	uint64_t ullCharNs = Host_UartCharNs();
+
+	sHost.ulUartRxChars ++;
+	if(ullEndNs - ullHostUartLastRxNs >= 2u * ullCharNs)
+	{
+		SET_BIT(USART1->ISR, USART_ISR_IDLE);
+		if(!READ_BIT(USART1->CR1, USART_CR1_WAKE))
+		{
+			CLEAR_BIT(USART1->ISR, USART_ISR_RWU);
+		}
+	}
+	ullHostUartLastRxNs = ullEndNs;
+	bHostUartRto = READ_BIT(USART1->CR2, USART_CR2_RTOEN) != 0;
+
+	if(((ulCR1 & (USART_CR1_UE | USART_CR1_RE)) != (USART_CR1_UE | USART_CR1_RE)) || READ_BIT(USART1->ISR, USART_ISR_RWU))
+	{
+		return;
+	}
+	if(READ_BIT(USART1->CR3, USART_CR3_DMAR) && Host_DmaWrite(LL_DMAMUX_REQ_USART1_RX, ucData))
+	{
+		return;
+	}
+	if(READ_BIT(USART1->ISR, USART_ISR_RXNE_RXFNE))
+	{
+		SET_BIT(USART1->ISR, USART_ISR_ORE);
+		sHost.ulUartOverruns ++;
+	}
+	else
+	{
+		USART1->RDR = ucData;
+		SET_BIT(USART1->ISR, USART_ISR_RXNE_RXFNE);
+	}
+	if(ulCR1 & USART_CR1_RXNEIE_RXFNEIE)
+	{
+		Host_Irq(USART1_IRQn);
+	}
+}
+
+/**
+  * @brief  Start Sending the Next Character if the Transmitter is Free and
+  *         the TX DMA Has One
+  * @param  ullStartNs - Start of its Start Bit
+  * @param  bStop - Core in Stop Mode
+  * @retval true if a Character Started
+  */
+static bool Host_UartTxStart(uint64_t ullStartNs, bool bStop)
+{
+	uint32_t ulData;
+
+	if(bHostUartTx || bStop || !READ_BIT(USART1->CR1, USART_CR1_UE) || !READ_BIT(USART1->CR1, USART_CR1_TE) ||
+		 !READ_BIT(USART1->CR3, USART_CR3_DMAT) || !Host_DmaRead(LL_DMAMUX_REQ_USART1_TX, &ulData))
+	{
+		return false;
+	}
+	USART1->TDR = ulData;
+	CLEAR_BIT(USART1->ISR, USART_ISR_TC);
+	ucHostUartTx = (uint8_t)ulData;
+	ullHostUartTxNs = ullStartNs + Host_UartCharNs();
+	bHostUartTx = true;
+	return true;
+}
+
+/**
+  * @brief  Run the Flash Controller for One mS: Operations Take Their Erase or
+  *         Program Time, Several Complete in a mS if Short Enough, and Each
+  *         Ends With EOP (or an Error) Through FLASH_IRQHandler.
+  * @param  None
+  * @retval None
+  */
+static void Host_FlashTick(void)
+{
+	uint32_t ulBudget = HOST_US_PER_MS;
+
+	while((ucHostFlashOp != HOST_FLASH_IDLE) || Host_FlashStart())
+	{
+		if(ulHostFlashUs > ulBudget)
+		{
+			ulHostFlashUs -= ulBudget;
+			break;
+		}
+		ulBudget -= ulHostFlashUs;
+		Host_FlashFinish();
+	}
+}
+
+/**
+  * @brief  Pick up an Operation the Firmware Started: STRT With PER Erases
+  *         Page PNB; PG Means a Double Word Was Written - Found by Comparing
+  *         the Array With its Last Programmed Contents (no Difference is an
+  *         Erased Double Word Programmed With Ones).
+  * @param  None
+  * @retval true if an Operation Started
+  */
+static bool Host_FlashStart(void)
+{
+	const uint64_t *pArray = (const uint64_t*)(uintptr_t)FLASH_BASE;
+	uint16_t i;
+
+	if(READ_BIT(FLASH->CR, FLASH_CR_STRT) && READ_BIT(FLASH->CR, FLASH_CR_PER))
+	{
+		CLEAR_BIT(FLASH->CR, FLASH_CR_STRT);
+		ulHostFlashAddress = FLASH_BASE + (READ_BIT(FLASH->CR, FLASH_CR_PNB) >> FLASH_CR_PNB_Pos) * FLASH_PAGE_BYTES;
+		ulHostFlashUs = sHost.ulFlashEraseUs;
+		ucHostFlashOp = HOST_FLASH_ERASE;
+	}
+	else if(READ_BIT(FLASH->CR, FLASH_CR_PG))
+	{
+		for(i = 0; (i < HOST_FLASH_BYTES / 8) && (pArray[i] == ullHostFlash[i]); i++)
+		{
+		}
+		ulHostFlashAddress = (i < HOST_FLASH_BYTES / 8) ? FLASH_BASE + i * 8u : 0;
+		ulHostFlashUs = sHost.ulFlashProgramUs;
+		ucHostFlashOp = HOST_FLASH_PROGRAM;
+	}
+	else
+	{
+		return false;
+	}
+	SET_BIT(FLASH->SR, FLASH_SR_BSY1);
+	return true;
+}
+
+/**
+  * @brief  Complete the Operation in Progress. Programming Over Anything but
+  *         an Erased Double Word (Other Than With Zeros) Fails With PROGERR
+  *         and Leaves the Old Contents.
+  * @param  None
+  * @retval None
+  */
+static void Host_FlashFinish(void)
+{
+	volatile uint64_t *pArray = (volatile uint64_t*)(uintptr_t)FLASH_BASE;
+	uint32_t ulIndex = (ulHostFlashAddress - FLASH_BASE) / 8u;
+	uint32_t ulFlags = FLASH_SR_EOP;
+	uint16_t i;
+
+	if(Host_FlashCut(ulIndex, (ucHostFlashOp == HOST_FLASH_ERASE) ? FLASH_PAGE_BYTES : 8u))
+	{
+		return;
+	}
+	if(ucHostFlashOp == HOST_FLASH_ERASE)
+	{
+		if(ulHostFlashAddress < FLASH_BASE + HOST_FLASH_BYTES)
+		{
+			for(i = 0; i < FLASH_PAGE_BYTES / 8; i++)
+			{
+				pArray[ulIndex + i] = ~0ull;
+				ullHostFlash[ulIndex + i] = ~0ull;
+			}
+			sHost.ulFlashPageErases[ulIndex * 8u / FLASH_PAGE_BYTES] ++;
+		}
+		sHost.ulFlashErases ++;
+	}
+	else if(ulHostFlashAddress != 0)
+	{
+		if((ullHostFlash[ulIndex] == ~0ull) || (pArray[ulIndex] == 0))
+		{
+			ullHostFlash[ulIndex] = pArray[ulIndex];
+			sHost.ulFlashPrograms ++;
+		}
+		else
+		{
+			pArray[ulIndex] = ullHostFlash[ulIndex];
+			ulFlags = FLASH_SR_PROGERR;
+			sHost.ulFlashErrors ++;
+		}
+	}
+	else
+	{
+		sHost.ulFlashPrograms ++;
+	}
+	ucHostFlashOp = HOST_FLASH_IDLE;
+
+	//  The Firmware Clears by Writing Ones, Which Memory Can Not Model - so
+	//  Present Only This Operation's Flags to the Handler
+	FLASH->SR = ulFlags;
+	if(READ_BIT(FLASH->CR, (ulFlags == FLASH_SR_EOP) ? FLASH_CR_EOPIE : FLASH_CR_ERRIE))
+	{
+		Host_Irq(FLASH_IRQn);
+	}
+	FLASH->SR = 0;
+}
+
+/**
+  * @brief  Count a Finished Operation in the Watched Range, and if it is the
+  *         One the Power Fails in, Leave it Torn: the First uiFlashCutByte
+  *         Bytes Erased or Programmed, the Rest as They Were. The Firmware
+  *         Never Hears of it.
+  * @param  ulIndex - First Double Word of the Operation
+  * @param  uiBytes - Bytes it Covers
+  * @retval true if the Power Failed
+  */
+static bool Host_FlashCut(uint32_t ulIndex, uint16_t uiBytes)
+{
+	volatile uint8_t *pArray = (volatile uint8_t*)(uintptr_t)FLASH_BASE + ulIndex * 8u;
+	uint8_t *pShadow = (uint8_t*)&ullHostFlash[ulIndex];
+	uint16_t i;
+
+	if((ulHostFlashAddress == 0) || (ulHostFlashAddress >= FLASH_BASE + HOST_FLASH_BYTES) ||
+		 (sHost.ulFlashWatchBytes && ((ulHostFlashAddress < sHost.ulFlashWatchBase) ||
+																	(ulHostFlashAddress >= sHost.ulFlashWatchBase + sHost.ulFlashWatchBytes))))
+	{
+		return false;
+	}
+	if(++sHost.ulFlashOps != sHost.ulFlashCutOp)
+	{
+		return false;
+	}
+
+	for(i = 0; i < uiBytes; i++)
+	{
+		if(ucHostFlashOp == HOST_FLASH_ERASE)
+		{
+			pShadow[i] = (i < sHost.uiFlashCutByte) ? 0xff : pShadow[i];
+			pArray[i] = pShadow[i];
+		}
+		else
+		{
+			pShadow[i] = (i < sHost.uiFlashCutByte) ? pArray[i] : pShadow[i];
+			pArray[i] = pShadow[i];
+		}
+	}
+	ucHostFlashOp = HOST_FLASH_IDLE;
+	if(sHost.pPowerFail)
+	{
+		sHost.pPowerFail();
+	}
+	return true;
+}
+
+/**
+  * @brief  Load the Flash Array (Programmed Contents Included) From a File
+  *         Saved by Host_FlashSave, so Parameters Survive Between Runs
+  * @param  pPath - Image File
+  * @retval false if it Could Not be Read
+  */
+bool Host_FlashLoad(const char *pPath)
+{
+	FILE *pFile = fopen(pPath, "rb");
+	size_t lRead;
+
+	if(pFile == NULL)
+	{
+		return false;
+	}
+	lRead = fread((void*)(uintptr_t)FLASH_BASE, 1, HOST_FLASH_BYTES, pFile);
+	fclose(pFile);
+	memcpy(ullHostFlash, (const void*)(uintptr_t)FLASH_BASE, HOST_FLASH_BYTES);
+	return lRead == HOST_FLASH_BYTES;
+}
+
+/**
+  * @brief  Save the Flash Array
+  * @param  pPath - Image File
+  * @retval false if it Could Not be Written
+  */
+bool Host_FlashSave(const char *pPath)
+{
+	FILE *pFile = fopen(pPath, "wb");
+	size_t lWritten;
+
+	if(pFile == NULL)
+	{
+		return false;
+	}
+	lWritten = fwrite(ullHostFlash, 1, HOST_FLASH_BYTES, pFile);
+	return (fclose(pFile) == 0) && (lWritten == HOST_FLASH_BYTES);
+}
+
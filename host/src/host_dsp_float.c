@@ -0,0 +1,9 @@
+
+//  Host Build Only - src/dsp.cpp as the Float Build, Counted (host_dsp.h)
+#include  "main.h"
+#undef DSP_FIXED_POINT
+#define HOST_DSP_NAMESPACE					HostDspFloat
+#define HOST_DSP_BUILD							sHostDspFloat
+#define HOST_DSP_BUILD_NAME					"float"
+#include  "host_dsp_build.h"
+
@@ -0,0 +1,10 @@
+
+//  Host Build Only - src/dsp.cpp as the Q31 Build (DSP_FIXED_POINT), Counted
+//  (host_dsp.h)
+#include  "main.h"
+#define DSP_FIXED_POINT
+#define HOST_DSP_NAMESPACE					HostDspQ31
+#define HOST_DSP_BUILD							sHostDspQ31
+#define HOST_DSP_BUILD_NAME					"q31"
+#include  "host_dsp_build.h"
+
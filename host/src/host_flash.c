@@ -0,0 +1,902 @@
+/**
+  ******************************************************************************
+  * 											Next Generation CO2 Sensor
+  * 											Host Build - Parameter Store Wear and Power Fail Simulator
+  *
+  *   nextgen_flash [-t seconds] [-i trace.csv] [-p period_s] [-a register]
+  *                 [-n trials] [-f op:byte] [-e erase_us] [-w program_us]
+  *                 [-r seed] [-o results.json] [-l label]
+  *
+  *   Writes Holding Registers Through the Firmware's Modbus Port (FC16) on the
+  *   Simulated Line and Watches What the Parameter Store Makes of Them: Page
+  *   Erases (per Page, per 10k Writes, per Day and the Years to the Endurance
+  *   Limit), How Long Each Commit Keeps the Flash Busy and How Long a Write
+  *   Takes to Become Durable. The Writes Come From a Trace (-i), One Request
+  *   per Line - "seconds,register,value[,value...]" With Modbus Register
+  *   Addresses and # Comments - or Else are a Write of -a Every -p Seconds.
+  *
+  *   Then the Power Fails: Each Trial Reruns the Workload up to One Flash
+  *   Operation on the Parameter Pages (Spread Over Those the Clean Run Made,
+  *   or the One -f Names), Tears it After 0 to 8 of its Bytes (an Erase
+  *   Starts With the Page Header, so a Few Bytes Already Decide it), Boots the
+  *   Torn Image and Checks the Registers Come Back as the Last Durable Commit
+  *   or the One in Flight - Then That Whatever the Firmware Repairs Survives
+  *   Another Reboot. The Model Boots Once per Process, so Every Run is Forked.
+  ******************************************************************************
+  */
+
+//  Includes
+#include  "main.h"
+#include  "host.h"
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+#include  <unistd.h>
+#include  <sys/mman.h>
+#include  <sys/wait.h>
+
+#define WEAR_SETTLE_MS					5000u			//  Boot (and Format a Blank Store) Before the First Write
+#define WEAR_RECOVER_MS					10000u		//  Run After a Torn Restore, for the Firmware to Repair
+#define WEAR_TAIL_S							60u				//  Run Past the Last Traced Write
+#define WEAR_TIMEOUT_NS					100000000ull
+#define WEAR_MAX_REGISTERS			((BUFFER_SIZE - 9u) / 2u)
+#define WEAR_EXCEPTION_BYTES		5u
+#define WEAR_WRITE_BYTES				8u				//  FC16 Response
+#define WEAR_CUT_BYTES					8u				//  Tear Points per Operation, Plus Untouched
+#define WEAR_ENDURANCE					10000u		//  Datasheet Page Erase Cycles
+#define WEAR_PERCENTILES				3u
+#define WEAR_FAILURES						8u				//  Trials Listed by Name
+#define WEAR_LINE_BYTES					1024u
+
+enum WEAR_RESULT
+{
+	WEAR_OLD = 0,												//  Last Durable Commit
+	WEAR_NEW,														//  The Commit in Flight
+	WEAR_CORRUPT,												//  Neither
+	WEAR_UNSTABLE,											//  Right, but Changed by the Repair or the Reboot After
+	WEAR_MISSED,												//  The Run Never Reached the Operation
+	WEAR_RESULTS
+};
+
+//  One FC16 Request
+typedef struct
+{
+	uint64_t ullNs;											//  Due, From the End of the Settle
+	uint16_t uiRegister;								//  Modbus Address
+	uint8_t ucCount;
+	uint16_t uiValue[WEAR_MAX_REGISTERS];
+} WearWrite;
+
+typedef struct
+{
+	uint64_t *pNs;
+	uint32_t ulCount;
+	uint32_t ulSize;
+} WearSamples;
+
+//  Passed Back From the Forked Runs
+typedef struct
+{
+	uint32_t ulWrites;
+	uint32_t ulAcks;
+	uint32_t ulRejects;
+	uint32_t ulTimeouts;
+	uint32_t ulCommits;
+	uint32_t ulPageErases[HOST_FLASH_PAGES];		//  After the Settle
+	uint32_t ulPrograms;
+	uint32_t ulErrors;
+	uint64_t ullCommitNs[WEAR_PERCENTILES];			//  Commit Queued to the Flash Idle
+	uint64_t ullDurableNs[WEAR_PERCENTILES];		//  Write Acknowledged to its Commit Done
+	uint32_t ulOpsSettled;
+	uint32_t ulOpsEnd;
+	bool bCut;
+	HoldRegs sOld;
+	HoldRegs sNew;
+	HoldRegs sRestored;
+	uint8_t ucResult;
+} WearShared;
+
+static const double dWearPercentile[WEAR_PERCENTILES] = { 0.50, 0.99, 1.00 };
+static const char * const pWearPercentile[WEAR_PERCENTILES] = { "p50", "p99", "max" };
+static const char * const pWearResult[WEAR_RESULTS] = { "old", "new", "corrupt", "unstable", "missed" };
+
+//  Options
+static uint32_t ulSeconds = 0;
+static uint32_t ulPeriod = 60;
+static uint16_t uiRegister = 4001;					//  mfg_data - Not Used by the Firmware
+static uint32_t ulTrials = 20;
+static uint32_t ulEraseUs = HOST_FLASH_ERASE_US;
+static uint32_t ulProgramUs = HOST_FLASH_PROGRAM_US;
+static uint32_t ulSeed = 1;
+static uint32_t ulRandom;
+static const char *pTracePath = NULL;
+
+//  Workload
+static WearWrite *pTrace = NULL;
+static uint32_t ulTraceCount = 0;
+static uint32_t ulTraceSize = 0;
+static uint32_t ulNext = 0;									//  Writes Sent
+static WearWrite sSynthetic;
+static bool bWaiting = false;
+static uint32_t ulWrites = 0, ulAcks = 0, ulRejects = 0, ulTimeouts = 0;
+static uint64_t ullReqEndNs;
+static uint8_t ucResp[BUFFER_SIZE];
+static uint16_t uiRespLength, uiRespExpect;
+
+//  Store
+static bool bWasInProcess;
+static bool bCommitOpen = false;
+static uint64_t ullCommitStartNs;
+static HoldRegs sDurable;
+static HoldRegs sCommitting;
+static uint64_t *pAckNs = NULL;							//  Acknowledged Writes Not Yet Durable
+static uint32_t ulAckCount = 0;
+static uint32_t ulAckSize = 0;
+static uint32_t ulAckCommit = 0;						//  Those the Commit in Flight Covers
+static WearSamples sCommitSamples;
+static WearSamples sDurableSamples;
+
+//  Trials
+static WearShared *pShared;
+static char cImage[] = "/tmp/nextgen_flash_XXXXXX";
+static uint32_t ulOpsSettled;
+static uint32_t ulErasesSettled[HOST_FLASH_PAGES];
+static uint32_t ulCutOp = 0;								//  Fixed by -f, Else Spread
+static uint16_t uiCutByte = 0xffff;					//  Fixed by -f, Else Random
+
+static bool Wear_Load(const char *);
+static bool Wear_Line(char *, WearWrite *);
+static bool Wear_Fork(void (*)(void));
+static void Wear_Boot(bool);
+static void Wear_Workload(void);
+static void Wear_Clean(void);
+static void Wear_Cut(void);
+static void Wear_PowerFail(void);
+static void Wear_Restore(void);
+static void Wear_Verify(void);
+static void Wear_Tick(void);
+static void Wear_Tx(uint8_t, uint64_t);
+static WearWrite *Wear_Next(void);
+static void Wear_Send(const WearWrite *, uint64_t);
+static void Wear_Track(void);
+static void Wear_Durable(void);
+static bool Wear_Same(const HoldRegs *, const HoldRegs *);
+static void Wear_Sample(WearSamples *, uint64_t);
+static uint32_t Wear_Random(void);
+static int Wear_Compare(const void *, const void *);
+static void Wear_Percentiles(WearSamples *, uint64_t *);
+static void Wear_Report(FILE *, const char *, const uint32_t *, const uint32_t (*)[2], uint32_t);
+
+int main(int argc, char **argv)
+{
+	const char *pJson = NULL;
+	const char *pLabel = "";
+	FILE *pFile;
+	uint32_t ulResults[WEAR_RESULTS] = { 0 };
+	uint32_t ulFailures[WEAR_FAILURES][2];
+	uint32_t ulFailed = 0, ulSpan, i;
+	uint32_t ulFixedOp;
+	bool bFixedByte;
+	char *pEnd;
+	int iArg, iImage;
+
+	for(iArg = 1; iArg + 1 < argc; iArg += 2)
+	{
+		const char *pValue = argv[iArg + 1];
+
+		if(strcmp(argv[iArg], "-t") == 0)
+		{
+			ulSeconds = (uint32_t)strtoul(pValue, NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-i") == 0)
+		{
+			pTracePath = pValue;
+		}
+		else if(strcmp(argv[iArg], "-p") == 0)
+		{
+			ulPeriod = (uint32_t)strtoul(pValue, NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-a") == 0)
+		{
+			uiRegister = (uint16_t)strtoul(pValue, NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-n") == 0)
+		{
+			ulTrials = (uint32_t)strtoul(pValue, NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-f") == 0)
+		{
+			ulCutOp = (uint32_t)strtoul(pValue, &pEnd, 0);
+			uiCutByte = (*pEnd == ':') ? (uint16_t)strtoul(pEnd + 1, NULL, 0) : 0xffff;
+			ulTrials = 1;
+		}
+		else if(strcmp(argv[iArg], "-e") == 0)
+		{
+			ulEraseUs = (uint32_t)strtoul(pValue, NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-w") == 0)
+		{
+			ulProgramUs = (uint32_t)strtoul(pValue, NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-r") == 0)
+		{
+			ulSeed = (uint32_t)strtoul(pValue, NULL, 0) | 1u;
+		}
+		else if(strcmp(argv[iArg], "-o") == 0)
+		{
+			pJson = pValue;
+		}
+		else if(strcmp(argv[iArg], "-l") == 0)
+		{
+			pLabel = pValue;
+		}
+		else
+		{
+			break;
+		}
+	}
+	if((iArg < argc) || (ulPeriod == 0) || ((uiCutByte != 0xffff) && ((ulCutOp == 0) || (uiCutByte > FLASH_PAGE_BYTES))))
+	{
+		fprintf(stderr, "usage: %s [-t seconds] [-i trace.csv] [-p period_s] [-a register] [-n trials]\n"
+										"       [-f op:byte] [-e erase_us] [-w program_us] [-r seed] [-o results.json] [-l label]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	if(pTracePath && !Wear_Load(pTracePath))
+	{
+		return EXIT_FAILURE;
+	}
+	if(ulSeconds == 0)
+	{
+		ulSeconds = ulTraceCount ? (uint32_t)(pTrace[ulTraceCount - 1u].ullNs / HOST_NS_PER_S) + WEAR_TAIL_S : 3600u;
+	}
+	ulRandom = ulSeed;
+
+	pShared = (WearShared*)mmap(NULL, sizeof(WearShared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if((pShared == MAP_FAILED) || ((iImage = mkstemp(cImage)) < 0))
+	{
+		fprintf(stderr, "%s: can not set up the runs\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	close(iImage);
+
+	//  Clean Run - the Wear Figures, and the Operations to Cut
+	if(!Wear_Fork(Wear_Clean))
+	{
+		fprintf(stderr, "%s: clean run failed\n", argv[0]);
+		unlink(cImage);
+		return EXIT_FAILURE;
+	}
+	ulSpan = pShared->ulOpsEnd - pShared->ulOpsSettled;
+	ulFixedOp = ulCutOp;
+	bFixedByte = (uiCutByte != 0xffff);
+	if((ulFixedOp == 0) && (ulSpan < ulTrials))
+	{
+		ulTrials = ulSpan;
+	}
+
+	for(i = 0; i < ulTrials; i++)
+	{
+		ulCutOp = ulFixedOp ? ulFixedOp : pShared->ulOpsSettled + 1u + (uint32_t)((uint64_t)i * ulSpan / ulTrials);
+		if(!bFixedByte)
+		{
+			uiCutByte = (uint16_t)(Wear_Random() % (WEAR_CUT_BYTES + 1u));
+		}
+		pShared->bCut = false;
+		pShared->ucResult = WEAR_MISSED;
+		if(!Wear_Fork(Wear_Cut) || (pShared->bCut && (!Wear_Fork(Wear_Restore) ||
+			 ((pShared->ucResult != WEAR_CORRUPT) && !Wear_Fork(Wear_Verify)))))
+		{
+			fprintf(stderr, "%s: trial at op %u byte %u failed\n", argv[0], (unsigned)ulCutOp, (unsigned)uiCutByte);
+			unlink(cImage);
+			return EXIT_FAILURE;
+		}
+		ulResults[pShared->ucResult] ++;
+		if((pShared->ucResult >= WEAR_CORRUPT) && (pShared->ucResult != WEAR_MISSED) && (ulFailed < WEAR_FAILURES))
+		{
+			ulFailures[ulFailed][0] = ulCutOp;
+			ulFailures[ulFailed ++][1] = uiCutByte;
+		}
+	}
+	unlink(cImage);
+
+	Wear_Report(stdout, NULL, ulResults, ulFailures, ulFailed);
+	if(pJson)
+	{
+		if((pFile = fopen(pJson, "w")) == NULL)
+		{
+			fprintf(stderr, "%s: can not write %s\n", argv[0], pJson);
+			return EXIT_FAILURE;
+		}
+		Wear_Report(pFile, pLabel, ulResults, ulFailures, ulFailed);
+		fclose(pFile);
+	}
+	return (ulResults[WEAR_CORRUPT] || ulResults[WEAR_UNSTABLE]) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+  * @brief  Read a Write Trace
+  * @param  pPath - CSV File
+  * @retval false if it Can Not be Read or a Line is Malformed
+  */
+static bool Wear_Load(const char *pPath)
+{
+	FILE *pFile = fopen(pPath, "r");
+	char cLine[WEAR_LINE_BYTES];
+	char *pLine;
+	uint32_t ulLine = 0;
+
+	if(pFile == NULL)
+	{
+		fprintf(stderr, "can not read %s\n", pPath);
+		return false;
+	}
+	while(fgets(cLine, sizeof(cLine), pFile))
+	{
+		ulLine ++;
+		pLine = cLine + strspn(cLine, " \t");
+		if((*pLine == '#') || (*pLine == '\0') || (*pLine == '\r') || (*pLine == '\n'))
+		{
+			continue;
+		}
+		if(ulTraceCount == ulTraceSize)
+		{
+			ulTraceSize = ulTraceSize ? 2u * ulTraceSize : 1024u;
+			pTrace = (WearWrite*)realloc(pTrace, ulTraceSize * sizeof(WearWrite));
+			if(pTrace == NULL)
+			{
+				fprintf(stderr, "out of memory\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+		if(!Wear_Line(pLine, &pTrace[ulTraceCount]) ||
+			 (ulTraceCount && (pTrace[ulTraceCount].ullNs < pTrace[ulTraceCount - 1u].ullNs)))
+		{
+			fprintf(stderr, "%s:%u: expected seconds,register,value[,value...] in time order\n", pPath, (unsigned)ulLine);
+			fclose(pFile);
+			return false;
+		}
+		ulTraceCount ++;
+	}
+	fclose(pFile);
+	return true;
+}
+
+/**
+  * @brief  Parse One Trace Line
+  * @param  pLine - "seconds,register,value[,value...]"
+  * @param  pWrite - Request Out
+  * @retval false if Malformed
+  */
+static bool Wear_Line(char *pLine, WearWrite *pWrite)
+{
+	char *pEnd;
+	double dSeconds = strtod(pLine, &pEnd);
+	unsigned long ulValue;
+
+	if((pEnd == pLine) || (*pEnd != ',') || !(dSeconds >= 0))
+	{
+		return false;
+	}
+	pWrite->ullNs = (uint64_t)(dSeconds * HOST_NS_PER_S + 0.5);
+	pLine = pEnd + 1;
+	ulValue = strtoul(pLine, &pEnd, 0);
+	if((pEnd == pLine) || (*pEnd != ',') || (ulValue > 0xffffu))
+	{
+		return false;
+	}
+	pWrite->uiRegister = (uint16_t)ulValue;
+	for(pWrite->ucCount = 0; *pEnd == ','; )
+	{
+		pLine = pEnd + 1;
+		ulValue = strtoul(pLine, &pEnd, 0);
+		if((pEnd == pLine) || (ulValue > 0xffffu) || (pWrite->ucCount == WEAR_MAX_REGISTERS))
+		{
+			return false;
+		}
+		pWrite->uiValue[pWrite->ucCount ++] = (uint16_t)ulValue;
+	}
+	return pEnd[strspn(pEnd, " \t\r\n")] == '\0';
+}
+
+/**
+  * @brief  Run a Stage in its Own Process and Wait for it
+  * @param  pStage - Boots the Model and Reports Through pShared
+  * @retval false if it Crashed
+  */
+static bool Wear_Fork(void (*pStage)(void))
+{
+	pid_t iPid;
+	int iStatus;
+
+	fflush(NULL);
+	if((iPid = fork()) == 0)
+	{
+		pStage();
+		_exit(EXIT_SUCCESS);
+	}
+	return (iPid > 0) && (waitpid(iPid, &iStatus, 0) == iPid) && WIFEXITED(iStatus) && (WEXITSTATUS(iStatus) == EXIT_SUCCESS);
+}
+
+/**
+  * @brief  Bring the Model up and Boot the Firmware - on Blank Flash, or the
+  *         Image a Cut Left
+  * @param  bImage - Load the Image First
+  * @retval None
+  */
+static void Wear_Boot(bool bImage)
+{
+	Host_Init();
+	sHost.ulFlashEraseUs = ulEraseUs;
+	sHost.ulFlashProgramUs = ulProgramUs;
+	sHost.ulFlashWatchBase = FLASH_PAGE_A;
+	sHost.ulFlashWatchBytes = 2u * FLASH_PAGE_BYTES;
+	if(bImage && !Host_FlashLoad(cImage))
+	{
+		_exit(EXIT_FAILURE);
+	}
+	Host_Run(1);
+}
+
+/**
+  * @brief  Boot on Blank Flash, Let it Settle, Then Play the Writes
+  * @param  None
+  * @retval None
+  */
+static void Wear_Workload(void)
+{
+	Wear_Boot(false);
+	sDurable = sCommitting = sHRegs;
+	bWasInProcess = uiFlags.bFlashCommitInProcess;
+	sHost.pTick = Wear_Tick;
+	sHost.pUartTx = Wear_Tx;
+	Host_Run(WEAR_SETTLE_MS - 1u);
+	ulOpsSettled = sHost.ulFlashOps;
+	memcpy(ulErasesSettled, sHost.ulFlashPageErases, sizeof(ulErasesSettled));
+	Host_Run(ulSeconds * 1000u);
+}
+
+/**
+  * @brief  Uncut Run - Report the Wear, the Latencies and the Operations
+  *         Made on the Parameter Pages
+  * @param  None
+  * @retval None
+  */
+static void Wear_Clean(void)
+{
+	uint16_t i;
+
+	Wear_Workload();
+	pShared->ulWrites = ulWrites;
+	pShared->ulAcks = ulAcks;
+	pShared->ulRejects = ulRejects;
+	pShared->ulTimeouts = ulTimeouts;
+	pShared->ulOpsSettled = ulOpsSettled;
+	pShared->ulOpsEnd = sHost.ulFlashOps;
+	for(i = 0; i < HOST_FLASH_PAGES; i++)
+	{
+		pShared->ulPageErases[i] = sHost.ulFlashPageErases[i] - ulErasesSettled[i];
+	}
+	pShared->ulPrograms = sHost.ulFlashPrograms;
+	pShared->ulErrors = sHost.ulFlashErrors;
+	Wear_Percentiles(&sCommitSamples, pShared->ullCommitNs);
+	Wear_Percentiles(&sDurableSamples, pShared->ullDurableNs);
+	pShared->ulCommits = sCommitSamples.ulCount;
+}
+
+/**
+  * @brief  Replay up to the Operation the Power Fails in
+  * @param  None
+  * @retval None
+  */
+static void Wear_Cut(void)
+{
+	sHost.ulFlashCutOp = ulCutOp;
+	sHost.uiFlashCutByte = uiCutByte;
+	sHost.pPowerFail = Wear_PowerFail;
+	Wear_Workload();
+}
+
+/**
+  * @brief  The Cut: Keep the Torn Image and What a Restore May Rightly Give
+  * @param  None
+  * @retval None
+  */
+static void Wear_PowerFail(void)
+{
+	Wear_Track();
+	pShared->sOld = sDurable;
+	pShared->sNew = bCommitOpen ? sCommitting : sDurable;
+	pShared->bCut = true;
+	_exit(Host_FlashSave(cImage) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/**
+  * @brief  Boot the Torn Image, Judge the Registers, Then Run on so the
+  *         Firmware Can Rewrite the Store
+  * @param  None
+  * @retval None
+  */
+static void Wear_Restore(void)
+{
+	Wear_Boot(true);
+	pShared->sRestored = sHRegs;
+	if(Wear_Same(&sHRegs, &pShared->sOld))
+	{
+		pShared->ucResult = WEAR_OLD;
+	}
+	else if(Wear_Same(&sHRegs, &pShared->sNew))
+	{
+		pShared->ucResult = WEAR_NEW;
+	}
+	else
+	{
+		pShared->ucResult = WEAR_CORRUPT;
+		return;
+	}
+	Host_Run(WEAR_RECOVER_MS);
+	if(!Wear_Same(&sHRegs, &pShared->sRestored))
+	{
+		pShared->ucResult = WEAR_UNSTABLE;
+	}
+	if(!Host_FlashSave(cImage))
+	{
+		_exit(EXIT_FAILURE);
+	}
+}
+
+/**
+  * @brief  Boot the Repaired Image - it Must Give the Same Registers
+  * @param  None
+  * @retval None
+  */
+static void Wear_Verify(void)
+{
+	Wear_Boot(true);
+	if(!Wear_Same(&sHRegs, &pShared->sRestored))
+	{
+		pShared->ucResult = WEAR_UNSTABLE;
+	}
+}
+
+/**
+  * @brief  Every mS: Follow the Store, Give up on a Silent Sensor and Send
+  *         the Next Write Once it is Due (Queued up to a mS Ahead)
+  * @param  None
+  * @retval None
+  */
+static void Wear_Tick(void)
+{
+	uint64_t ullAhead = sHost.ullNs + HOST_NS_PER_MS;
+	uint64_t ullStartNs = WEAR_SETTLE_MS * (uint64_t)HOST_NS_PER_MS;
+	WearWrite *pWrite;
+
+	Wear_Track();
+	if(bWaiting && (sHost.ullNs > ullReqEndNs + WEAR_TIMEOUT_NS))
+	{
+		ulTimeouts ++;
+		bWaiting = false;
+	}
+	if(!bWaiting && ((pWrite = Wear_Next()) != NULL) && (ullStartNs + pWrite->ullNs <= ullAhead))
+	{
+		Wear_Send(pWrite, (ullStartNs + pWrite->ullNs > sHost.ullNs) ? ullStartNs + pWrite->ullNs : sHost.ullNs);
+	}
+}
+
+/**
+  * @brief  A Character From the Sensor - Collect the Response
+  * @param  ucData - Character
+  * @param  ullEndNs - When its Stop Bit Ended
+  * @retval None
+  */
+static void Wear_Tx(uint8_t ucData, uint64_t ullEndNs)
+{
+	if(!bWaiting || (uiRespLength >= BUFFER_SIZE))
+	{
+		return;
+	}
+	ucResp[uiRespLength ++] = ucData;
+	if((uiRespLength == 2) && (ucData & 0x80))
+	{
+		uiRespExpect = WEAR_EXCEPTION_BYTES;
+	}
+	if(uiRespLength < uiRespExpect)
+	{
+		return;
+	}
+	bWaiting = false;
+	if((CRC_Calc(ucResp, uiRespLength) != 0) || (ucResp[1] & 0x80))
+	{
+		ulRejects ++;
+		return;
+	}
+	ulAcks ++;
+	if(ulAckCount == ulAckSize)
+	{
+		ulAckSize = ulAckSize ? 2u * ulAckSize : 1024u;
+		pAckNs = (uint64_t*)realloc(pAckNs, ulAckSize * sizeof(uint64_t));
+		if(pAckNs == NULL)
+		{
+			_exit(EXIT_FAILURE);
+		}
+	}
+	pAckNs[ulAckCount ++] = ullEndNs;
+}
+
+/**
+  * @brief  The Next Write - From the Trace, or the Periodic One
+  * @param  None
+  * @retval Write, NULL When the Trace is Done
+  */
+static WearWrite *Wear_Next(void)
+{
+	if(pTracePath)
+	{
+		return (ulNext < ulTraceCount) ? &pTrace[ulNext] : NULL;
+	}
+	sSynthetic.ullNs = (ulNext + 1u) * (uint64_t)ulPeriod * HOST_NS_PER_S;
+	sSynthetic.uiRegister = uiRegister;
+	sSynthetic.ucCount = 1;
+	sSynthetic.uiValue[0] = (uint16_t)ulNext;
+	return &sSynthetic;
+}
+
+/**
+  * @brief  Send a Write to the Sensor as an FC16 Request
+  * @param  pWrite - Registers and Values
+  * @param  ullStartNs - First Start Bit
+  * @retval None
+  */
+static void Wear_Send(const WearWrite *pWrite, uint64_t ullStartNs)
+{
+	uint8_t ucFrame[BUFFER_SIZE];
+	uint16_t uiLength = 0, uiCRC, i;
+
+	ucFrame[uiLength++] = sHRegs.slave_address;
+	ucFrame[uiLength++] = 16;
+	ucFrame[uiLength++] = (uint8_t)(pWrite->uiRegister >> 8);
+	ucFrame[uiLength++] = (uint8_t)pWrite->uiRegister;
+	ucFrame[uiLength++] = 0;
+	ucFrame[uiLength++] = pWrite->ucCount;
+	ucFrame[uiLength++] = (uint8_t)(2u * pWrite->ucCount);
+	for(i = 0; i < pWrite->ucCount; i++)
+	{
+		ucFrame[uiLength++] = (uint8_t)(pWrite->uiValue[i] >> 8);
+		ucFrame[uiLength++] = (uint8_t)pWrite->uiValue[i];
+	}
+	uiCRC = CRC_Calc(ucFrame, uiLength);
+	ucFrame[uiLength++] = (uint8_t)uiCRC;					//  Low Byte First
+	ucFrame[uiLength++] = (uint8_t)(uiCRC >> 8);
+
+	if((ullReqEndNs = Host_UartSend(ucFrame, uiLength, ullStartNs, 0)) == 0)
+	{
+		return;																	//  Line Queue Full - Next mS
+	}
+	ulNext ++;
+	ulWrites ++;
+	bWaiting = true;
+	uiRespLength = 0;
+	uiRespExpect = WEAR_WRITE_BYTES;
+}
+
+/**
+  * @brief  Follow the Store: a Commit Starts When the Firmware Drops its
+  *         Pending Flag (the Job is Queued, With the Registers as They are
+  *         Now) and is Durable Once the Flash Goes Idle. FlashCommit Only
+  *         Queues on an Idle Flash, so a New Commit Also Ends the Last.
+  * @param  None
+  * @retval None
+  */
+static void Wear_Track(void)
+{
+	bool bInProcess = uiFlags.bFlashCommitInProcess;
+
+	if(bWasInProcess && !bInProcess)
+	{
+		if(bCommitOpen)
+		{
+			Wear_Durable();
+		}
+		sCommitting = sHRegs;
+		ullCommitStartNs = sHost.ullNs;
+		ulAckCommit = ulAckCount;
+		bCommitOpen = true;
+	}
+	else if(bCommitOpen && !FlashBusy())
+	{
+		Wear_Durable();
+	}
+	bWasInProcess = bInProcess;
+}
+
+/**
+  * @brief  The Commit in Flight is Down - Time it and the Writes it Covers
+  * @param  None
+  * @retval None
+  */
+static void Wear_Durable(void)
+{
+	uint32_t i;
+
+	Wear_Sample(&sCommitSamples, sHost.ullNs - ullCommitStartNs);
+	for(i = 0; i < ulAckCommit; i++)
+	{
+		Wear_Sample(&sDurableSamples, sHost.ullNs - pAckNs[i]);
+	}
+	memmove(pAckNs, pAckNs + ulAckCommit, (ulAckCount - ulAckCommit) * sizeof(uint64_t));
+	ulAckCount -= ulAckCommit;
+	ulAckCommit = 0;
+	sDurable = sCommitting;
+	bCommitOpen = false;
+}
+
+/**
+  * @brief  Compare the Stored Part of Two Register Sets
+  * @param  pA, pB - Holding Registers
+  * @retval true if the Same
+  */
+static bool Wear_Same(const HoldRegs *pA, const HoldRegs *pB)
+{
+	return memcmp(pA, pB, uiHRegRecordSize) == 0;
+}
+
+static void Wear_Sample(WearSamples *pSamples, uint64_t ullNs)
+{
+	if(pSamples->ulCount == pSamples->ulSize)
+	{
+		pSamples->ulSize = pSamples->ulSize ? 2u * pSamples->ulSize : 1024u;
+		pSamples->pNs = (uint64_t*)realloc(pSamples->pNs, pSamples->ulSize * sizeof(uint64_t));
+		if(pSamples->pNs == NULL)
+		{
+			_exit(EXIT_FAILURE);
+		}
+	}
+	pSamples->pNs[pSamples->ulCount ++] = ullNs;
+}
+
+/**
+  * @brief  xorshift32 - Same Trials for the Same Seed
+  * @param  None
+  * @retval Next Value
+  */
+static uint32_t Wear_Random(void)
+{
+	ulRandom ^= ulRandom << 13;
+	ulRandom ^= ulRandom >> 17;
+	ulRandom ^= ulRandom << 5;
+	return ulRandom;
+}
+
+static int Wear_Compare(const void *pA, const void *pB)
+{
+	uint64_t ullA = *(const uint64_t*)pA, ullB = *(const uint64_t*)pB;
+
+	return (ullA > ullB) - (ullA < ullB);
+}
+
+/**
+  * @brief  Nearest Rank Percentiles
+  * @param  pSamples - Samples, Sorted Here
+  * @param  pOut - One per dWearPercentile, 0 if no Samples
+  * @retval None
+  */
+static void Wear_Percentiles(WearSamples *pSamples, uint64_t *pOut)
+{
+	uint32_t ulRank;
+	uint8_t k;
+
+	qsort(pSamples->pNs, pSamples->ulCount, sizeof(uint64_t), Wear_Compare);
+	for(k = 0; k < WEAR_PERCENTILES; k++)
+	{
+		ulRank = (uint32_t)(dWearPercentile[k] * pSamples->ulCount + 0.999999);
+		pOut[k] = pSamples->ulCount ? pSamples->pNs[(ulRank == 0) ? 0 : ulRank - 1u] : 0;
+	}
+}
+
+/**
+  * @brief  Write the Results - a Table, or JSON When a Label is Given
+  * @param  pFile - Output
+  * @param  pLabel - JSON Run Label, NULL for the Table
+  * @param  pResults - Trial Outcomes, per WEAR_RESULT
+  * @param  pFailures - Op and Byte of the First Failing Trials
+  * @param  ulFailed - Number Listed
+  * @retval None
+  */
+static void Wear_Report(FILE *pFile, const char *pLabel, const uint32_t *pResults, const uint32_t (*pFailures)[2],
+												uint32_t ulFailed)
+{
+	const uint16_t uiPageA = (FLASH_PAGE_A - FLASH_BASE) / FLASH_PAGE_BYTES;
+	const uint16_t uiPageB = (FLASH_PAGE_B - FLASH_BASE) / FLASH_PAGE_BYTES;
+	const uint16_t uiAbc = (ABC_RING_BASE - FLASH_BASE) / FLASH_PAGE_BYTES;
+	const uint32_t *pErases = pShared->ulPageErases;
+	uint32_t ulParam = pErases[uiPageA] + pErases[uiPageB];
+	uint32_t ulWorst = 0, ulTrialCount = 0;
+	double dPer10k = pShared->ulAcks ? 10000.0 * ulParam / pShared->ulAcks : 0.0;
+	double dPerDay, dYears;
+	uint16_t i;
+	uint8_t k;
+
+	for(i = 0; i < HOST_FLASH_PAGES; i++)
+	{
+		ulWorst = (pErases[i] > ulWorst) ? pErases[i] : ulWorst;
+	}
+	for(k = 0; k < WEAR_RESULTS; k++)
+	{
+		ulTrialCount += pResults[k];
+	}
+	dPerDay = ulWorst * 86400.0 / ulSeconds;
+	dYears = dPerDay ? WEAR_ENDURANCE / dPerDay / 365.25 : 0.0;
+
+	if(pLabel == NULL)
+	{
+		fprintf(pFile, "%s, %u s: writes %u, acked %u, rejected %u, timeouts %u, commits %u\n",
+					 pTracePath ? pTracePath : "periodic", (unsigned)ulSeconds, (unsigned)pShared->ulWrites,
+					 (unsigned)pShared->ulAcks, (unsigned)pShared->ulRejects, (unsigned)pShared->ulTimeouts,
+					 (unsigned)pShared->ulCommits);
+		fprintf(pFile, "erases: page A %u, page B %u, abc ring %u + %u; %.2f per 10k writes; busiest page %.2f/day",
+					 (unsigned)pErases[uiPageA], (unsigned)pErases[uiPageB], (unsigned)pErases[uiAbc], (unsigned)pErases[uiAbc + 1u],
+					 dPer10k, dPerDay);
+		if(dPerDay)
+		{
+			fprintf(pFile, " - %u cycles in %.1f years", WEAR_ENDURANCE, dYears);
+		}
+		fprintf(pFile, "\ncommit busy p50 %.1f ms, p99 %.1f ms, max %.1f ms; write to durable p50 %.2f s, p99 %.2f s, max %.2f s\n",
+					 pShared->ullCommitNs[0] / 1e6, pShared->ullCommitNs[1] / 1e6, pShared->ullCommitNs[2] / 1e6,
+					 pShared->ullDurableNs[0] / 1e9, pShared->ullDurableNs[1] / 1e9, pShared->ullDurableNs[2] / 1e9);
+		fprintf(pFile, "power fail trials %u over ops %u..%u:", (unsigned)ulTrialCount, (unsigned)pShared->ulOpsSettled + 1u,
+					 (unsigned)pShared->ulOpsEnd);
+		for(k = 0; k < WEAR_RESULTS; k++)
+		{
+			fprintf(pFile, " %s %u", pWearResult[k], (unsigned)pResults[k]);
+		}
+		for(i = 0; i < ulFailed; i++)
+		{
+			fprintf(pFile, "%s %u:%u", i ? "," : "; failed at", (unsigned)pFailures[i][0], (unsigned)pFailures[i][1]);
+		}
+		fprintf(pFile, "\n");
+		return;
+	}
+
+	fprintf(pFile, "{\n  \"label\": \"%s\",\n", pLabel);
+	fprintf(pFile, "  \"config\": { \"trace\": \"%s\", \"period_s\": %u, \"register\": %u, \"seconds\": %u, \"erase_us\": %u, "
+								 "\"program_us\": %u, \"seed\": %u },\n",
+					pTracePath ? pTracePath : "", pTracePath ? 0u : (unsigned)ulPeriod, pTracePath ? 0u : (unsigned)uiRegister,
+					(unsigned)ulSeconds, (unsigned)ulEraseUs, (unsigned)ulProgramUs, (unsigned)ulSeed);
+	fprintf(pFile, "  \"writes\": { \"sent\": %u, \"acked\": %u, \"rejected\": %u, \"timeouts\": %u },\n",
+					(unsigned)pShared->ulWrites, (unsigned)pShared->ulAcks, (unsigned)pShared->ulRejects, (unsigned)pShared->ulTimeouts);
+	fprintf(pFile, "  \"erases\": { \"page_a\": %u, \"page_b\": %u, \"abc\": [%u, %u], \"parameter_per_10k_writes\": %.3f, "
+								 "\"busiest_page_per_day\": %.3f, \"years_to_endurance\": ",
+					(unsigned)pErases[uiPageA], (unsigned)pErases[uiPageB], (unsigned)pErases[uiAbc], (unsigned)pErases[uiAbc + 1u],
+					dPer10k, dPerDay);
+	if(dPerDay)
+	{
+		fprintf(pFile, "%.2f", dYears);
+	}
+	else
+	{
+		fprintf(pFile, "null");
+	}
+	fprintf(pFile, ", \"endurance_cycles\": %u, \"programs\": %u, \"program_errors\": %u },\n", WEAR_ENDURANCE,
+					(unsigned)pShared->ulPrograms, (unsigned)pShared->ulErrors);
+	fprintf(pFile, "  \"commits\": %u,\n  \"commit_busy_ms\": {", (unsigned)pShared->ulCommits);
+	for(k = 0; k < WEAR_PERCENTILES; k++)
+	{
+		fprintf(pFile, "%s \"%s\": %.3f", k ? "," : "", pWearPercentile[k], pShared->ullCommitNs[k] / 1e6);
+	}
+	fprintf(pFile, " },\n  \"write_to_durable_s\": {");
+	for(k = 0; k < WEAR_PERCENTILES; k++)
+	{
+		fprintf(pFile, "%s \"%s\": %.3f", k ? "," : "", pWearPercentile[k], pShared->ullDurableNs[k] / 1e9);
+	}
+	fprintf(pFile, " },\n  \"power_fail\": { \"trials\": %u, \"ops\": [%u, %u]", (unsigned)ulTrialCount,
+					(unsigned)pShared->ulOpsSettled + 1u, (unsigned)pShared->ulOpsEnd);
+	for(k = 0; k < WEAR_RESULTS; k++)
+	{
+		fprintf(pFile, ", \"%s\": %u", pWearResult[k], (unsigned)pResults[k]);
+	}
+	fprintf(pFile, ", \"failed_at\": [");
+	for(i = 0; i < ulFailed; i++)
+	{
+		fprintf(pFile, "%s\"%u:%u\"", i ? ", " : "", (unsigned)pFailures[i][0], (unsigned)pFailures[i][1]);
+	}
+	fprintf(pFile, "] }\n}\n");
+}
@@ -0,0 +1,1227 @@
+/**
+  ******************************************************************************
+  * 											Next Generation CO2 Sensor
+  * 											Host Build - Cortex-M0+ Cycle Benchmark
+  *
+  *   nextgen_iss [-n calls] [-m] [-w wait_states] [-c cycles.csv]
+  *               [-r reference.csv] [-t percent] [-o results.json] [-l label]
+  *               bench.elf
+  *
+  *   Runs the Cases of a Bench Image (host/iss, Cross Compiled for thumbv6m)
+  *   on an ARMv6-M Instruction Set Simulator and Counts the Cycles Each Call
+  *   Takes on the Cortex-M0+, Timed as its TRM Gives the Instructions: Most
+  *   are 1 Cycle, Loads and Stores 2 (1 on the IOPORT), LDM/STM/PUSH/POP 1+N,
+  *   POP With PC 3+N, Taken Branches 2, BL 3, MRS/MSR/Barriers 3 and MULS 1,
+  *   or 32 for the Small Multiplier (-m). Memory is Zero Wait State Unless -w
+  *   Adds Wait States to Each Flash Word Fetched or Read (no Prefetch, so an
+  *   Upper Bound). The Numbers are Exact for That Model and the Same on
+  *   Every Machine.
+  *
+  *   The Image Exports sBenchCases[ulBenchCases] (host/iss/bench.h) and
+  *   Bench_Init, Which Runs First. Each Case's Setup Runs Uncounted Before
+  *   Every Call, Then its Run is Called (-n Overrides the Case's Count).
+  *   The Peripherals are Plain Memory Apart From SysTick, Which Counts Down
+  *   With the Cycles; Interrupts are Not Taken. -r Compares With an Earlier
+  *   -c Run and Fails if a Case Grew More Than -t Percent.
+  ******************************************************************************
+  */
+
+//  Includes
+#include  <stdint.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+
+#define ISS_RETURN							0xfffffffeu			//  LR on Entry; Returning Here Ends the Call
+#define ISS_CALL_LIMIT					50000000ull			//  Cycles Before a Call Counts as Hung
+#define ISS_NAME_BYTES					48u
+#define ISS_CASES_MAX						64u
+
+#define ISS_SYSTICK_CTRL				0xe000e010u
+#define ISS_SYSTICK_LOAD				0xe000e014u
+#define ISS_SYSTICK_VAL					0xe000e018u
+#define ISS_SYSTICK_COUNTFLAG		0x00010000u
+
+//  Memory Map - STM32C0 Flash and SRAM (Sized for the Bench Image, See
+//  host/iss/bench.ld), the Peripherals and the System Control Space
+typedef struct
+{
+	uint32_t ulBase;
+	uint32_t ulBytes;
+	uint8_t ucCycles;										//  Load or Store
+	bool bFlash;												//  Takes the Wait States
+	uint8_t *pData;
+} IssRegion;
+
+static IssRegion sIssRegion[] =
+{
+	{ 0x08000000u, 0x20000u, 2, true, NULL },			//  Flash
+	{ 0x1fff0000u, 0x8000u, 2, false, NULL },			//  System Memory, Engineering Bytes
+	{ 0x20000000u, 0x3000u, 2, false, NULL },			//  SRAM
+	{ 0x40000000u, 0x30000u, 2, false, NULL },		//  APB and AHB Peripherals
+	{ 0x50000000u, 0x2000u, 1, false, NULL },			//  IOPORT - Single Cycle
+	{ 0xe000e000u, 0x1000u, 2, false, NULL }			//  System Control Space
+};
+
+#define ISS_REGIONS							(sizeof(sIssRegion) / sizeof(sIssRegion[0]))
+
+typedef struct
+{
+	uint32_t ulR[16];
+	bool bN, bZ, bC, bV;
+	uint32_t ulPrimask;
+	uint64_t ullCycles;
+	uint64_t ullInstructions;
+	uint32_t ulFetchWord;								//  Last Flash Word Fetched, for the Wait States
+	uint32_t ulFetchCycles;							//  Wait States of This Instruction's Fetches
+	uint32_t ulSysTickCtrl;
+	uint32_t ulSysTickLoad;
+	uint32_t ulSysTickVal;
+	const char *pFault;
+	uint32_t ulFaultPC;
+	uint32_t ulFaultAddress;
+} IssCore;
+
+//  One Case of the Bench Image, as Laid Out on the Target (host/iss/bench.h)
+typedef struct
+{
+	uint32_t ulName;
+	uint32_t ulSetup;
+	uint32_t ulRun;
+	uint32_t ulCalls;
+} IssBenchCase;
+
+typedef struct
+{
+	char cName[ISS_NAME_BYTES];
+	uint32_t ulCalls;
+	uint64_t ullCycles;
+	uint64_t ullInstructions;
+	uint64_t ullMin;
+	uint64_t ullMax;
+	double dReference;									//  Cycles per Call Before, 0 if None
+	bool bFault;
+	bool bOver;
+} IssResult;
+
+static IssCore sCore;
+static IssResult sResult[ISS_CASES_MAX];
+static uint32_t ulResults;
+static bool bSmallMultiplier = false;
+static uint8_t ucWaitStates = 0;
+
+static bool Iss_Load(const char *, uint32_t *, uint32_t *, uint32_t *, uint32_t *);
+static IssRegion *Iss_Region(uint32_t, uint8_t);
+static uint32_t Iss_Read(uint32_t, uint8_t);
+static void Iss_Write(uint32_t, uint32_t, uint8_t);
+static void Iss_Fault(const char *, uint32_t);
+static bool Iss_Call(uint32_t, uint32_t);
+static void Iss_Step(void);
+static uint32_t Iss_Fetch(uint32_t);
+static uint32_t Iss_Add(uint32_t, uint32_t, bool, bool);
+static void Iss_SetNZ(uint32_t);
+static bool Iss_Condition(uint8_t);
+static void Iss_SysTick(uint32_t);
+static bool Iss_Reference(const char *);
+static void Iss_Report(FILE *, const char *, double);
+
+int main(int argc, char **argv)
+{
+	const char *pJson = NULL;
+	const char *pLabel = "";
+	const char *pCsv = NULL;
+	const char *pReference = NULL;
+	const char *pImage;
+	double dTolerance = 2.0;
+	uint32_t ulCallsOverride = 0;
+	uint32_t ulCases, ulCount, ulInit, ulStack;
+	IssBenchCase sCase;
+	IssResult *pResult;
+	uint64_t ullCycles, ullInstructions;
+	bool bFailed = false;
+	FILE *pFile;
+	uint32_t i, j;
+	int iArg;
+
+	for(iArg = 1; iArg < argc - 1; iArg++)
+	{
+		const char *pValue = argv[iArg + 1];
+
+		if(strcmp(argv[iArg], "-m") == 0)
+		{
+			bSmallMultiplier = true;
+			continue;
+		}
+		if(strcmp(argv[iArg], "-n") == 0)
+		{
+			ulCallsOverride = (uint32_t)strtoul(pValue, NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-w") == 0)
+		{
+			ucWaitStates = (uint8_t)strtoul(pValue, NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-c") == 0)
+		{
+			pCsv = pValue;
+		}
+		else if(strcmp(argv[iArg], "-r") == 0)
+		{
+			pReference = pValue;
+		}
+		else if(strcmp(argv[iArg], "-t") == 0)
+		{
+			dTolerance = strtod(pValue, NULL);
+		}
+		else if(strcmp(argv[iArg], "-o") == 0)
+		{
+			pJson = pValue;
+		}
+		else if(strcmp(argv[iArg], "-l") == 0)
+		{
+			pLabel = pValue;
+		}
+		else
+		{
+			break;
+		}
+		iArg ++;
+	}
+	if(iArg != argc - 1)
+	{
+		fprintf(stderr, "usage: %s [-n calls] [-m] [-w wait_states] [-c cycles.csv] [-r reference.csv] [-t percent]\n"
+										"       [-o results.json] [-l label] bench.elf\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	pImage = argv[iArg];
+
+	for(i = 0; i < ISS_REGIONS; i++)
+	{
+		sIssRegion[i].pData = (uint8_t *)calloc(sIssRegion[i].ulBytes, 1);
+	}
+	if(!Iss_Load(pImage, &ulCases, &ulCount, &ulInit, &ulStack))
+	{
+		return EXIT_FAILURE;
+	}
+	ulCount = Iss_Read(ulCount, 4);
+	if(ulCount > ISS_CASES_MAX)
+	{
+		fprintf(stderr, "%s: %u cases, at most %u\n", pImage, (unsigned)ulCount, ISS_CASES_MAX);
+		return EXIT_FAILURE;
+	}
+
+	sCore.ulR[13] = ulStack;
+	if(ulInit && !Iss_Call(ulInit, ulStack))
+	{
+		fprintf(stderr, "%s: Bench_Init: %s at pc 0x%08x, address 0x%08x\n", pImage, sCore.pFault,
+						(unsigned)sCore.ulFaultPC, (unsigned)sCore.ulFaultAddress);
+		return EXIT_FAILURE;
+	}
+
+	for(i = 0; i < ulCount; i++)
+	{
+		pResult = &sResult[ulResults++];
+		sCase.ulName = Iss_Read(ulCases + 16u * i, 4);
+		sCase.ulSetup = Iss_Read(ulCases + 16u * i + 4u, 4);
+		sCase.ulRun = Iss_Read(ulCases + 16u * i + 8u, 4);
+		sCase.ulCalls = ulCallsOverride ? ulCallsOverride : Iss_Read(ulCases + 16u * i + 12u, 4);
+		for(j = 0; j < ISS_NAME_BYTES - 1u; j++)
+		{
+			if((pResult->cName[j] = (char)Iss_Read(sCase.ulName + j, 1)) == '\0')
+			{
+				break;
+			}
+		}
+		pResult->ullMin = UINT64_MAX;
+
+		for(j = 0; (j < sCase.ulCalls) && !pResult->bFault; j++)
+		{
+			if(sCase.ulSetup && !Iss_Call(sCase.ulSetup, ulStack))
+			{
+				pResult->bFault = true;
+				break;
+			}
+			ullCycles = sCore.ullCycles;
+			ullInstructions = sCore.ullInstructions;
+			pResult->bFault = !Iss_Call(sCase.ulRun, ulStack);
+			ullCycles = sCore.ullCycles - ullCycles;
+			pResult->ullCycles += ullCycles;
+			pResult->ullInstructions += sCore.ullInstructions - ullInstructions;
+			pResult->ullMin = (ullCycles < pResult->ullMin) ? ullCycles : pResult->ullMin;
+			pResult->ullMax = (ullCycles > pResult->ullMax) ? ullCycles : pResult->ullMax;
+			pResult->ulCalls ++;
+		}
+		if(pResult->bFault)
+		{
+			fprintf(stderr, "%s: %s: %s at pc 0x%08x, address 0x%08x\n", pImage, pResult->cName, sCore.pFault,
+							(unsigned)sCore.ulFaultPC, (unsigned)sCore.ulFaultAddress);
+			bFailed = true;
+		}
+	}
+
+	if(pReference && !Iss_Reference(pReference))
+	{
+		return EXIT_FAILURE;
+	}
+	for(i = 0; i < ulResults; i++)
+	{
+		pResult = &sResult[i];
+		if((pResult->dReference > 0) && pResult->ulCalls &&
+			 ((double)pResult->ullCycles / pResult->ulCalls > pResult->dReference * (1.0 + dTolerance / 100.0)))
+		{
+			pResult->bOver = true;
+			bFailed = true;
+		}
+	}
+
+	Iss_Report(stdout, NULL, dTolerance);
+	if(pCsv)
+	{
+		if((pFile = fopen(pCsv, "w")) == NULL)
+		{
+			fprintf(stderr, "%s: can not write %s\n", argv[0], pCsv);
+			return EXIT_FAILURE;
+		}
+		fprintf(pFile, "case,calls,cycles_per_call,min,max,instructions_per_call\n");
+		for(i = 0; i < ulResults; i++)
+		{
+			pResult = &sResult[i];
+			fprintf(pFile, "%s,%u,%.2f,%llu,%llu,%.2f\n", pResult->cName, (unsigned)pResult->ulCalls,
+							pResult->ulCalls ? (double)pResult->ullCycles / pResult->ulCalls : 0.0,
+							pResult->ulCalls ? (unsigned long long)pResult->ullMin : 0ull, (unsigned long long)pResult->ullMax,
+							pResult->ulCalls ? (double)pResult->ullInstructions / pResult->ulCalls : 0.0);
+		}
+		fclose(pFile);
+	}
+	if(pJson)
+	{
+		if((pFile = fopen(pJson, "w")) == NULL)
+		{
+			fprintf(stderr, "%s: can not write %s\n", argv[0], pJson);
+			return EXIT_FAILURE;
+		}
+		Iss_Report(pFile, pLabel, dTolerance);
+		fclose(pFile);
+	}
+	return bFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+  * @brief  Load an ELF Image's Segments (at Their Run Addresses, so .data is
+  *         Initialized and .bss Cleared) and Find the Bench Symbols
+  * @param  pPath - Image
+  * @param  pCases, pCount, pInit, pStack - sBenchCases, ulBenchCases,
+  *         Bench_Init (0 if Absent) and _estack Out
+  * @retval false on an Unusable Image (Reported)
+  */
+static bool Iss_Load(const char *pPath, uint32_t *pCases, uint32_t *pCount, uint32_t *pInit, uint32_t *pStack)
+{
+	const char * const pSymbol[4] = { "sBenchCases", "ulBenchCases", "Bench_Init", "_estack" };
+	uint32_t * const pValue[4] = { pCases, pCount, pInit, pStack };
+	uint8_t *pElf, *pSection, *pEntry;
+	const char *pStrings;
+	uint32_t ulPhOff, ulShOff, ulOffset, ulAddress, ulFileBytes, ulMemBytes, ulLink;
+	uint16_t uiPhNum, uiShNum, uiPhSize, uiShSize;
+	IssRegion *pRegion;
+	bool bFound[4] = { false };
+	long lBytes;
+	FILE *pFile;
+	uint32_t i, j, k;
+
+	if(((pFile = fopen(pPath, "rb")) == NULL) || (fseek(pFile, 0, SEEK_END) != 0) || ((lBytes = ftell(pFile)) < 52))
+	{
+		fprintf(stderr, "%s: can not read\n", pPath);
+		return false;
+	}
+	pElf = (uint8_t *)malloc(lBytes);
+	rewind(pFile);
+	if(fread(pElf, lBytes, 1, pFile) != 1)
+	{
+		fprintf(stderr, "%s: can not read\n", pPath);
+		return false;
+	}
+	fclose(pFile);
+
+	//  ELF32, Little Endian, ARM
+	if((memcmp(pElf, "\177ELF", 4) != 0) || (pElf[4] != 1) || (pElf[5] != 1) || ((pElf[18] | (pElf[19] << 8)) != 40))
+	{
+		fprintf(stderr, "%s: not a 32 bit little endian ARM ELF\n", pPath);
+		return false;
+	}
+	memcpy(&ulPhOff, pElf + 28, 4);
+	memcpy(&ulShOff, pElf + 32, 4);
+	memcpy(&uiPhSize, pElf + 42, 2);
+	memcpy(&uiPhNum, pElf + 44, 2);
+	memcpy(&uiShSize, pElf + 46, 2);
+	memcpy(&uiShNum, pElf + 48, 2);
+
+	for(i = 0; i < uiPhNum; i++)
+	{
+		pEntry = pElf + ulPhOff + i * uiPhSize;
+		if((pEntry[0] | (pEntry[1] << 8)) != 1)			//  PT_LOAD
+		{
+			continue;
+		}
+		memcpy(&ulOffset, pEntry + 4, 4);
+		memcpy(&ulAddress, pEntry + 8, 4);
+		memcpy(&ulFileBytes, pEntry + 16, 4);
+		memcpy(&ulMemBytes, pEntry + 20, 4);
+		if(ulMemBytes == 0)
+		{
+			continue;
+		}
+		pRegion = Iss_Region(ulAddress, 1);
+		if((pRegion == NULL) || (ulAddress - pRegion->ulBase + ulMemBytes > pRegion->ulBytes) ||
+			 (ulOffset + ulFileBytes > (uint32_t)lBytes))
+		{
+			fprintf(stderr, "%s: segment at 0x%08x (%u bytes) is outside the memory map\n", pPath, (unsigned)ulAddress,
+							(unsigned)ulMemBytes);
+			return false;
+		}
+		memcpy(pRegion->pData + (ulAddress - pRegion->ulBase), pElf + ulOffset, ulFileBytes);
+	}
+
+	//  Symbols
+	for(i = 0; i < uiShNum; i++)
+	{
+		pSection = pElf + ulShOff + i * uiShSize;
+		if((pSection[4] | (pSection[5] << 8)) != 2)		//  SHT_SYMTAB
+		{
+			continue;
+		}
+		memcpy(&ulOffset, pSection + 16, 4);
+		memcpy(&ulFileBytes, pSection + 20, 4);
+		memcpy(&ulLink, pSection + 24, 4);
+		memcpy(&ulAddress, pElf + ulShOff + ulLink * uiShSize + 16, 4);
+		pStrings = (const char *)pElf + ulAddress;
+		for(j = 0; j < ulFileBytes / 16u; j++)
+		{
+			pEntry = pElf + ulOffset + 16u * j;
+			memcpy(&ulLink, pEntry, 4);
+			for(k = 0; k < 4; k++)
+			{
+				if(strcmp(pStrings + ulLink, pSymbol[k]) == 0)
+				{
+					memcpy(pValue[k], pEntry + 4, 4);
+					bFound[k] = true;
+				}
+			}
+		}
+	}
+	free(pElf);
+	if(!bFound[0] || !bFound[1])
+	{
+		fprintf(stderr, "%s: no sBenchCases / ulBenchCases\n", pPath);
+		return false;
+	}
+	if(!bFound[2])
+	{
+		*pInit = 0;
+	}
+	if(!bFound[3])
+	{
+		*pStack = sIssRegion[2].ulBase + sIssRegion[2].ulBytes;
+	}
+	return true;
+}
+
+/**
+  * @brief  Region Holding an Access
+  * @param  ulAddress - First Byte
+  * @param  ucBytes - Size
+  * @retval Region, NULL if Unmapped
+  */
+static IssRegion *Iss_Region(uint32_t ulAddress, uint8_t ucBytes)
+{
+	uint8_t i;
+
+	for(i = 0; i < ISS_REGIONS; i++)
+	{
+		if((ulAddress >= sIssRegion[i].ulBase) && (ulAddress - sIssRegion[i].ulBase + ucBytes <= sIssRegion[i].ulBytes))
+		{
+			return &sIssRegion[i];
+		}
+	}
+	return NULL;
+}
+
+/**
+  * @brief  Load From the Memory Map - Unmapped or Unaligned Faults, as on
+  *         the Core
+  * @param  ulAddress - Address
+  * @param  ucBytes - 1, 2 or 4
+  * @retval Value, Zero Extended
+  */
+static uint32_t Iss_Read(uint32_t ulAddress, uint8_t ucBytes)
+{
+	IssRegion *pRegion;
+	uint32_t ulValue = 0;
+
+	if(ulAddress & (ucBytes - 1u))
+	{
+		Iss_Fault("unaligned load", ulAddress);
+		return 0;
+	}
+	switch(ulAddress)
+	{
+	case ISS_SYSTICK_CTRL:
+		ulValue = sCore.ulSysTickCtrl;
+		sCore.ulSysTickCtrl &= ~ISS_SYSTICK_COUNTFLAG;
+		return ulValue;
+	case ISS_SYSTICK_LOAD:
+		return sCore.ulSysTickLoad;
+	case ISS_SYSTICK_VAL:
+		return sCore.ulSysTickVal;
+	default:
+		break;
+	}
+	if((pRegion = Iss_Region(ulAddress, ucBytes)) == NULL)
+	{
+		Iss_Fault("unmapped load", ulAddress);
+		return 0;
+	}
+	memcpy(&ulValue, pRegion->pData + (ulAddress - pRegion->ulBase), ucBytes);
+	return ulValue;
+}
+
+/**
+  * @brief  Store to the Memory Map
+  * @param  ulAddress - Address
+  * @param  ulValue - Value, Low ucBytes Used
+  * @param  ucBytes - 1, 2 or 4
+  * @retval None
+  */
+static void Iss_Write(uint32_t ulAddress, uint32_t ulValue, uint8_t ucBytes)
+{
+	IssRegion *pRegion;
+
+	if(ulAddress & (ucBytes - 1u))
+	{
+		Iss_Fault("unaligned store", ulAddress);
+		return;
+	}
+	switch(ulAddress)
+	{
+	case ISS_SYSTICK_CTRL:
+		sCore.ulSysTickCtrl = (sCore.ulSysTickCtrl & ISS_SYSTICK_COUNTFLAG) | (ulValue & 0x7u);
+		return;
+	case ISS_SYSTICK_LOAD:
+		sCore.ulSysTickLoad = ulValue & 0x00ffffffu;
+		return;
+	case ISS_SYSTICK_VAL:
+		sCore.ulSysTickVal = 0;								//  Any Write Clears
+		sCore.ulSysTickCtrl &= ~ISS_SYSTICK_COUNTFLAG;
+		return;
+	default:
+		break;
+	}
+	if((pRegion = Iss_Region(ulAddress, ucBytes)) == NULL)
+	{
+		Iss_Fault("unmapped store", ulAddress);
+		return;
+	}
+	memcpy(pRegion->pData + (ulAddress - pRegion->ulBase), &ulValue, ucBytes);
+}
+
+/**
+  * @brief  Stop the Call - the First Fault Wins
+  * @param  pWhat - Reason
+  * @param  ulAddress - Address Involved
+  * @retval None
+  */
+static void Iss_Fault(const char *pWhat, uint32_t ulAddress)
+{
+	if(sCore.pFault == NULL)
+	{
+		sCore.pFault = pWhat;
+		sCore.ulFaultPC = sCore.ulR[15];
+		sCore.ulFaultAddress = ulAddress;
+	}
+}
+
+/**
+  * @brief  Call a Function of the Image With no Arguments, to its Return
+  * @param  ulFunction - Address (Thumb Bit Set)
+  * @param  ulStack - Initial SP
+  * @retval false if it Faulted or Hung
+  */
+static bool Iss_Call(uint32_t ulFunction, uint32_t ulStack)
+{
+	uint64_t ullLimit = sCore.ullCycles + ISS_CALL_LIMIT;
+
+	sCore.pFault = NULL;
+	sCore.ulR[13] = ulStack;
+	sCore.ulR[14] = ISS_RETURN | 1u;
+	sCore.ulR[15] = ulFunction & ~1u;
+	sCore.ulFetchWord = 0xffffffffu;
+	while((sCore.ulR[15] != ISS_RETURN) && (sCore.pFault == NULL))
+	{
+		Iss_Step();
+		if(sCore.ullCycles > ullLimit)
+		{
+			Iss_Fault("no return", 0);
+		}
+	}
+	return sCore.pFault == NULL;
+}
+
+/**
+  * @brief  Fetch a Halfword, Charging the Wait States When a New Flash Word
+  *         is Needed - Always After a Branch, as the Pipeline Refills
+  * @param  ulAddress - Instruction Address
+  * @retval Halfword
+  */
+static uint32_t Iss_Fetch(uint32_t ulAddress)
+{
+	IssRegion *pRegion = Iss_Region(ulAddress, 2);
+
+	if(pRegion == NULL)
+	{
+		Iss_Fault("unmapped fetch", ulAddress);
+		return 0xde00u;											//  UDF
+	}
+	if(pRegion->bFlash && ((ulAddress & ~3u) != sCore.ulFetchWord))
+	{
+		sCore.ulFetchWord = ulAddress & ~3u;
+		sCore.ulFetchCycles += ucWaitStates;
+	}
+	return Iss_Read(ulAddress, 2);
+}
+
+/**
+  * @brief  AddWithCarry, Setting N, Z, C and V When Asked
+  * @param  ulX, ulY - Operands (Subtraction Passes ~Y and a Carry of 1)
+  * @param  bCarry - Carry In
+  * @param  bFlags - Update the Flags
+  * @retval Sum
+  */
+static uint32_t Iss_Add(uint32_t ulX, uint32_t ulY, bool bCarry, bool bFlags)
+{
+	uint64_t ullSum = (uint64_t)ulX + ulY + bCarry;
+	uint32_t ulResult = (uint32_t)ullSum;
+
+	if(bFlags)
+	{
+		Iss_SetNZ(ulResult);
+		sCore.bC = (ullSum >> 32) != 0;
+		sCore.bV = (((ulX ^ ulResult) & (ulY ^ ulResult)) >> 31) != 0;
+	}
+	return ulResult;
+}
+
+static void Iss_SetNZ(uint32_t ulResult)
+{
+	sCore.bN = (ulResult >> 31) != 0;
+	sCore.bZ = ulResult == 0;
+}
+
+/**
+  * @brief  Evaluate a Condition Code
+  * @param  ucCondition - 0 (EQ) to 14 (AL)
+  * @retval Passed
+  */
+static bool Iss_Condition(uint8_t ucCondition)
+{
+	bool bResult;
+
+	switch(ucCondition >> 1)
+	{
+	case 0:	bResult = sCore.bZ; break;
+	case 1:	bResult = sCore.bC; break;
+	case 2:	bResult = sCore.bN; break;
+	case 3:	bResult = sCore.bV; break;
+	case 4:	bResult = sCore.bC && !sCore.bZ; break;
+	case 5:	bResult = sCore.bN == sCore.bV; break;
+	case 6:	bResult = (sCore.bN == sCore.bV) && !sCore.bZ; break;
+	default: return true;
+	}
+	return (ucCondition & 1u) ? !bResult : bResult;
+}
+
+/**
+  * @brief  Count SysTick Down by the Cycles Just Taken
+  * @param  ulCycles - Cycles
+  * @retval None
+  */
+static void Iss_SysTick(uint32_t ulCycles)
+{
+	uint64_t ullPeriod = (uint64_t)sCore.ulSysTickLoad + 1u;
+
+	if(!(sCore.ulSysTickCtrl & 1u) || (sCore.ulSysTickLoad == 0))
+	{
+		return;
+	}
+	if(ulCycles <= sCore.ulSysTickVal)
+	{
+		sCore.ulSysTickVal -= ulCycles;
+		return;
+	}
+	//  Reaches 0 and Reloads - VAL 0 Also Reloads on the Next Count
+	ulCycles -= sCore.ulSysTickVal + 1u;
+	sCore.ulSysTickVal = (uint32_t)(sCore.ulSysTickLoad - ulCycles % ullPeriod);
+	sCore.ulSysTickCtrl |= ISS_SYSTICK_COUNTFLAG;
+}
+
+/**
+  * @brief  Execute One Instruction
+  * @param  None
+  * @retval None
+  */
+static void Iss_Step(void)
+{
+	uint32_t * const pR = sCore.ulR;
+	uint32_t ulPC = pR[15];
+	uint32_t ulOp = Iss_Fetch(ulPC);
+	uint32_t ulNext = ulPC + 2u;
+	uint32_t ulSequential = ulNext;
+	uint32_t ulPCRead = ulPC + 4u;
+	uint32_t ulCycles = 1;
+	uint32_t ulA, ulB, ulResult, ulAddress, ulList, ulOp2;
+	uint8_t ucRd = ulOp & 7u;
+	uint8_t ucRn = (ulOp >> 3) & 7u;
+	uint8_t ucShift, ucCount, i;
+	int32_t lOffset;
+
+	switch(ulOp >> 11)
+	{
+	case 0x00:															//  LSLS Rd, Rm, #imm5 (MOVS Rd, Rm)
+		ucShift = (ulOp >> 6) & 31u;
+		ulResult = pR[ucRn] << ucShift;
+		if(ucShift)
+		{
+			sCore.bC = (pR[ucRn] >> (32u - ucShift)) & 1u;
+		}
+		pR[ucRd] = ulResult;
+		Iss_SetNZ(ulResult);
+		break;
+
+	case 0x01:															//  LSRS Rd, Rm, #imm5 (0 is 32)
+		ucShift = (ulOp >> 6) & 31u;
+		sCore.bC = ucShift ? (pR[ucRn] >> (ucShift - 1u)) & 1u : pR[ucRn] >> 31;
+		pR[ucRd] = ucShift ? pR[ucRn] >> ucShift : 0;
+		Iss_SetNZ(pR[ucRd]);
+		break;
+
+	case 0x02:															//  ASRS Rd, Rm, #imm5 (0 is 32)
+		ucShift = (ulOp >> 6) & 31u;
+		sCore.bC = ucShift ? (pR[ucRn] >> (ucShift - 1u)) & 1u : pR[ucRn] >> 31;
+		pR[ucRd] = (uint32_t)((int32_t)pR[ucRn] >> (ucShift ? ucShift : 31u));
+		Iss_SetNZ(pR[ucRd]);
+		break;
+
+	case 0x03:															//  ADDS / SUBS Rd, Rn, Rm or #imm3
+		ulB = (ulOp & 0x0400u) ? (ulOp >> 6) & 7u : pR[(ulOp >> 6) & 7u];
+		pR[ucRd] = (ulOp & 0x0200u) ? Iss_Add(pR[ucRn], ~ulB, true, true) : Iss_Add(pR[ucRn], ulB, false, true);
+		break;
+
+	case 0x04:															//  MOVS Rd, #imm8
+		pR[(ulOp >> 8) & 7u] = ulOp & 0xffu;
+		Iss_SetNZ(ulOp & 0xffu);
+		break;
+
+	case 0x05:															//  CMP Rn, #imm8
+		(void)Iss_Add(pR[(ulOp >> 8) & 7u], ~(ulOp & 0xffu), true, true);
+		break;
+
+	case 0x06:															//  ADDS Rdn, #imm8
+		pR[(ulOp >> 8) & 7u] = Iss_Add(pR[(ulOp >> 8) & 7u], ulOp & 0xffu, false, true);
+		break;
+
+	case 0x07:															//  SUBS Rdn, #imm8
+		pR[(ulOp >> 8) & 7u] = Iss_Add(pR[(ulOp >> 8) & 7u], ~(ulOp & 0xffu), true, true);
+		break;
+
+	case 0x08:
+		if(!(ulOp & 0x0400u))									//  Data Processing, Rdn and Rm
+		{
+			ulA = pR[ucRd];
+			ulB = pR[ucRn];
+			ucShift = ulB & 0xffu;
+			switch((ulOp >> 6) & 15u)
+			{
+			case 0x0:	pR[ucRd] = ulA & ulB; Iss_SetNZ(pR[ucRd]); break;				//  ANDS
+			case 0x1:	pR[ucRd] = ulA ^ ulB; Iss_SetNZ(pR[ucRd]); break;				//  EORS
+			case 0x2:																													//  LSLS
+				if(ucShift)
+				{
+					sCore.bC = (ucShift <= 32u) ? (uint32_t)(((uint64_t)ulA << ucShift) >> 32) & 1u : 0;
+					ulA = (ucShift < 32u) ? ulA << ucShift : 0;
+				}
+				pR[ucRd] = ulA;
+				Iss_SetNZ(ulA);
+				break;
+			case 0x3:																													//  LSRS
+				if(ucShift)
+				{
+					sCore.bC = (ucShift <= 32u) ? (ulA >> (ucShift - 1u)) & 1u : 0;
+					ulA = (ucShift < 32u) ? ulA >> ucShift : 0;
+				}
+				pR[ucRd] = ulA;
+				Iss_SetNZ(ulA);
+				break;
+			case 0x4:																													//  ASRS
+				if(ucShift)
+				{
+					sCore.bC = (ucShift <= 32u) ? ((int32_t)ulA >> (ucShift - 1u)) & 1 : ulA >> 31;
+					ulA = (uint32_t)((int32_t)ulA >> ((ucShift < 32u) ? ucShift : 31u));
+				}
+				pR[ucRd] = ulA;
+				Iss_SetNZ(ulA);
+				break;
+			case 0x5:	pR[ucRd] = Iss_Add(ulA, ulB, sCore.bC, true); break;				//  ADCS
+			case 0x6:	pR[ucRd] = Iss_Add(ulA, ~ulB, sCore.bC, true); break;			//  SBCS
+			case 0x7:																													//  RORS
+				if(ucShift)
+				{
+					ucShift &= 31u;
+					ulA = ucShift ? (ulA >> ucShift) | (ulA << (32u - ucShift)) : ulA;
+					sCore.bC = ulA >> 31;
+				}
+				pR[ucRd] = ulA;
+				Iss_SetNZ(ulA);
+				break;
+			case 0x8:	Iss_SetNZ(ulA & ulB); break;																//  TST
+			case 0x9:	pR[ucRd] = Iss_Add(0, ~ulB, true, true); break;						//  RSBS Rd, Rn, #0
+			case 0xa:	(void)Iss_Add(ulA, ~ulB, true, true); break;							//  CMP
+			case 0xb:	(void)Iss_Add(ulA, ulB, false, true); break;							//  CMN
+			case 0xc:	pR[ucRd] = ulA | ulB; Iss_SetNZ(pR[ucRd]); break;				//  ORRS
+			case 0xd:																													//  MULS
+				pR[ucRd] = ulA * ulB;
+				Iss_SetNZ(pR[ucRd]);
+				ulCycles = bSmallMultiplier ? 32u : 1u;
+				break;
+			case 0xe:	pR[ucRd] = ulA & ~ulB; Iss_SetNZ(pR[ucRd]); break;			//  BICS
+			default:	pR[ucRd] = ~ulB; Iss_SetNZ(pR[ucRd]); break;						//  MVNS
+			}
+			break;
+		}
+
+		//  High Registers - ADD, CMP, MOV, BX, BLX
+		ucRd = (ulOp & 7u) | ((ulOp >> 4) & 8u);
+		ucRn = (ulOp >> 3) & 15u;
+		ulB = (ucRn == 15u) ? ulPCRead : pR[ucRn];
+		switch((ulOp >> 8) & 3u)
+		{
+		case 0:																							//  ADD Rdn, Rm
+			ulResult = ((ucRd == 15u) ? ulPCRead : pR[ucRd]) + ulB;
+			if(ucRd == 15u)
+			{
+				ulNext = ulResult & ~1u;
+				ulCycles = 2;
+			}
+			else
+			{
+				pR[ucRd] = ulResult;
+			}
+			break;
+		case 1:																							//  CMP Rn, Rm
+			(void)Iss_Add(pR[ucRd], ~ulB, true, true);
+			break;
+		case 2:																							//  MOV Rd, Rm
+			if(ucRd == 15u)
+			{
+				ulNext = ulB & ~1u;
+				ulCycles = 2;
+			}
+			else
+			{
+				pR[ucRd] = ulB;
+			}
+			break;
+		default:																						//  BX / BLX Rm
+			if(!(ulB & 1u))
+			{
+				Iss_Fault("interworking to arm state", ulB);
+			}
+			if(ulOp & 0x0080u)
+			{
+				pR[14] = ulNext | 1u;
+			}
+			ulNext = ulB & ~1u;
+			ulCycles = 2;
+			break;
+		}
+		break;
+
+	case 0x09:															//  LDR Rt, [PC, #imm8]
+		ulAddress = (ulPCRead & ~3u) + (ulOp & 0xffu) * 4u;
+		pR[(ulOp >> 8) & 7u] = Iss_Read(ulAddress, 4);
+		ulCycles = 0;
+		break;
+
+	case 0x0a:
+	case 0x0b:															//  Register Offset
+		ulAddress = pR[ucRn] + pR[(ulOp >> 6) & 7u];
+		ulCycles = 0;
+		switch((ulOp >> 9) & 7u)
+		{
+		case 0:	Iss_Write(ulAddress, pR[ucRd], 4); break;
+		case 1:	Iss_Write(ulAddress, pR[ucRd], 2); break;
+		case 2:	Iss_Write(ulAddress, pR[ucRd], 1); break;
+		case 3:	pR[ucRd] = (uint32_t)(int32_t)(int8_t)Iss_Read(ulAddress, 1); break;
+		case 4:	pR[ucRd] = Iss_Read(ulAddress, 4); break;
+		case 5:	pR[ucRd] = Iss_Read(ulAddress, 2); break;
+		case 6:	pR[ucRd] = Iss_Read(ulAddress, 1); break;
+		default:	pR[ucRd] = (uint32_t)(int32_t)(int16_t)Iss_Read(ulAddress, 2); break;
+		}
+		break;
+
+	case 0x0c:															//  STR Rt, [Rn, #imm5 * 4]
+		ulAddress = pR[ucRn] + ((ulOp >> 6) & 31u) * 4u;
+		Iss_Write(ulAddress, pR[ucRd], 4);
+		ulCycles = 0;
+		break;
+
+	case 0x0d:															//  LDR Rt, [Rn, #imm5 * 4]
+		ulAddress = pR[ucRn] + ((ulOp >> 6) & 31u) * 4u;
+		pR[ucRd] = Iss_Read(ulAddress, 4);
+		ulCycles = 0;
+		break;
+
+	case 0x0e:															//  STRB Rt, [Rn, #imm5]
+		ulAddress = pR[ucRn] + ((ulOp >> 6) & 31u);
+		Iss_Write(ulAddress, pR[ucRd], 1);
+		ulCycles = 0;
+		break;
+
+	case 0x0f:															//  LDRB Rt, [Rn, #imm5]
+		ulAddress = pR[ucRn] + ((ulOp >> 6) & 31u);
+		pR[ucRd] = Iss_Read(ulAddress, 1);
+		ulCycles = 0;
+		break;
+
+	case 0x10:															//  STRH Rt, [Rn, #imm5 * 2]
+		ulAddress = pR[ucRn] + ((ulOp >> 6) & 31u) * 2u;
+		Iss_Write(ulAddress, pR[ucRd], 2);
+		ulCycles = 0;
+		break;
+
+	case 0x11:															//  LDRH Rt, [Rn, #imm5 * 2]
+		ulAddress = pR[ucRn] + ((ulOp >> 6) & 31u) * 2u;
+		pR[ucRd] = Iss_Read(ulAddress, 2);
+		ulCycles = 0;
+		break;
+
+	case 0x12:															//  STR Rt, [SP, #imm8 * 4]
+		ulAddress = pR[13] + (ulOp & 0xffu) * 4u;
+		Iss_Write(ulAddress, pR[(ulOp >> 8) & 7u], 4);
+		ulCycles = 0;
+		break;
+
+	case 0x13:															//  LDR Rt, [SP, #imm8 * 4]
+		ulAddress = pR[13] + (ulOp & 0xffu) * 4u;
+		pR[(ulOp >> 8) & 7u] = Iss_Read(ulAddress, 4);
+		ulCycles = 0;
+		break;
+
+	case 0x14:															//  ADR Rd, #imm8 * 4
+		pR[(ulOp >> 8) & 7u] = (ulPCRead & ~3u) + (ulOp & 0xffu) * 4u;
+		break;
+
+	case 0x15:															//  ADD Rd, SP, #imm8 * 4
+		pR[(ulOp >> 8) & 7u] = pR[13] + (ulOp & 0xffu) * 4u;
+		break;
+
+	case 0x16:
+	case 0x17:															//  Miscellaneous
+		if((ulOp & 0xff00u) == 0xb000u)				//  ADD / SUB SP, #imm7 * 4
+		{
+			pR[13] += (ulOp & 0x0080u) ? -((ulOp & 0x7fu) * 4u) : (ulOp & 0x7fu) * 4u;
+		}
+		else if((ulOp & 0xff00u) == 0xb200u)		//  SXTH, SXTB, UXTH, UXTB
+		{
+			ulA = pR[ucRn];
+			switch((ulOp >> 6) & 3u)
+			{
+			case 0:	pR[ucRd] = (uint32_t)(int32_t)(int16_t)ulA; break;
+			case 1:	pR[ucRd] = (uint32_t)(int32_t)(int8_t)ulA; break;
+			case 2:	pR[ucRd] = ulA & 0xffffu; break;
+			default:	pR[ucRd] = ulA & 0xffu; break;
+			}
+		}
+		else if((ulOp & 0xfe00u) == 0xb400u)		//  PUSH {list, LR}
+		{
+			ulList = (ulOp & 0xffu) | ((ulOp & 0x0100u) << 6);
+			ucCount = (uint8_t)__builtin_popcount(ulList);
+			ulAddress = pR[13] - 4u * ucCount;
+			pR[13] = ulAddress;
+			for(i = 0; i < 15u; i++)
+			{
+				if(ulList & (1u << i))
+				{
+					Iss_Write(ulAddress, pR[i], 4);
+					ulAddress += 4u;
+				}
+			}
+			ulCycles = 1u + ucCount;
+		}
+		else if((ulOp & 0xffefu) == 0xb662u)		//  CPSIE / CPSID i
+		{
+			sCore.ulPrimask = (ulOp >> 4) & 1u;
+		}
+		else if(((ulOp & 0xff00u) == 0xba00u) && (((ulOp >> 6) & 3u) != 2u))	//  REV, REV16, REVSH
+		{
+			ulA = pR[ucRn];
+			switch((ulOp >> 6) & 3u)
+			{
+			case 0:	pR[ucRd] = __builtin_bswap32(ulA); break;
+			case 1:	pR[ucRd] = ((ulA & 0xff00ff00u) >> 8) | ((ulA & 0x00ff00ffu) << 8); break;
+			default:	pR[ucRd] = (uint32_t)(int32_t)(int16_t)__builtin_bswap16((uint16_t)ulA); break;
+			}
+		}
+		else if((ulOp & 0xfe00u) == 0xbc00u)		//  POP {list, PC}
+		{
+			ulList = (ulOp & 0xffu) | ((ulOp & 0x0100u) << 7);
+			ucCount = (uint8_t)__builtin_popcount(ulList);
+			ulAddress = pR[13];
+			pR[13] += 4u * ucCount;
+			for(i = 0; i < 16u; i++)
+			{
+				if(ulList & (1u << i))
+				{
+					ulA = Iss_Read(ulAddress, 4);
+					ulAddress += 4u;
+					if(i == 15u)
+					{
+						if(!(ulA & 1u))
+						{
+							Iss_Fault("interworking to arm state", ulA);
+						}
+						ulNext = ulA & ~1u;
+					}
+					else
+					{
+						pR[i] = ulA;
+					}
+				}
+			}
+			ulCycles = ((ulOp & 0x0100u) ? 3u : 1u) + ucCount;
+		}
+		else if((ulOp & 0xff00u) == 0xbe00u)		//  BKPT
+		{
+			Iss_Fault("breakpoint", ulPC);
+		}
+		else if(((ulOp & 0xff0fu) == 0xbf00u) && ((ulOp & 0x00f0u) <= 0x0040u))
+		{
+			//  NOP, YIELD, WFE, WFI, SEV - Nothing to Wait For Here
+		}
+		else
+		{
+			Iss_Fault("undefined instruction", ulOp);
+		}
+		break;
+
+	case 0x18:															//  STM Rn!, {list}
+	case 0x19:															//  LDM Rn!, {list}
+		ucRn = (ulOp >> 8) & 7u;
+		ulList = ulOp & 0xffu;
+		ucCount = (uint8_t)__builtin_popcount(ulList);
+		ulAddress = pR[ucRn];
+		for(i = 0; i < 8u; i++)
+		{
+			if(ulList & (1u << i))
+			{
+				if(ulOp & 0x0800u)
+				{
+					pR[i] = Iss_Read(ulAddress, 4);
+				}
+				else
+				{
+					Iss_Write(ulAddress, pR[i], 4);
+				}
+				ulAddress += 4u;
+			}
+		}
+		if(!(ulOp & 0x0800u) || !(ulList & (1u << ucRn)))
+		{
+			pR[ucRn] = ulAddress;
+		}
+		ulCycles = 1u + ucCount;
+		break;
+
+	case 0x1a:
+	case 0x1b:															//  B<cond>, UDF, SVC
+		if(((ulOp >> 8) & 15u) >= 14u)
+		{
+			Iss_Fault(((ulOp >> 8) & 15u) == 14u ? "undefined instruction" : "svc", ulOp);
+		}
+		else if(Iss_Condition((ulOp >> 8) & 15u))
+		{
+			ulNext = ulPCRead + (uint32_t)((int32_t)(int8_t)(ulOp & 0xffu) * 2);
+			ulCycles = 2;
+		}
+		break;
+
+	case 0x1c:															//  B
+		lOffset = (int32_t)((ulOp & 0x7ffu) << 21) >> 20;
+		ulNext = ulPCRead + (uint32_t)lOffset;
+		ulCycles = 2;
+		break;
+
+	case 0x1e:															//  32 Bit - BL, MSR, MRS, DSB, DMB, ISB
+		ulOp2 = Iss_Fetch(ulPC + 2u);
+		ulNext = ulPC + 4u;
+		ulSequential = ulNext;
+		if((ulOp2 & 0xd000u) == 0xd000u)			//  BL
+		{
+			uint32_t ulS = (ulOp >> 10) & 1u;
+			uint32_t ulI1 = !(((ulOp2 >> 13) & 1u) ^ ulS);
+			uint32_t ulI2 = !(((ulOp2 >> 11) & 1u) ^ ulS);
+
+			lOffset = (int32_t)((ulS << 31) | (ulI1 << 30) | (ulI2 << 29) | ((ulOp & 0x3ffu) << 19) |
+													((ulOp2 & 0x7ffu) << 8)) >> 7;
+			pR[14] = ulNext | 1u;
+			ulNext += (uint32_t)lOffset;
+			ulCycles = 3;
+		}
+		else if(((ulOp & 0xfff0u) == 0xf380u) && ((ulOp2 & 0xff00u) == 0x8800u))		//  MSR
+		{
+			if((ulOp2 & 0xffu) == 16u)
+			{
+				sCore.ulPrimask = pR[ulOp & 15u] & 1u;
+			}
+			else if((ulOp2 & 0xffu) == 8u)
+			{
+				pR[13] = pR[ulOp & 15u] & ~3u;
+			}
+			ulCycles = 3;
+		}
+		else if((ulOp == 0xf3efu) && ((ulOp2 & 0xf000u) == 0x8000u))								//  MRS
+		{
+			switch(ulOp2 & 0xffu)
+			{
+			case 8:		ulResult = pR[13]; break;
+			case 16:	ulResult = sCore.ulPrimask; break;
+			default:
+				ulResult = ((uint32_t)sCore.bN << 31) | ((uint32_t)sCore.bZ << 30) | ((uint32_t)sCore.bC << 29) |
+									 ((uint32_t)sCore.bV << 28);
+				break;
+			}
+			pR[(ulOp2 >> 8) & 15u] = ulResult;
+			ulCycles = 3;
+		}
+		else if((ulOp == 0xf3bfu) && ((ulOp2 & 0xffc0u) == 0x8f40u))								//  DSB, DMB, ISB
+		{
+			ulCycles = 3;
+		}
+		else
+		{
+			Iss_Fault("undefined instruction", (ulOp << 16) | ulOp2);
+		}
+		break;
+
+	default:																//  0x1d, 0x1f - 32 Bit Thumb-2, Not in ARMv6-M
+		Iss_Fault("undefined instruction", ulOp);
+		break;
+	}
+
+	//  Loads and Stores - 2 Cycles, 1 on the IOPORT, Plus the Flash Wait States
+	if(ulCycles == 0)
+	{
+		IssRegion *pRegion = Iss_Region(ulAddress, 1);
+
+		ulCycles = pRegion ? pRegion->ucCycles + (pRegion->bFlash ? ucWaitStates : 0u) : 2u;
+	}
+	if(ulNext != ulSequential)
+	{
+		sCore.ulFetchWord = 0xffffffffu;
+	}
+	ulCycles += sCore.ulFetchCycles;
+	sCore.ulFetchCycles = 0;
+	pR[15] = ulNext;
+	sCore.ullCycles += ulCycles;
+	sCore.ullInstructions ++;
+	Iss_SysTick(ulCycles);
+}
+
+/**
+  * @brief  Read an Earlier -c Run's Cycles per Call
+  * @param  pPath - CSV
+  * @retval false if it Can Not be Read (Reported)
+  */
+static bool Iss_Reference(const char *pPath)
+{
+	char cLine[256];
+	char *pComma;
+	FILE *pFile;
+	uint32_t i;
+
+	if((pFile = fopen(pPath, "r")) == NULL)
+	{
+		fprintf(stderr, "%s: can not read\n", pPath);
+		return false;
+	}
+	while(fgets(cLine, sizeof(cLine), pFile))
+	{
+		if(((pComma = strchr(cLine, ',')) == NULL) || ((pComma = strchr(pComma + 1, ',')) == NULL))
+		{
+			continue;
+		}
+		*strchr(cLine, ',') = '\0';
+		for(i = 0; i < ulResults; i++)
+		{
+			if(strcmp(sResult[i].cName, cLine) == 0)
+			{
+				sResult[i].dReference = strtod(pComma + 1, NULL);
+			}
+		}
+	}
+	fclose(pFile);
+	return true;
+}
+
+/**
+  * @brief  Write the Results - a Table, or JSON When a Label is Given
+  * @param  pFile - Output
+  * @param  pLabel - JSON Run Label, NULL for the Table
+  * @param  dTolerance - Allowed Growth Over the Reference, Percent
+  * @retval None
+  */
+static void Iss_Report(FILE *pFile, const char *pLabel, double dTolerance)
+{
+	const IssResult *pResult;
+	double dPer;
+	uint32_t i;
+
+	if(pLabel == NULL)
+	{
+		fprintf(pFile, "Cortex-M0+, %s multiplier, %u flash wait states\n", bSmallMultiplier ? "32 cycle" : "1 cycle",
+						ucWaitStates);
+		fprintf(pFile, "%-32s %6s %12s %10s %10s %11s %10s\n", "case", "calls", "cycles/call", "min", "max", "instr/call",
+						"reference");
+	}
+	else
+	{
+		fprintf(pFile, "{\n  \"label\": \"%s\",\n  \"config\": { \"small_multiplier\": %s, \"wait_states\": %u, "
+									 "\"tolerance_percent\": %g },\n  \"cases\": [",
+						pLabel, bSmallMultiplier ? "true" : "false", ucWaitStates, dTolerance);
+	}
+	for(i = 0; i < ulResults; i++)
+	{
+		pResult = &sResult[i];
+		dPer = pResult->ulCalls ? 1.0 / pResult->ulCalls : 0.0;
+		if(pLabel == NULL)
+		{
+			fprintf(pFile, "%-32s %6u %12.2f %10llu %10llu %11.2f", pResult->cName, (unsigned)pResult->ulCalls,
+							pResult->ullCycles * dPer, pResult->ulCalls ? (unsigned long long)pResult->ullMin : 0ull,
+							(unsigned long long)pResult->ullMax, pResult->ullInstructions * dPer);
+			if(pResult->dReference > 0)
+			{
+				fprintf(pFile, " %10.2f", pResult->dReference);
+			}
+			fprintf(pFile, "%s\n", pResult->bFault ? "  FAULT" : pResult->bOver ? "  OVER" : "");
+		}
+		else
+		{
+			fprintf(pFile, "%s\n    { \"name\": \"%s\", \"calls\": %u, \"cycles_per_call\": %.2f, \"min\": %llu, \"max\": %llu, "
+										 "\"instructions_per_call\": %.2f, \"reference\": %.2f, \"fault\": %s, \"over\": %s }",
+							i ? "," : "", pResult->cName, (unsigned)pResult->ulCalls, pResult->ullCycles * dPer,
+							pResult->ulCalls ? (unsigned long long)pResult->ullMin : 0ull, (unsigned long long)pResult->ullMax,
+							pResult->ullInstructions * dPer, pResult->dReference, pResult->bFault ? "true" : "false",
+							pResult->bOver ? "true" : "false");
+		}
+	}
+	if(pLabel)
+	{
+		fprintf(pFile, "\n  ]\n}\n");
+	}
+}
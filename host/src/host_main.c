@@ -0,0 +1,83 @@
+/**
+  ******************************************************************************
+  * 											Next Generation CO2 Sensor
+  * 											Host Build - Sensor Simulator
+  *
+  *   nextgen_host [-t seconds] [-f flash.bin] [-n nadir] [-z zenith]
+  *
+  *   Boots the Firmware on the Simulated Peripherals, Runs it and Prints the
+  *   Measurement Registers Once per Simulated Second. -n and -z Set the Gas
+  *   Signal Counts With the Lamp Off and On, Default HOST_ADC_NADIR (1000)
+  *   and HOST_ADC_ZENITH (3000) so norm_sig_avg is Live Without Them. The
+  *   Registers Read 0 Until the First Measurement Cycle Ends (Second 6 at the
+  *   Default Settings), Hence the 10 s Default for -t. With -f the Flash
+  *   Array is Loaded From and Saved Back to the File, so Parameters and the
+  *   ABC Ring Persist From Run to Run.
+  ******************************************************************************
+  */
+
+//  Includes
+#include  "main.h"
+#include  "host.h"
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+
+int main(int argc, char **argv)
+{
+	const char *pFlash = NULL;
+	uint32_t ulSeconds = 10;
+	uint32_t i;
+	int iArg;
+
+	Host_Init();
+	for(iArg = 1; iArg + 1 < argc; iArg += 2)
+	{
+		if(strcmp(argv[iArg], "-t") == 0)
+		{
+			ulSeconds = (uint32_t)strtoul(argv[iArg + 1], NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-f") == 0)
+		{
+			pFlash = argv[iArg + 1];
+		}
+		else if(strcmp(argv[iArg], "-n") == 0)
+		{
+			sHost.uiAdc[ADC_CHANNEL_GAS_SIGNAL] = (uint16_t)strtoul(argv[iArg + 1], NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-z") == 0)
+		{
+			sHost.uiAdcLampOn = (uint16_t)strtoul(argv[iArg + 1], NULL, 0);
+		}
+		else
+		{
+			break;
+		}
+	}
+	if(iArg < argc)
+	{
+		fprintf(stderr, "usage: %s [-t seconds (10)] [-f flash.bin] [-n nadir (%u)] [-z zenith (%u)]\n", argv[0],
+						(unsigned)HOST_ADC_NADIR, (unsigned)HOST_ADC_ZENITH);
+		return EXIT_FAILURE;
+	}
+	if(pFlash)
+	{
+		Host_FlashLoad(pFlash);
+	}
+
+	printf("%8s %8s %6s %6s %6s %10s %8s\n", "second", "up_time", "nadir", "zenith", "ppm", "norm_avg", "erases");
+	for(i = 1; i <= ulSeconds; i++)
+	{
+		Host_Run(1000);
+		printf("%8u %8u %6u %6u %6u %10.5f %8u\n", (unsigned)i, (unsigned)sIRegs.up_time, sIRegs.nadir, sIRegs.zenith,
+					 sIRegs.gas_ppm, (double)sIRegs.norm_sig_avg, (unsigned)sHost.ulFlashErases);
+	}
+
+	if(pFlash && !Host_FlashSave(pFlash))
+	{
+		fprintf(stderr, "%s: can not write %s\n", argv[0], pFlash);
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
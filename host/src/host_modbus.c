@@ -0,0 +1,665 @@
+/**
+  ******************************************************************************
+  * 											Next Generation CO2 Sensor
+  * 											Host Build - Modbus RTU Bus Benchmark
+  *
+  *   nextgen_modbus [-t seconds] [-b baud] [-m fc:weight,...] [-q registers]
+  *                  [-g gap_us] [-s slaves] [-p polls_per_s] [-d delay_us]
+  *                  [-w timeout_ms] [-k cycles_per_ns] [-r seed]
+  *                  [-o results.json] [-l label]
+  *
+  *   Plays the Bus Master Against the Firmware's USART on the Simulated Line:
+  *   Requests are Sent at the Baud Rate and Inter Character Gap Given, With
+  *   the Function Code Mix Given (FC03 and FC04 Read -q Registers, FC05 Sets a
+  *   Coil, FC16 Writes One Register). With -s Above 1 the Bus Has Other
+  *   Slaves Too: They are Polled in Turn and Answer After t3.5 Plus -d, so the
+  *   Sensor Sees (and Mutes Through) Their Traffic. -p 0 Polls Back to Back,
+  *   Which Gives the Highest Rate the Bus Sustains.
+  *
+  *   Latencies are Simulated Line Time, With the Core Taking no Time. The
+  *   Processing Cost of a Frame is the Host Time the Firmware Ran From the
+  *   Request to the Response, Scaled by -k (M0+ Cycles per Host nS) - an
+  *   Estimate Only, Good for Comparing Commits on One Machine.
+  ******************************************************************************
+  */
+
+//  Includes
+#include  "main.h"
+#include  "host.h"
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+
+#define BENCH_FC_COUNT					4u
+#define BENCH_SETTLE_MS					100u			//  Boot Before the First Poll
+#define BENCH_EXCEPTION_BYTES		5u
+#define BENCH_WRITE_REGISTER		4001u			//  mfg_data - Not Used by the Firmware
+#define BENCH_COIL							1000u
+#define BENCH_PERCENTILES				4u
+
+enum BENCH_STATE
+{
+	BENCH_PAUSE = 0,										//  Next Poll Due at ullNextNs
+	BENCH_SENSOR,												//  Waiting on the Sensor's Response
+	BENCH_OTHER													//  Another Slave's Exchange on the Line
+};
+
+//  Samples per Function Code
+typedef struct
+{
+	uint8_t ucFC;
+	uint32_t ulWeight;
+	uint32_t ulRequests;
+	uint32_t ulResponses;
+	uint32_t ulTimeouts;
+	uint32_t ulCrcErrors;
+	uint32_t ulExceptions;
+	uint32_t ulSamples;
+	uint32_t ulSize;
+	uint64_t *pTurnNs;									//  Request End to Response Start
+	uint64_t *pTransNs;									//  Request Start to Response End
+	uint64_t *pCpuNs;										//  Host Time the Firmware Ran
+	double dCoreUs;											//  Sum of Estimated Core Time
+} BenchFC;
+
+static BenchFC sBenchFC[BENCH_FC_COUNT] =
+{
+	{ 3, 40 }, { 4, 40 }, { 5, 10 }, { 16, 10 }
+};
+
+static const double dBenchPercentile[BENCH_PERCENTILES] = { 0.50, 0.90, 0.99, 1.00 };
+static const char * const pBenchPercentile[BENCH_PERCENTILES] = { "p50", "p90", "p99", "max" };
+
+//  Options
+static uint32_t ulBaud = 19200;
+static uint16_t uiRegisters = 8;
+static uint32_t ulGapNs = 0;
+static uint16_t uiSlaves = 1;
+static uint32_t ulPollHz = 0;
+static uint32_t ulDelayNs = 1000000;
+static uint32_t ulTimeoutNs = 100000000;
+static double dCyclesPerNs = 10.0;
+static uint32_t ulSeed = 1;
+static uint32_t ulRandom;
+
+//  Master
+static uint8_t ucState = BENCH_PAUSE;
+static uint64_t ullNextNs;									//  Next Poll May Start
+static uint64_t ullScheduleNs;							//  Next Poll Due by -p
+static uint64_t ullT35Ns;
+static uint64_t ullCharNs;
+static uint16_t uiTurn = 0;									//  Slave Polled Next, 0 = the Sensor
+static BenchFC *pPoll;
+static uint64_t ullReqStartNs, ullReqEndNs, ullRespStartNs;
+static uint64_t ullCpuStartNs;
+static uint8_t ucResp[BUFFER_SIZE];
+static uint16_t uiRespLength, uiRespExpect;
+static uint16_t uiWriteValue = 0;
+
+//  Bus Totals
+static uint32_t ulTransactions = 0;
+static uint32_t ulLatePolls = 0;
+static uint64_t ullBusyNs = 0;
+
+static void Bench_Tick(void);
+static void Bench_Tx(uint8_t, uint64_t);
+static void Bench_Poll(uint64_t);
+static uint16_t Bench_Request(uint8_t *, uint8_t, uint8_t);
+static uint16_t Bench_Response(uint8_t *, uint8_t, uint8_t);
+static uint16_t Bench_Expect(uint8_t);
+static void Bench_Done(uint64_t);
+static void Bench_Record(uint64_t, uint64_t, uint64_t);
+static uint32_t Bench_Random(void);
+static bool Bench_Mix(const char *);
+static int Bench_Compare(const void *, const void *);
+static uint64_t Bench_Percentile(uint64_t *, uint32_t, double);
+static void Bench_Report(FILE *, const char *, const char *, uint32_t);
+
+int main(int argc, char **argv)
+{
+	const char *pJson = NULL;
+	const char *pLabel = "";
+	const char *pMix = "3:40,4:40,5:10,16:10";
+	FILE *pFile;
+	uint32_t ulSeconds = 10;
+	int iArg;
+
+	for(iArg = 1; iArg + 1 < argc; iArg += 2)
+	{
+		const char *pValue = argv[iArg + 1];
+
+		if(strcmp(argv[iArg], "-t") == 0)
+		{
+			ulSeconds = (uint32_t)strtoul(pValue, NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-b") == 0)
+		{
+			ulBaud = (uint32_t)strtoul(pValue, NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-m") == 0)
+		{
+			pMix = pValue;
+		}
+		else if(strcmp(argv[iArg], "-q") == 0)
+		{
+			uiRegisters = (uint16_t)strtoul(pValue, NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-g") == 0)
+		{
+			ulGapNs = (uint32_t)strtoul(pValue, NULL, 0) * HOST_US_PER_MS;
+		}
+		else if(strcmp(argv[iArg], "-s") == 0)
+		{
+			uiSlaves = (uint16_t)strtoul(pValue, NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-p") == 0)
+		{
+			ulPollHz = (uint32_t)strtoul(pValue, NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-d") == 0)
+		{
+			ulDelayNs = (uint32_t)strtoul(pValue, NULL, 0) * HOST_US_PER_MS;
+		}
+		else if(strcmp(argv[iArg], "-w") == 0)
+		{
+			ulTimeoutNs = (uint32_t)strtoul(pValue, NULL, 0) * HOST_NS_PER_MS;
+		}
+		else if(strcmp(argv[iArg], "-k") == 0)
+		{
+			dCyclesPerNs = strtod(pValue, NULL);
+		}
+		else if(strcmp(argv[iArg], "-r") == 0)
+		{
+			ulSeed = (uint32_t)strtoul(pValue, NULL, 0) | 1u;
+		}
+		else if(strcmp(argv[iArg], "-o") == 0)
+		{
+			pJson = pValue;
+		}
+		else if(strcmp(argv[iArg], "-l") == 0)
+		{
+			pLabel = pValue;
+		}
+		else
+		{
+			break;
+		}
+	}
+	if((iArg < argc) || !Bench_Mix(pMix) || (uiSlaves == 0) || (uiSlaves > 247u - DEFAULT_SLAVE_ADDRESS) ||
+		 (uiRegisters == 0) || (uiRegisters * 2u + BENCH_EXCEPTION_BYTES > BUFFER_SIZE))
+	{
+		fprintf(stderr, "usage: %s [-t seconds] [-b baud] [-m fc:weight,...] [-q registers] [-g gap_us]\n"
+										"       [-s slaves] [-p polls_per_s] [-d delay_us] [-w timeout_ms] [-k cycles_per_ns]\n"
+										"       [-r seed] [-o results.json] [-l label]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	ulRandom = ulSeed;
+
+	//  Boot, Then Bring the USART up at the Rate Under Test as a Reset With
+	//  That Rate Stored Would (Holding Register Values Below 1200 are Hundreds)
+	Host_Init();
+	Host_Run(1);
+	sHRegs.baud_rate = (uint16_t)((ulBaud > 0xffffu) ? ulBaud / 100u : ulBaud);
+	if(USART1_GetBaudRate() != ulBaud)
+	{
+		fprintf(stderr, "%s: %u baud not supported\n", argv[0], (unsigned)ulBaud);
+		return EXIT_FAILURE;
+	}
+	LL_USART_Disable(USART1);
+	USART1_Init();
+	ullCharNs = Host_UartCharNs();
+	ullT35Ns = (ulBaud > MODBUS_FIXED_T35_BAUD) ? MODBUS_FIXED_T35_US * (uint64_t)HOST_US_PER_MS : (ullCharNs * 7u + 1u) / 2u;
+
+	sHost.pTick = Bench_Tick;
+	sHost.pUartTx = Bench_Tx;
+	ullNextNs = ullScheduleNs = BENCH_SETTLE_MS * (uint64_t)HOST_NS_PER_MS;
+	Host_Run(BENCH_SETTLE_MS - 1u + ulSeconds * 1000u);
+
+	Bench_Report(stdout, NULL, pMix, ulSeconds);
+	if(pJson)
+	{
+		if((pFile = fopen(pJson, "w")) == NULL)
+		{
+			fprintf(stderr, "%s: can not write %s\n", argv[0], pJson);
+			return EXIT_FAILURE;
+		}
+		Bench_Report(pFile, pLabel, pMix, ulSeconds);
+		fclose(pFile);
+	}
+	return EXIT_SUCCESS;
+}
+
+/**
+  * @brief  Every mS: Start the Next Poll Once it is Due (Queued up to a mS
+  *         Ahead so it Starts on Time), or Give up on a Silent Sensor
+  * @param  None
+  * @retval None
+  */
+static void Bench_Tick(void)
+{
+	uint64_t ullAhead = sHost.ullNs + HOST_NS_PER_MS;
+
+	if((ucState == BENCH_SENSOR) && (sHost.ullNs > ullReqEndNs + ulTimeoutNs))
+	{
+		pPoll->ulTimeouts ++;
+		ucState = BENCH_PAUSE;
+		ullNextNs = sHost.ullNs;
+	}
+	if((ucState != BENCH_SENSOR) && (ullNextNs <= ullAhead) && (ullScheduleNs <= ullAhead))
+	{
+		Bench_Poll((ullNextNs > ullScheduleNs) ? ullNextNs : ullScheduleNs);
+	}
+}
+
+/**
+  * @brief  A Character From the Sensor - Collect the Response Until the
+  *         Length its Function Code Calls for
+  * @param  ucData - Character
+  * @param  ullEndNs - When its Stop Bit Ended
+  * @retval None
+  */
+static void Bench_Tx(uint8_t ucData, uint64_t ullEndNs)
+{
+	if((ucState != BENCH_SENSOR) || (uiRespLength >= BUFFER_SIZE))
+	{
+		return;
+	}
+	if(uiRespLength == 0)
+	{
+		ullRespStartNs = ullEndNs - ullCharNs;
+	}
+	ucResp[uiRespLength ++] = ucData;
+	if((uiRespLength == 2) && (ucData & 0x80))
+	{
+		uiRespExpect = BENCH_EXCEPTION_BYTES;
+	}
+	if(uiRespLength == uiRespExpect)
+	{
+		Bench_Done(ullEndNs);
+	}
+}
+
+/**
+  * @brief  Send the Next Request: to the Sensor, or to Another Slave Along
+  *         With its Response
+  * @param  ullStartNs - Earliest Start
+  * @retval None
+  */
+static void Bench_Poll(uint64_t ullStartNs)
+{
+	uint8_t ucFrame[BUFFER_SIZE];
+	uint32_t ulPick = Bench_Random() % (sBenchFC[0].ulWeight + sBenchFC[1].ulWeight + sBenchFC[2].ulWeight + sBenchFC[3].ulWeight);
+	uint16_t uiLength;
+	uint8_t ucAddress, i;
+
+	for(i = 0; ulPick >= sBenchFC[i].ulWeight; i++)
+	{
+		ulPick -= sBenchFC[i].ulWeight;
+	}
+	pPoll = &sBenchFC[i];
+	if(ulPollHz && (ullStartNs > ullScheduleNs))
+	{
+		ulLatePolls ++;												//  Bus Still Busy When the Poll Was Due
+	}
+	ullScheduleNs = ulPollHz ? ullScheduleNs + HOST_NS_PER_S / ulPollHz : 0;
+
+	ucAddress = (uiTurn == 0) ? sHRegs.slave_address : (uint8_t)(DEFAULT_SLAVE_ADDRESS + uiTurn);
+	uiTurn = (uiTurn + 1u) % uiSlaves;
+	uiLength = Bench_Request(ucFrame, ucAddress, pPoll->ucFC);
+	ullReqEndNs = Host_UartSend(ucFrame, uiLength, ullStartNs, ulGapNs);
+	ullReqStartNs = ullReqEndNs - uiLength * ullCharNs - (uiLength - 1u) * (uint64_t)ulGapNs;
+	ullBusyNs += uiLength * ullCharNs;
+
+	if(ucAddress == sHRegs.slave_address)
+	{
+		pPoll->ulRequests ++;
+		ucState = BENCH_SENSOR;
+		uiRespLength = 0;
+		uiRespExpect = Bench_Expect(pPoll->ucFC);
+		ullCpuStartNs = sHost.ullCpuNs;
+	}
+	else
+	{
+		uiLength = Bench_Response(ucFrame, ucAddress, pPoll->ucFC);
+		ullNextNs = Host_UartSend(ucFrame, uiLength, ullReqEndNs + ullT35Ns + ulDelayNs, 0) + ullT35Ns;
+		ullBusyNs += uiLength * ullCharNs;
+		ulTransactions ++;
+		ucState = BENCH_OTHER;
+	}
+}
+
+/**
+  * @brief  Build a Request
+  * @param  pFrame - Frame Out
+  * @param  ucAddress - Slave
+  * @param  ucFC - Function Code
+  * @retval Length, CRC Included
+  */
+static uint16_t Bench_Request(uint8_t *pFrame, uint8_t ucAddress, uint8_t ucFC)
+{
+	uint16_t uiLength = 6, uiCRC;
+
+	pFrame[0] = ucAddress;
+	pFrame[1] = ucFC;
+	switch(ucFC)
+	{
+	case 3:
+	case 4:
+		pFrame[2] = (uint8_t)(((ucFC == 3) ? HOLDING_REGISTERS_OFFSET : INPUT_REGISTERS_OFFSET) >> 8);
+		pFrame[3] = (uint8_t)((ucFC == 3) ? HOLDING_REGISTERS_OFFSET : INPUT_REGISTERS_OFFSET);
+		pFrame[4] = 0;
+		pFrame[5] = (uint8_t)uiRegisters;
+		break;
+	case 5:
+		pFrame[2] = (uint8_t)(BENCH_COIL >> 8);
+		pFrame[3] = (uint8_t)BENCH_COIL;
+		pFrame[4] = 0xff;
+		pFrame[5] = 0x00;
+		break;
+	default:
+		pFrame[2] = (uint8_t)(BENCH_WRITE_REGISTER >> 8);
+		pFrame[3] = (uint8_t)BENCH_WRITE_REGISTER;
+		pFrame[4] = 0;
+		pFrame[5] = 1;
+		pFrame[uiLength++] = 2;
+		pFrame[uiLength++] = (uint8_t)(uiWriteValue >> 8);
+		pFrame[uiLength++] = (uint8_t)uiWriteValue;
+		uiWriteValue ^= 1u;
+	}
+	uiCRC = CRC_Calc(pFrame, uiLength);
+	pFrame[uiLength++] = (uint8_t)uiCRC;					//  Low Byte First
+	pFrame[uiLength++] = (uint8_t)(uiCRC >> 8);
+	return uiLength;
+}
+
+/**
+  * @brief  Build Another Slave's Response - Only its Length and Framing
+  *         Matter to the Sensor
+  * @param  pFrame - Frame Out
+  * @param  ucAddress - Slave
+  * @param  ucFC - Function Code
+  * @retval Length, CRC Included
+  */
+static uint16_t Bench_Response(uint8_t *pFrame, uint8_t ucAddress, uint8_t ucFC)
+{
+	uint16_t uiLength = Bench_Expect(ucFC) - 2u;
+	uint16_t uiCRC, i;
+
+	pFrame[0] = ucAddress;
+	pFrame[1] = ucFC;
+	for(i = 2; i < uiLength; i++)
+	{
+		pFrame[i] = (uint8_t)Bench_Random();
+	}
+	uiCRC = CRC_Calc(pFrame, uiLength);
+	pFrame[uiLength++] = (uint8_t)uiCRC;
+	pFrame[uiLength++] = (uint8_t)(uiCRC >> 8);
+	return uiLength;
+}
+
+/**
+  * @brief  Normal Response Length
+  * @param  ucFC - Function Code
+  * @retval Length, CRC Included
+  */
+static uint16_t Bench_Expect(uint8_t ucFC)
+{
+	return ((ucFC == 3) || (ucFC == 4)) ? 5u + 2u * uiRegisters : 8u;
+}
+
+/**
+  * @brief  The Sensor's Response is Complete: Check it, Record the Timing and
+  *         Let the Next Poll Follow After t3.5
+  * @param  ullEndNs - Last Stop Bit
+  * @retval None
+  */
+static void Bench_Done(uint64_t ullEndNs)
+{
+	ullBusyNs += uiRespLength * ullCharNs;
+	ulTransactions ++;
+	ucState = BENCH_PAUSE;
+	ullNextNs = ullEndNs + ullT35Ns;
+
+	if(CRC_Calc(ucResp, uiRespLength) != 0)
+	{
+		pPoll->ulCrcErrors ++;
+		return;
+	}
+	if(ucResp[1] & 0x80)
+	{
+		pPoll->ulExceptions ++;
+	}
+	pPoll->ulResponses ++;
+	pPoll->dCoreUs += (sHost.ullCpuNs - ullCpuStartNs) * dCyclesPerNs * 1e6 / SystemCoreClock;
+	Bench_Record(ullRespStartNs - ullReqEndNs, ullEndNs - ullReqStartNs, sHost.ullCpuNs - ullCpuStartNs);
+}
+
+/**
+  * @brief  Keep One Transaction's Timings
+  * @param  ullTurnNs - Request End to Response Start
+  * @param  ullTransNs - Request Start to Response End
+  * @param  ullCpuNs - Host Time the Firmware Ran
+  * @retval None
+  */
+static void Bench_Record(uint64_t ullTurnNs, uint64_t ullTransNs, uint64_t ullCpuNs)
+{
+	if(pPoll->ulSamples == pPoll->ulSize)
+	{
+		pPoll->ulSize = pPoll->ulSize ? 2u * pPoll->ulSize : 1024u;
+		pPoll->pTurnNs = (uint64_t*)realloc(pPoll->pTurnNs, pPoll->ulSize * sizeof(uint64_t));
+		pPoll->pTransNs = (uint64_t*)realloc(pPoll->pTransNs, pPoll->ulSize * sizeof(uint64_t));
+		pPoll->pCpuNs = (uint64_t*)realloc(pPoll->pCpuNs, pPoll->ulSize * sizeof(uint64_t));
+		if(!pPoll->pTurnNs || !pPoll->pTransNs || !pPoll->pCpuNs)
+		{
+			fprintf(stderr, "out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	pPoll->pTurnNs[pPoll->ulSamples] = ullTurnNs;
+	pPoll->pTransNs[pPoll->ulSamples] = ullTransNs;
+	pPoll->pCpuNs[pPoll->ulSamples] = ullCpuNs;
+	pPoll->ulSamples ++;
+}
+
+/**
+  * @brief  xorshift32 - Same Sequence for the Same Seed
+  * @param  None
+  * @retval Next Value
+  */
+static uint32_t Bench_Random(void)
+{
+	ulRandom ^= ulRandom << 13;
+	ulRandom ^= ulRandom >> 17;
+	ulRandom ^= ulRandom << 5;
+	return ulRandom;
+}
+
+/**
+  * @brief  Parse a Function Code Mix, e.g. "3:40,4:40,5:10,16:10". Codes Left
+  *         Out Get no Polls.
+  * @param  pMix - fc:weight List
+  * @retval false if Malformed or all Weights are 0
+  */
+static bool Bench_Mix(const char *pMix)
+{
+	char *pEnd;
+	uint32_t ulFC, ulTotal = 0;
+	uint8_t i;
+
+	for(i = 0; i < BENCH_FC_COUNT; i++)
+	{
+		sBenchFC[i].ulWeight = 0;
+	}
+	while(*pMix)
+	{
+		ulFC = (uint32_t)strtoul(pMix, &pEnd, 10);
+		if(*pEnd != ':')
+		{
+			return false;
+		}
+		for(i = 0; (i < BENCH_FC_COUNT) && (sBenchFC[i].ucFC != ulFC); i++)
+		{
+		}
+		if(i == BENCH_FC_COUNT)
+		{
+			return false;
+		}
+		sBenchFC[i].ulWeight = (uint32_t)strtoul(pEnd + 1, &pEnd, 10);
+		ulTotal += sBenchFC[i].ulWeight;
+		if(*pEnd == ',')
+		{
+			pEnd ++;
+		}
+		else if(*pEnd != '\0')
+		{
+			return false;
+		}
+		pMix = pEnd;
+	}
+	return ulTotal != 0;
+}
+
+static int Bench_Compare(const void *pA, const void *pB)
+{
+	uint64_t ullA = *(const uint64_t*)pA, ullB = *(const uint64_t*)pB;
+
+	return (ullA > ullB) - (ullA < ullB);
+}
+
+/**
+  * @brief  Nearest Rank Percentile
+  * @param  pSamples - Sorted Samples
+  * @param  ulCount - Number of Samples
+  * @param  dFraction - 0 to 1
+  * @retval Sample, 0 if None
+  */
+static uint64_t Bench_Percentile(uint64_t *pSamples, uint32_t ulCount, double dFraction)
+{
+	uint32_t ulRank = (uint32_t)(dFraction * ulCount + 0.999999);
+
+	if(ulCount == 0)
+	{
+		return 0;
+	}
+	return pSamples[(ulRank == 0) ? 0 : ulRank - 1u];
+}
+
+/**
+  * @brief  Write the Results - a Table, or JSON When a Label is Given
+  * @param  pFile - Output
+  * @param  pLabel - JSON Run Label, NULL for the Table
+  * @param  pMix - Function Code Mix as Given
+  * @param  ulSeconds - Measured Time
+  * @retval None
+  */
+static void Bench_Report(FILE *pFile, const char *pLabel, const char *pMix, uint32_t ulSeconds)
+{
+	BenchFC *pFC;
+	uint64_t ullCpuSum;
+	uint32_t ulRequests = 0, ulResponses = 0, ulTimeouts = 0, ulCrcErrors = 0, ulExceptions = 0;
+	uint32_t ulPolled = 0, j, n;
+	double dTransMean = 0;
+	uint8_t i, k;
+
+	for(i = 0; i < BENCH_FC_COUNT; i++)
+	{
+		pFC = &sBenchFC[i];
+		qsort(pFC->pTurnNs, pFC->ulSamples, sizeof(uint64_t), Bench_Compare);
+		qsort(pFC->pTransNs, pFC->ulSamples, sizeof(uint64_t), Bench_Compare);
+		qsort(pFC->pCpuNs, pFC->ulSamples, sizeof(uint64_t), Bench_Compare);
+		for(j = 0; j < pFC->ulSamples; j++)
+		{
+			dTransMean += (double)pFC->pTransNs[j];
+		}
+		ulPolled += pFC->ulSamples;
+		ulRequests += pFC->ulRequests;
+		ulResponses += pFC->ulResponses;
+		ulTimeouts += pFC->ulTimeouts;
+		ulCrcErrors += pFC->ulCrcErrors;
+		ulExceptions += pFC->ulExceptions;
+	}
+	dTransMean = ulPolled ? dTransMean / ulPolled : 0;
+
+	if(pLabel == NULL)
+	{
+		fprintf(pFile, "%u baud, %u slave(s), mix %s, %u s: %.1f transactions/s, sensor %.1f polls/s (max %.1f), bus %.1f%% busy\n",
+					 (unsigned)ulBaud, (unsigned)uiSlaves, pMix, (unsigned)ulSeconds, (double)ulTransactions / ulSeconds,
+					 (double)ulResponses / ulSeconds, ulPolled ? 1e9 / (dTransMean + ullT35Ns) : 0.0,
+					 100.0 * ullBusyNs / ((double)ulSeconds * HOST_NS_PER_S));
+		fprintf(pFile, "requests %u, responses %u, timeouts %u, crc errors %u, exceptions %u, overruns %u, flash erases %u\n",
+					 (unsigned)ulRequests, (unsigned)ulResponses, (unsigned)ulTimeouts, (unsigned)ulCrcErrors,
+					 (unsigned)ulExceptions, (unsigned)sHost.ulUartOverruns, (unsigned)sHost.ulFlashErases);
+		fprintf(pFile, "%4s %8s %10s %10s %10s %10s %10s %10s %12s\n", "fc", "count", "turn p50", "turn p99", "turn max",
+					 "trans p50", "trans p99", "host ns", "est cycles");
+		for(i = 0; i < BENCH_FC_COUNT; i++)
+		{
+			pFC = &sBenchFC[i];
+			if(pFC->ulRequests == 0)
+			{
+				continue;
+			}
+			fprintf(pFile, "%4u %8u %8.0fus %8.0fus %8.0fus %8.0fus %8.0fus %10llu %12.0f\n", pFC->ucFC, (unsigned)pFC->ulSamples,
+						 Bench_Percentile(pFC->pTurnNs, pFC->ulSamples, 0.50) / 1e3,
+						 Bench_Percentile(pFC->pTurnNs, pFC->ulSamples, 0.99) / 1e3,
+						 Bench_Percentile(pFC->pTurnNs, pFC->ulSamples, 1.00) / 1e3,
+						 Bench_Percentile(pFC->pTransNs, pFC->ulSamples, 0.50) / 1e3,
+						 Bench_Percentile(pFC->pTransNs, pFC->ulSamples, 0.99) / 1e3,
+						 (unsigned long long)Bench_Percentile(pFC->pCpuNs, pFC->ulSamples, 0.50),
+						 Bench_Percentile(pFC->pCpuNs, pFC->ulSamples, 0.50) * dCyclesPerNs);
+		}
+		return;
+	}
+
+	fprintf(pFile, "{\n  \"label\": \"%s\",\n", pLabel);
+	fprintf(pFile, "  \"config\": { \"baud\": %u, \"seconds\": %u, \"slaves\": %u, \"mix\": \"%s\", \"registers\": %u, "
+								 "\"gap_us\": %u, \"poll_hz\": %u, \"reply_delay_us\": %u, \"timeout_ms\": %u, \"cycles_per_host_ns\": %g, "
+								 "\"seed\": %u },\n",
+					(unsigned)ulBaud, (unsigned)ulSeconds, (unsigned)uiSlaves, pMix, (unsigned)uiRegisters,
+					(unsigned)(ulGapNs / HOST_US_PER_MS), (unsigned)ulPollHz, (unsigned)(ulDelayNs / HOST_US_PER_MS),
+					(unsigned)(ulTimeoutNs / HOST_NS_PER_MS), dCyclesPerNs, (unsigned)ulSeed);
+	fprintf(pFile, "  \"bus\": { \"transactions\": %u, \"transactions_per_s\": %.3f, \"utilisation\": %.4f, \"late_polls\": %u, "
+								 "\"t35_us\": %.1f },\n",
+					(unsigned)ulTransactions, (double)ulTransactions / ulSeconds, ullBusyNs / ((double)ulSeconds * HOST_NS_PER_S),
+					(unsigned)ulLatePolls, ullT35Ns / 1e3);
+	fprintf(pFile, "  \"sensor\": { \"requests\": %u, \"responses\": %u, \"timeouts\": %u, \"crc_errors\": %u, \"exceptions\": %u, "
+								 "\"overruns\": %u, \"polls_per_s\": %.3f, \"max_poll_hz\": %.3f, \"flash_erases\": %u },\n",
+					(unsigned)ulRequests, (unsigned)ulResponses, (unsigned)ulTimeouts, (unsigned)ulCrcErrors, (unsigned)ulExceptions,
+					(unsigned)sHost.ulUartOverruns, (double)ulResponses / ulSeconds, ulPolled ? 1e9 / (dTransMean + ullT35Ns) : 0.0,
+					(unsigned)sHost.ulFlashErases);
+	fprintf(pFile, "  \"functions\": [");
+	for(i = 0, j = 0; i < BENCH_FC_COUNT; i++)
+	{
+		pFC = &sBenchFC[i];
+		if(pFC->ulRequests == 0)
+		{
+			continue;
+		}
+		for(ullCpuSum = 0, n = 0; n < pFC->ulSamples; n++)
+		{
+			ullCpuSum += pFC->pCpuNs[n];
+		}
+		fprintf(pFile, "%s\n    { \"fc\": %u, \"requests\": %u, \"responses\": %u, \"timeouts\": %u, \"crc_errors\": %u, "
+									 "\"exceptions\": %u,\n", j++ ? "," : "", pFC->ucFC, (unsigned)pFC->ulRequests, (unsigned)pFC->ulResponses,
+						(unsigned)pFC->ulTimeouts, (unsigned)pFC->ulCrcErrors, (unsigned)pFC->ulExceptions);
+		fprintf(pFile, "      \"turnaround_us\": {");
+		for(k = 0; k < BENCH_PERCENTILES; k++)
+		{
+			fprintf(pFile, "%s \"%s\": %.1f", k ? "," : "", pBenchPercentile[k],
+							Bench_Percentile(pFC->pTurnNs, pFC->ulSamples, dBenchPercentile[k]) / 1e3);
+		}
+		fprintf(pFile, " },\n      \"transaction_us\": {");
+		for(k = 0; k < BENCH_PERCENTILES; k++)
+		{
+			fprintf(pFile, "%s \"%s\": %.1f", k ? "," : "", pBenchPercentile[k],
+							Bench_Percentile(pFC->pTransNs, pFC->ulSamples, dBenchPercentile[k]) / 1e3);
+		}
+		fprintf(pFile, " },\n      \"host_ns\": { \"p50\": %llu, \"mean\": %.0f },\n",
+						(unsigned long long)Bench_Percentile(pFC->pCpuNs, pFC->ulSamples, 0.50),
+						pFC->ulSamples ? (double)ullCpuSum / pFC->ulSamples : 0.0);
+		fprintf(pFile, "      \"est_cycles\": { \"p50\": %.0f }, \"est_core_us_mean\": %.1f }",
+						Bench_Percentile(pFC->pCpuNs, pFC->ulSamples, 0.50) * dCyclesPerNs,
+						pFC->ulSamples ? pFC->dCoreUs / pFC->ulSamples : 0.0);
+	}
+	fprintf(pFile, "\n  ]\n}\n");
+}
@@ -0,0 +1,574 @@
+/**
+  ******************************************************************************
+  * 											Next Generation CO2 Sensor
+  * 											Host Build - DSP Replay
+  *
+  *   nextgen_replay [-i trace] [-b] [-f flash.bin] [-u warm_up_samples]
+  *                  [-d ppm] [-c samples.csv] [-o results.json] [-l label]
+  *
+  *   Streams Logged Measurements Through the Firmware's DSP - the Float and
+  *   the Q31 (DSP_FIXED_POINT) Builds of src/dsp.cpp Side by Side, Each With
+  *   its Own Filter State - and Reports What Each Makes of Them and What it
+  *   Costs: the Soft Float and 64 Bit Operations per Sample, Which are the
+  *   Library Calls the Cortex-M0+ Spends its DSP Time in. The Build main.h
+  *   Selects Also Runs Uncounted, as a Check That Counting Changes Nothing.
+  *
+  *   A CSV Trace Has a Header Naming its Columns: raw_sig, temp_signal, nadir
+  *   and zenith are Used and Others Ignored, and Without raw_sig it is
+  *   zenith - nadir as gas_daq.c Makes it. With no Header the Columns are
+  *   Those Four in That Order, and -b Reads Records of Four Little Endian
+  *   uint16 the Same Way. No -i, or "-", is stdin. The Coefficients are the
+  *   Defaults, or the Holding Registers Restored From a Flash Image (-f, as
+  *   nextgen_host -f Keeps). The First Samples (-u, by Default Those Taken
+  *   Before warm_up_time) Only Initialize, as During Warm up. ABC is Not
+  *   Replayed, so abc_correlation_factor Stays as Loaded. Samples Where
+  *   temp_signal is Above temp_divisor (t > 1, Beyond the Range the Q31 Path
+  *   Once Clamped) are Also Compared on Their Own.
+  ******************************************************************************
+  */
+
+//  Includes
+#include  "main.h"
+#include  "host.h"
+#include  "host_dsp.h"
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+#include  <math.h>
+#include  <time.h>
+
+#define REPLAY_BUILDS						3u				//  Native, Float, Q31
+#define REPLAY_NATIVE						0u
+#define REPLAY_FLOAT						1u
+#define REPLAY_Q31							2u
+#define REPLAY_INPUTS						4u
+#define REPLAY_LINE_BYTES				4096u
+#define REPLAY_MS_PER_TICK			10u				//  sample_time Units
+
+enum REPLAY_INPUT
+{
+	REPLAY_RAW_SIG = 0,
+	REPLAY_TEMP_SIGNAL,
+	REPLAY_NADIR,
+	REPLAY_ZENITH
+};
+
+//  Results per Build
+typedef struct
+{
+	const HostDspBuild *pBuild;
+	HostDspOps sSum;										//  Over the Calculated Samples
+	uint32_t ulMaxOps;									//  Most Counted Operations in One Sample
+	uint32_t ulFloatOps;								//  This Sample
+	uint32_t ulWideOps;
+	uint16_t uiPpm;
+	float fNormAvg;
+	uint16_t uiPpmMin;
+	uint16_t uiPpmMax;
+	double dPpmSum;
+} ReplayBuild;
+
+HostDspOps sHostDspOps;
+
+static const HostDspBuild sHostDspNative = { "native", dsp_load_coefficients, dsp_initialize_gas_ppm, dsp_calculate_gas_ppm };
+static const char * const pReplayInput[REPLAY_INPUTS] = { "raw_sig", "temp_signal", "nadir", "zenith" };
+
+static ReplayBuild sReplay[REPLAY_BUILDS] =
+{
+	{ &sHostDspNative }, { &sHostDspFloat }, { &sHostDspQ31 }
+};
+
+//  Options
+static const char *pTracePath = "-";
+static const char *pFlashPath = NULL;
+static bool bBinary = false;
+static uint32_t ulWarmUp = 0xffffffff;
+static double dTolerance = 1.0;
+
+//  Input
+static FILE *pTrace;
+static int iColumn[REPLAY_INPUTS] = { 0, 1, 2, 3 };
+static bool bHeader = false;
+static uint32_t ulLine = 0;
+
+//  Totals
+static uint32_t ulSamples = 0;
+static uint32_t ulOverTolerance = 0;
+static uint32_t ulMaxPpmDiff = 0;
+static double dPpmDiffSum = 0;
+static double dMaxNormDiff = 0;
+static uint32_t ulAboveDivisor = 0;					//  Calculated With temp_signal > temp_divisor
+static uint32_t ulAboveMaxPpmDiff = 0;
+static uint32_t ulNativeMismatches = 0;
+static double dHostSeconds;
+
+static bool Replay_Read(uint16_t *);
+static bool Replay_Header(char *);
+static void Replay_Sample(uint16_t *, FILE *);
+static void Replay_Run(ReplayBuild *, bool);
+static uint32_t Replay_Sum(const HostDspOps *, bool);
+static void Replay_Report(FILE *, const char *);
+
+int main(int argc, char **argv)
+{
+	const char *pJson = NULL;
+	const char *pLabel = "";
+	const char *pCsv = NULL;
+	FILE *pFile, *pSamples = NULL;
+	struct timespec sStart, sEnd;
+	uint16_t uiInput[REPLAY_INPUTS];
+	uint8_t i;
+	int iArg;
+
+	for(iArg = 1; iArg < argc; iArg++)
+	{
+		const char *pValue = (iArg + 1 < argc) ? argv[iArg + 1] : NULL;
+
+		if(strcmp(argv[iArg], "-b") == 0)
+		{
+			bBinary = true;
+			continue;
+		}
+		if(pValue == NULL)
+		{
+			break;
+		}
+		if(strcmp(argv[iArg], "-i") == 0)
+		{
+			pTracePath = pValue;
+		}
+		else if(strcmp(argv[iArg], "-f") == 0)
+		{
+			pFlashPath = pValue;
+		}
+		else if(strcmp(argv[iArg], "-u") == 0)
+		{
+			ulWarmUp = (uint32_t)strtoul(pValue, NULL, 0);
+		}
+		else if(strcmp(argv[iArg], "-d") == 0)
+		{
+			dTolerance = strtod(pValue, NULL);
+		}
+		else if(strcmp(argv[iArg], "-c") == 0)
+		{
+			pCsv = pValue;
+		}
+		else if(strcmp(argv[iArg], "-o") == 0)
+		{
+			pJson = pValue;
+		}
+		else if(strcmp(argv[iArg], "-l") == 0)
+		{
+			pLabel = pValue;
+		}
+		else
+		{
+			break;
+		}
+		iArg ++;
+	}
+	if(iArg < argc)
+	{
+		fprintf(stderr, "usage: %s [-i trace] [-b] [-f flash.bin] [-u warm_up_samples] [-d ppm]\n"
+										"       [-c samples.csv] [-o results.json] [-l label]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	pTrace = (strcmp(pTracePath, "-") == 0) ? stdin : fopen(pTracePath, bBinary ? "rb" : "r");
+	if(pTrace == NULL)
+	{
+		fprintf(stderr, "%s: can not read %s\n", argv[0], pTracePath);
+		return EXIT_FAILURE;
+	}
+	if(pCsv && ((pSamples = fopen(pCsv, "w")) == NULL))
+	{
+		fprintf(stderr, "%s: can not write %s\n", argv[0], pCsv);
+		return EXIT_FAILURE;
+	}
+
+	//  The DSP Only Needs the Registers Mapped (SysTick) - the Firmware is Not Booted
+	Host_Init();
+	if(pFlashPath == NULL)
+	{
+		FlashRestoreDefaults();
+	}
+	else if(!Host_FlashLoad(pFlashPath) || !FlashRestore())
+	{
+		fprintf(stderr, "%s: no parameters in %s\n", argv[0], pFlashPath);
+		return EXIT_FAILURE;
+	}
+	if(ulWarmUp == 0xffffffff)
+	{
+		//  Sample k is Taken at (k + 1) * sample_time; Those Before warm_up_time Initialize
+		ulWarmUp = sHRegs.sample_time ? (sHRegs.warm_up_time * 1000u + sHRegs.sample_time * REPLAY_MS_PER_TICK - 1u) /
+																		(sHRegs.sample_time * REPLAY_MS_PER_TICK) - 1u : 0;
+	}
+	for(i = 0; i < REPLAY_BUILDS; i++)
+	{
+		sReplay[i].pBuild->pLoad();
+		sReplay[i].uiPpmMin = 0xffff;
+	}
+
+	if(pSamples)
+	{
+		fprintf(pSamples, "sample,raw_sig,temp_signal");
+		for(i = REPLAY_FLOAT; i < REPLAY_BUILDS; i++)
+		{
+			fprintf(pSamples, ",%s_gas_ppm,%s_norm_sig_avg,%s_float_ops,%s_wide_ops", sReplay[i].pBuild->pName,
+							sReplay[i].pBuild->pName, sReplay[i].pBuild->pName, sReplay[i].pBuild->pName);
+		}
+		fprintf(pSamples, "\n");
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &sStart);
+	while(Replay_Read(uiInput))
+	{
+		Replay_Sample(uiInput, pSamples);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &sEnd);
+	dHostSeconds = (sEnd.tv_sec - sStart.tv_sec) + (sEnd.tv_nsec - sStart.tv_nsec) / 1e9;
+	if(ferror(pTrace) || (ulLine && !bHeader && (ulSamples == 0)))
+	{
+		fprintf(stderr, "%s: can not read %s\n", argv[0], pTracePath);
+		return EXIT_FAILURE;
+	}
+	if(pSamples && (fclose(pSamples) != 0))
+	{
+		fprintf(stderr, "%s: can not write %s\n", argv[0], pCsv);
+		return EXIT_FAILURE;
+	}
+
+	Replay_Report(stdout, NULL);
+	if(pJson)
+	{
+		if((pFile = fopen(pJson, "w")) == NULL)
+		{
+			fprintf(stderr, "%s: can not write %s\n", argv[0], pJson);
+			return EXIT_FAILURE;
+		}
+		Replay_Report(pFile, pLabel);
+		fclose(pFile);
+	}
+	return EXIT_SUCCESS;
+}
+
+/**
+  * @brief  Next Sample From the Trace
+  * @param  pInput - raw_sig, temp_signal, nadir, zenith Out
+  * @retval false at the End, or on a Malformed Line (Reported)
+  */
+static bool Replay_Read(uint16_t *pInput)
+{
+	char cLine[REPLAY_LINE_BYTES];
+	char *pField, *pEnd;
+	uint8_t ucRecord[2u * REPLAY_INPUTS];
+	double dValue;
+	bool bFound[REPLAY_INPUTS] = { false };
+	int iField;
+	uint8_t i;
+
+	if(bBinary)
+	{
+		if(fread(ucRecord, sizeof(ucRecord), 1, pTrace) != 1)
+		{
+			return false;
+		}
+		for(i = 0; i < REPLAY_INPUTS; i++)
+		{
+			pInput[i] = (uint16_t)(ucRecord[2 * i] | (ucRecord[2 * i + 1] << 8));
+		}
+		return true;
+	}
+
+	while(fgets(cLine, sizeof(cLine), pTrace))
+	{
+		ulLine ++;
+		pField = cLine + strspn(cLine, " \t");
+		if((*pField == '#') || (*pField == '\0') || (*pField == '\r') || (*pField == '\n'))
+		{
+			continue;
+		}
+		if(!bHeader && (ulSamples == 0) && !strchr("0123456789+-.", *pField))
+		{
+			if(!Replay_Header(pField))
+			{
+				return false;
+			}
+			bHeader = true;
+			continue;
+		}
+
+		for(iField = 0; ; iField++)
+		{
+			dValue = strtod(pField, &pEnd);
+			for(i = 0; i < REPLAY_INPUTS; i++)
+			{
+				if(iColumn[i] == iField)
+				{
+					if((pEnd == pField) || (dValue < 0) || (dValue > 65535.0))
+					{
+						fprintf(stderr, "%s:%u: bad %s\n", pTracePath, (unsigned)ulLine, pReplayInput[i]);
+						return false;
+					}
+					pInput[i] = (uint16_t)(dValue + 0.5);
+					bFound[i] = true;
+				}
+			}
+			if((pField = strchr(pField, ',')) == NULL)
+			{
+				break;
+			}
+			pField ++;
+		}
+		if(iColumn[REPLAY_RAW_SIG] < 0)
+		{
+			pInput[REPLAY_RAW_SIG] = (pInput[REPLAY_ZENITH] > pInput[REPLAY_NADIR]) ?
+															 pInput[REPLAY_ZENITH] - pInput[REPLAY_NADIR] : 0;
+			bFound[REPLAY_RAW_SIG] = true;
+		}
+		for(i = 0; i < REPLAY_INPUTS; i++)
+		{
+			if(!bFound[i] && (iColumn[i] >= 0))
+			{
+				fprintf(stderr, "%s:%u: no %s\n", pTracePath, (unsigned)ulLine, pReplayInput[i]);
+				return false;
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+/**
+  * @brief  Find the Input Columns by Name
+  * @param  pLine - Header Line
+  * @retval false if raw_sig (or nadir and zenith) or temp_signal is Missing
+  */
+static bool Replay_Header(char *pLine)
+{
+	char *pName;
+	size_t lLength;
+	int iField;
+	uint8_t i;
+
+	for(i = 0; i < REPLAY_INPUTS; i++)
+	{
+		iColumn[i] = -1;
+	}
+	for(iField = 0; pLine; iField++)
+	{
+		pName = pLine + strspn(pLine, " \t\"");
+		lLength = strcspn(pName, " \t\",\r\n");
+		for(i = 0; i < REPLAY_INPUTS; i++)
+		{
+			if((strlen(pReplayInput[i]) == lLength) && (strncmp(pName, pReplayInput[i], lLength) == 0))
+			{
+				iColumn[i] = iField;
+			}
+		}
+		if((pLine = strchr(pLine, ',')) != NULL)
+		{
+			pLine ++;
+		}
+	}
+	if((iColumn[REPLAY_TEMP_SIGNAL] < 0) ||
+		 ((iColumn[REPLAY_RAW_SIG] < 0) && ((iColumn[REPLAY_NADIR] < 0) || (iColumn[REPLAY_ZENITH] < 0))))
+	{
+		fprintf(stderr, "%s:%u: header needs temp_signal and raw_sig (or nadir and zenith)\n", pTracePath, (unsigned)ulLine);
+		return false;
+	}
+	return true;
+}
+
+/**
+  * @brief  Run One Sample Through Every Build and Compare
+  * @param  pInput - raw_sig, temp_signal, nadir, zenith
+  * @param  pSamples - Per Sample CSV, or NULL
+  * @retval None
+  */
+static void Replay_Sample(uint16_t *pInput, FILE *pSamples)
+{
+	bool bWarmUp = ulSamples < ulWarmUp;
+	ReplayBuild *pNative = &sReplay[REPLAY_NATIVE];
+	ReplayBuild *pCounted;
+	double dNormDiff;
+	uint32_t ulPpmDiff;
+	uint8_t i;
+
+	raw_sig = pInput[REPLAY_RAW_SIG];
+	detector_temperature = pInput[REPLAY_TEMP_SIGNAL];
+	nadir = pInput[REPLAY_NADIR];
+	zenith = pInput[REPLAY_ZENITH];
+	for(i = 0; i < REPLAY_BUILDS; i++)
+	{
+		Replay_Run(&sReplay[i], bWarmUp);
+	}
+	ulSamples ++;
+
+	//  The Native Build Must Match its Counted Twin Exactly
+#ifdef DSP_FIXED_POINT
+	pCounted = &sReplay[REPLAY_Q31];
+#else
+	pCounted = &sReplay[REPLAY_FLOAT];
+#endif
+	if((pNative->uiPpm != pCounted->uiPpm) || (memcmp(&pNative->fNormAvg, &pCounted->fNormAvg, sizeof(float)) != 0))
+	{
+		ulNativeMismatches ++;
+	}
+
+	if(!bWarmUp)
+	{
+		ulPpmDiff = (uint32_t)abs((int)sReplay[REPLAY_Q31].uiPpm - (int)sReplay[REPLAY_FLOAT].uiPpm);
+		dNormDiff = fabs((double)sReplay[REPLAY_Q31].fNormAvg - (double)sReplay[REPLAY_FLOAT].fNormAvg);
+		ulMaxPpmDiff = (ulPpmDiff > ulMaxPpmDiff) ? ulPpmDiff : ulMaxPpmDiff;
+		dMaxNormDiff = (dNormDiff > dMaxNormDiff) ? dNormDiff : dMaxNormDiff;
+		dPpmDiffSum += ulPpmDiff;
+		if(ulPpmDiff > dTolerance)
+		{
+			ulOverTolerance ++;
+		}
+		if(detector_temperature > sHRegs.temp_divisor)
+		{
+			ulAboveDivisor ++;
+			ulAboveMaxPpmDiff = (ulPpmDiff > ulAboveMaxPpmDiff) ? ulPpmDiff : ulAboveMaxPpmDiff;
+		}
+	}
+
+	if(pSamples)
+	{
+		fprintf(pSamples, "%u,%u,%u", (unsigned)(ulSamples - 1u), raw_sig, detector_temperature);
+		for(i = REPLAY_FLOAT; i < REPLAY_BUILDS; i++)
+		{
+			fprintf(pSamples, ",%u,%.9g,%u,%u", sReplay[i].uiPpm, (double)sReplay[i].fNormAvg,
+							(unsigned)sReplay[i].ulFloatOps, (unsigned)sReplay[i].ulWideOps);
+		}
+		fprintf(pSamples, "\n");
+	}
+}
+
+/**
+  * @brief  Run a Build on the Current Inputs and Count What it Did
+  * @param  pReplay - Build
+  * @param  bWarmUp - Initialize Instead of Calculate
+  * @retval None
+  */
+static void Replay_Run(ReplayBuild *pReplay, bool bWarmUp)
+{
+	HostDspOps *pSum = &pReplay->sSum;
+	HostDspOps sOps;
+
+	memset(&sHostDspOps, 0, sizeof(sHostDspOps));
+	if(bWarmUp)
+	{
+		pReplay->pBuild->pInit();
+	}
+	else
+	{
+		pReplay->pBuild->pCalc();
+	}
+	sOps = sHostDspOps;
+	pReplay->uiPpm = sIRegs.gas_ppm;
+	pReplay->fNormAvg = sIRegs.norm_sig_avg;
+	pReplay->ulFloatOps = Replay_Sum(&sOps, false);
+	pReplay->ulWideOps = Replay_Sum(&sOps, true);
+	if(bWarmUp)
+	{
+		return;
+	}
+
+	pSum->ulFAdd += sOps.ulFAdd;
+	pSum->ulFMul += sOps.ulFMul;
+	pSum->ulFDiv += sOps.ulFDiv;
+	pSum->ulFCmp += sOps.ulFCmp;
+	pSum->ulFConv += sOps.ulFConv;
+	pSum->ulLMul += sOps.ulLMul;
+	pSum->ulLShift += sOps.ulLShift;
+	if(pReplay->ulFloatOps + pReplay->ulWideOps > pReplay->ulMaxOps)
+	{
+		pReplay->ulMaxOps = pReplay->ulFloatOps + pReplay->ulWideOps;
+	}
+	pReplay->uiPpmMin = (pReplay->uiPpm < pReplay->uiPpmMin) ? pReplay->uiPpm : pReplay->uiPpmMin;
+	pReplay->uiPpmMax = (pReplay->uiPpm > pReplay->uiPpmMax) ? pReplay->uiPpm : pReplay->uiPpmMax;
+	pReplay->dPpmSum += pReplay->uiPpm;
+}
+
+/**
+  * @brief  Total Soft Float, or 64 Bit, Operations
+  * @param  pOps - Counts
+  * @param  bWide - 64 Bit Rather Than Float
+  * @retval Sum
+  */
+static uint32_t Replay_Sum(const HostDspOps *pOps, bool bWide)
+{
+	if(bWide)
+	{
+		return pOps->ulLMul + pOps->ulLShift;
+	}
+	return pOps->ulFAdd + pOps->ulFMul + pOps->ulFDiv + pOps->ulFCmp + pOps->ulFConv;
+}
+
+/**
+  * @brief  Write the Results - a Table, or JSON When a Label is Given
+  * @param  pFile - Output
+  * @param  pLabel - JSON Run Label, NULL for the Table
+  * @retval None
+  */
+static void Replay_Report(FILE *pFile, const char *pLabel)
+{
+	uint32_t ulCalculated = (ulSamples > ulWarmUp) ? ulSamples - ulWarmUp : 0;
+	double dPer = ulCalculated ? 1.0 / ulCalculated : 0.0;
+	const HostDspOps *pSum;
+	ReplayBuild *pReplay;
+	uint8_t i;
+
+	if(pLabel == NULL)
+	{
+		fprintf(pFile, "%s: %u samples (%u warm up), %.3f s host, %.0f samples/s; coefficients %s\n",
+					 pTracePath, (unsigned)ulSamples, (unsigned)((ulSamples < ulWarmUp) ? ulSamples : ulWarmUp), dHostSeconds,
+					 dHostSeconds > 0 ? ulSamples / dHostSeconds : 0.0, pFlashPath ? pFlashPath : "default");
+		fprintf(pFile, "%-6s %8s %8s %8s %8s %8s %8s %8s %8s %9s %9s\n", "build", "fadd", "fmul", "fdiv", "fcmp", "fconv",
+					 "lmul", "lshift", "max ops", "ppm min", "ppm max");
+		for(i = REPLAY_FLOAT; i < REPLAY_BUILDS; i++)
+		{
+			pReplay = &sReplay[i];
+			pSum = &pReplay->sSum;
+			fprintf(pFile, "%-6s %8.2f %8.2f %8.2f %8.2f %8.2f %8.2f %8.2f %8u %9u %9u\n", pReplay->pBuild->pName,
+						 pSum->ulFAdd * dPer, pSum->ulFMul * dPer, pSum->ulFDiv * dPer, pSum->ulFCmp * dPer, pSum->ulFConv * dPer,
+						 pSum->ulLMul * dPer, pSum->ulLShift * dPer, (unsigned)pReplay->ulMaxOps,
+						 ulCalculated ? pReplay->uiPpmMin : 0u, (unsigned)pReplay->uiPpmMax);
+		}
+		fprintf(pFile, "q31 vs float: gas_ppm max |d| %u, mean |d| %.3f, over %g ppm %u (%.2f%%); norm_sig_avg max |d| %.3g\n",
+					 (unsigned)ulMaxPpmDiff, dPpmDiffSum * dPer, dTolerance, (unsigned)ulOverTolerance, 100.0 * ulOverTolerance * dPer,
+					 dMaxNormDiff);
+		fprintf(pFile, "q31 vs float above temp_divisor: %u samples, gas_ppm max |d| %u\n", (unsigned)ulAboveDivisor,
+					 (unsigned)ulAboveMaxPpmDiff);
+		fprintf(pFile, "native build matches the counted one: %s (%u mismatches)\n", ulNativeMismatches ? "no" : "yes",
+					 (unsigned)ulNativeMismatches);
+		return;
+	}
+
+	fprintf(pFile, "{\n  \"label\": \"%s\",\n", pLabel);
+	fprintf(pFile, "  \"config\": { \"trace\": \"%s\", \"binary\": %s, \"flash\": \"%s\", \"warm_up_samples\": %u, "
+								 "\"tolerance_ppm\": %g },\n",
+					pTracePath, bBinary ? "true" : "false", pFlashPath ? pFlashPath : "", (unsigned)ulWarmUp, dTolerance);
+	fprintf(pFile, "  \"samples\": %u, \"calculated\": %u, \"host_s\": %.6f,\n", (unsigned)ulSamples, (unsigned)ulCalculated,
+					dHostSeconds);
+	fprintf(pFile, "  \"builds\": [");
+	for(i = REPLAY_FLOAT; i < REPLAY_BUILDS; i++)
+	{
+		pReplay = &sReplay[i];
+		pSum = &pReplay->sSum;
+		fprintf(pFile, "%s\n    { \"name\": \"%s\", \"ops_per_sample\": { \"fadd\": %.3f, \"fmul\": %.3f, \"fdiv\": %.3f, "
+									 "\"fcmp\": %.3f, \"fconv\": %.3f, \"lmul\": %.3f, \"lshift\": %.3f }, \"max_ops\": %u,\n",
+						(i == REPLAY_FLOAT) ? "" : ",", pReplay->pBuild->pName, pSum->ulFAdd * dPer, pSum->ulFMul * dPer,
+						pSum->ulFDiv * dPer, pSum->ulFCmp * dPer, pSum->ulFConv * dPer, pSum->ulLMul * dPer, pSum->ulLShift * dPer,
+						(unsigned)pReplay->ulMaxOps);
+		fprintf(pFile, "      \"gas_ppm\": { \"min\": %u, \"max\": %u, \"mean\": %.3f } }",
+						ulCalculated ? pReplay->uiPpmMin : 0u, (unsigned)pReplay->uiPpmMax, pReplay->dPpmSum * dPer);
+	}
+	fprintf(pFile, "\n  ],\n  \"q31_vs_float\": { \"max_abs_ppm\": %u, \"mean_abs_ppm\": %.4f, \"over_tolerance\": %u, "
+								 "\"max_abs_norm_sig_avg\": %.6g,\n    \"above_temp_divisor\": { \"samples\": %u, \"max_abs_ppm\": %u } },\n",
+					(unsigned)ulMaxPpmDiff, dPpmDiffSum * dPer, (unsigned)ulOverTolerance, dMaxNormDiff, (unsigned)ulAboveDivisor,
+					(unsigned)ulAboveMaxPpmDiff);
+	fprintf(pFile, "  \"native_mismatches\": %u\n}\n", (unsigned)ulNativeMismatches);
+}
@@ -52,9 +52,14 @@ void HardFault_Handler(void);
 void SVC_Handler(void);
 void PendSV_Handler(void);
 void SysTick_Handler(void);
+void FLASH_IRQHandler(void);
+void RTC_IRQHandler(void);
 void EXTI4_15_IRQHandler(void);
 void USART1_IRQHandler(void);
 void ADC1_IRQHandler(void);
+void DMA1_Channel1_IRQHandler(void);
+void DMA1_Channel2_3_IRQHandler(void);
+void TIM14_IRQHandler(void);
 void I2C1_IRQHandler(void);
 
 /* USER CODE BEGIN EFP */
@@ -0,0 +1,32 @@
+
+//  Automatic Baseline Correction. Fresh Air (the Lowest Gas) Gives the Highest
+//  Normalized Signal, so the Baseline is the Rolling Maximum of the Per Period
+//  Peaks of norm_sig_avg Over the Last abc_sample_count Periods.
+
+//  Sample Ring - Two Pages Below the Parameter Pages; One Fills While the
+//  Other Holds the Older Samples
+#define ABC_RING_BASE						0x08006000
+#define ABC_RING_PAGES					2u
+#define ABC_PAGE_ENTRIES				(FLASH_PAGE_BYTES / sizeof(AbcEntry))
+#define ABC_RING_ENTRIES				(ABC_RING_PAGES * ABC_PAGE_ENTRIES)
+#define ABC_ENTRY_CRC_BYTES			6			//  Entry Bytes Covered by its CRC
+
+#define ABC_MAX_SAMPLE_COUNT		128u	//  Look Back Limit (abc_sample_count), in Samples
+#define ABC_MAX_SAMPLE_RATE			1000u	//  Hours - Keeps the Period in a 32 Bit mS Count
+#define ABC_MS_PER_HOUR					3600000u
+#define ABC_FACTOR_MIN					0.5f	//  Sanity Bounds on a Computed Factor
+#define ABC_FACTOR_MAX					1.5f
+
+//  Ring Entry - One Period's Peak Signal, One Double Word
+typedef struct
+{
+	float fSignal;												//  Highest norm_sig_avg in the Period
+	uint16_t uiSeq;												//  Sample Number, Counts Up Across the Ring
+	uint16_t uiCRC;												//  Over the First 6 Bytes, Low Byte First
+} AbcEntry;
+
+/* Exported functions prototypes ---------------------------------------------*/
+void Abc_Init(void);
+void Abc_Update(float);
+void Abc_Tick_1S(void);
+
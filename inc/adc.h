@@ -10,16 +10,38 @@ enum ADC_CHANNEL
   ADC_CHANNEL_TEMP_SIGNAL   = 9
 };
 
+//  Scan Sequence Order (Position of Each Channel in a Scan Block)
+enum ADC_SCAN_RANK
+{
+  ADC_RANK_GAS_SIGNAL       = 0,
+  ADC_RANK_TEMP_SIGNAL      = 1,
+  ADC_RANK_VIN_ADC          = 2,
+  ADC_RANK_V_LAMP_PLUS      = 3,
+  ADC_RANK_V_LAMP_MINUS     = 4,
+  ADC_RANK_IO_CONFIG        = 5
+};
+
+#define ADC_SCAN_LENGTH					6				//  Conversions per Scan (One per Rank)
+#define ADC_SCAN_BLOCKS					2				//  Double Buffered - DMA Fills One While Other is Read
+#define ADC_SCAN_PERIOD_US			1000u		//  TIM3 Trigger Period Between Scans
+#define ADC_OVS_MAX_LOG2				8u			//  Hardware Oversampling Up to 256 Conversions
+
 /* Exported functions prototypes ---------------------------------------------*/
 void ADC1_Init(void);
 void ADC1_Activate(void);
+void ADC_Scan_Init(void);
+void ADC_Scan_Start(void);
+void ADC_Scan_Stop(void);
+void ADC_Set_Oversampling(uint16_t);
+void ADC_Scan_Complete_Callback(uint8_t);
 void AdcGrpRegularUnitaryConvComplete_Callback(void);
 void AdcGrpRegularOverrunError_Callback(void);
-uint16_t ADC_Measure(uint8_t);
 
 
 extern uint32_t ulADC_Data;
 extern uint16_t uiCO2_Measure_Tmr;
+extern volatile uint16_t uiADC_ScanBuff[ADC_SCAN_BLOCKS][ADC_SCAN_LENGTH];
+extern volatile uint16_t *puiADC_ScanResult;
 
 //extern uint16_t uiADC_CO2_Reading;
 //extern uint16_t uiADC_Temp_Reading;
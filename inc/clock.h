@@ -0,0 +1,23 @@
+//  SYSCLK Levels (HSI48 Divided). Peripherals That Must Not Follow SYSCLK
+//  (USART1, I2C1) Run From HSIKER at 48 MHz
+#define CLOCK_FULL_HZ						48000000u
+#define CLOCK_LOW_HSIDIV				LL_RCC_HSI_DIV_8
+#define CLOCK_LOW_HZ						(CLOCK_FULL_HZ / 8u)
+#define CLOCK_LATENCY_1_HZ			24000000u		//  Above This Flash Needs a Wait State
+
+#define CLOCK_COMM_FAST_BAUD		19200u			//  Above This a Frame Holds Full Speed
+
+//  Clients That Need Full Speed - One Bit Each
+#define CLOCK_CLIENT_ADC				0x01				//  ADC Burst (ADC and TIM3 Only Run at Full Speed)
+#define CLOCK_CLIENT_DSP				0x02				//  Gas Concentration Calculation
+#define CLOCK_CLIENT_COMM				0x04				//  Frame at a High Baud Rate, or I2C Mode
+#define CLOCK_CLIENT_BOOT				0x80				//  Initialization (SystemClock_Config Starts at Full)
+
+/* Exported functions prototypes ---------------------------------------------*/
+void Clock_Request(uint8_t);
+void Clock_Release(uint8_t);
+
+extern volatile uint8_t ucClockClients;
+
+
+
@@ -2,7 +2,7 @@
 
 
 bool queue_enqueue(Buffer &, uint8_t);
-bool queue_dequeue(Buffer, uint8_t*);
-void Handle_Rcvd_Msg(void);
-uint16_t Calc_crc(Buffer);
+bool queue_dequeue(Buffer &, uint8_t*);
+void Handle_Rcvd_Msg(const Buffer &, Buffer &);
+uint16_t Calc_crc(const Buffer &);
 
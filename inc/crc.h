@@ -0,0 +1,17 @@
+
+
+#ifndef HOST_BUILD											//  No CRC Peripheral in the Host Models
+#define CRC_USE_HARDWARE								//  Block CRC on the CRC Peripheral (Comment Out for Table)
+#endif
+#define CRC16_INIT_VALUE				0xffff	//  CRC-16/MODBUS Seed
+#define CRC16_POLYNOMIAL				0x8005	//  Normal Form of the Reflected 0xA001
+
+/* Exported functions prototypes ---------------------------------------------*/
+void CRC_Init(void);
+uint16_t CRC_Calc(const uint8_t *, uint16_t);
+uint16_t CRC_Update(uint16_t, uint8_t);
+
+extern uint16_t uiRxCRC;
+
+
+
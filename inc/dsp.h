@@ -20,15 +20,15 @@
 
 /** @brief      Used in the temperature correction calculation for gas ppm less
  *              than the span (1) target gas ppm. */
-#define TCOR1_COEFFS (float*)((void*)&block->tcor1_coeff[0].re)
+#define TCOR1_COEFFS (&sHRegs.tcor1_coeff_x0)
 
 /** @brief      Used in the temperature correction calculation for gas ppm less
  *              than, and greater than the span (1) target gas ppm. */
-#define TCOR2_COEFFS (float*)((void*)&block->tcor2_coeff[0].re)
+#define TCOR2_COEFFS (&sHRegs.tcor2_coeff_x0)
 
 /** @brief      Used in the temperature correction calculation for gas ppm
  *              greater than the span (1) target gas ppm. */
-#define TCOR3_COEFFS (float*)((void*)&block->tcor3_coeff[0].re)
+#define TCOR3_COEFFS (&sHRegs.tcor3_coeff_x0)
 /**@}*/
 
 /** @name       Gas Calculation Coefficients
@@ -38,13 +38,18 @@
 
 /** @brief      Coefficients used in the ppm calculation for gas concentrations
  *              of 1000 ppm or less. */
-#define GAS1_PPM_COEFFS  (float*)((void*)&block->gas1_ppm_coeff[0].re)
+#define GAS1_PPM_COEFFS  (&sHRegs.gas1_ppm_coeff_x0)
 
 /** @brief      Coefficients used in the ppm calculation for gas concentrations
  *              of 1000 ppm more less. */
-#define GAS2_PPM_COEFFS  (float*)((void*)&block->gas2_ppm_coeff[0].re)
+#define GAS2_PPM_COEFFS  (&sHRegs.gas2_ppm_coeff_x0)
 
-#define DSP_ADAPT_COEFF_QUAD (block->dsp_adapt_coeff.re)*(block->dsp_adapt_coeff.re)*(block->dsp_adapt_coeff.re)*(block->dsp_adapt_coeff.re)*(block->dsp_adapt_coeff.re)
+/** @brief      Number of coefficients in each polynomial. */
+#define NUM_TCOR_COEFF      4
+#define NUM_GAS1_PPM_COEFF  4
+#define NUM_GAS2_PPM_COEFF  8
+
+#define DSP_ADAPT_COEFF_QUAD (sHRegs.dsp_adapt_coeff)*(sHRegs.dsp_adapt_coeff)*(sHRegs.dsp_adapt_coeff)*(sHRegs.dsp_adapt_coeff)*(sHRegs.dsp_adapt_coeff)
 
 /** @brief      Special firmware feature for Media company. This is to adjust 
  *              starting PPM. */
@@ -90,6 +95,29 @@ extern float norm_sig_avg_alpha;
 
 extern uint16_t dsp_adapt_counter;
 
+/** @name       Cycle Budget
+ *              Each stage of dsp_calculate_gas_ppm() is timed against the
+ *              SysTick down counter (1 count = 1 core clock). The last measured
+ *              cost of each stage is kept in dsp_stage_cycles[] and compared
+ *              against dsp_stage_budget[]; any stage over budget bumps
+ *              dsp_budget_overruns.
+ * @{ */
+typedef enum dsp_stage_tag
+{
+  DSP_STAGE_TCOR      = 0,      /**< temperature and temperature correction.    */
+  DSP_STAGE_NORM      = 1,      /**< normalize by the zero calibration.         */
+  DSP_STAGE_FILTER    = 2,      /**< adaptive exponential filter.               */
+  DSP_STAGE_PPM       = 3,      /**< tcor hat and gas polynomials.              */
+  DSP_STAGE_ALTITUDE  = 4,      /**< altitude correction and output bounds.     */
+  DSP_STAGE_COUNT     = 5
+} Dsp_Stages;
+
+extern uint32_t dsp_stage_cycles[DSP_STAGE_COUNT];
+extern const uint32_t dsp_stage_budget[DSP_STAGE_COUNT];
+extern uint32_t dsp_total_cycles;
+extern uint16_t dsp_budget_overruns;
+/**@}*/
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -110,9 +138,14 @@ float dsp_altitude_correction(float x);
 
 /** @brief          Implements the mathematical operation:
  *
- *  \f$x = \frac{(zero\_cal\_result - norm\_sig\_avg) *
- *  (zero\_cal\_result-span1\_cal\_result)}{abc\_correction\_factor}\f$
+ *  \f$x = \frac{1 - norm\_sig\_avg / abc\_correlation\_factor}
+ *  {1 - span1\_zero\_ratio}\f$
  *
+ *                  i.e., the absorbance in units of the span (1) absorbance;
+ *                  0 at the zero calibration, 1 at the span (1) calibration.
+ *                  norm_sig_avg is already divided by zero_cal_result, so the
+ *                  span enters as span1_zero_ratio (span1_cal_result /
+ *                  zero_cal_result) rather than as a difference of counts.
  *  @return         The result of the calculation
  */
 float dsp_calculate_tcor_hat(void);
@@ -123,6 +156,11 @@ void dsp_initialize_adaptive_filter(float gas);
 /** @brief          Initializes data structures and the first gas ppm. */
 void dsp_initialize_gas_ppm(void);
 
+/** @brief          Re-derive the cached (and, with DSP_FIXED_POINT, the Q31)
+ *                  coefficients from the holding registers. Called at start
+ *                  up and whenever the holding registers are written. */
+void dsp_load_coefficients(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -3,10 +3,58 @@
 #define FLASH_COMMIT_TIMEOUT				3			//  Keep Here ???
 #define FLASH_NUMBER_OF_RECORDS			8			//  Number of Active Pages in 2K Section
 #define FLASH_E2_BASE								0x08007800
+#define FLASH_PAGE_A								0x08007000		//  A/B Parameter Pages
+#define FLASH_PAGE_B								FLASH_E2_BASE
 #define FLASH_RECORD_ALLOCATION			0x100
 #define FLASH_LAST_RECORD						0x08007f00
 #define FLASH_KEY1									0x45670123
 #define FLASH_KEY2									0xcdef89ab
+#define FLASH_PAGE_BYTES						0x800
+#define FLASH_QUEUE_SIZE						4			//  Jobs
+#define FLASH_STORE_MAGIC						0x4a524e4cu		//  "JRNL" - Journaled Page Format
+#define FLASH_BASE_OFFSET						8			//  Base Image Follows the Header
+#define FLASH_JOURNAL_OFFSET				(FLASH_BASE_OFFSET + FLASH_RECORD_ALLOCATION)
+#define FLASH_JOURNAL_ENTRIES				((FLASH_PAGE_BYTES - FLASH_JOURNAL_OFFSET) / 8)
+#define FLASH_ENTRY_CRC_BYTES				6			//  Entry Bytes Covered by its CRC
+#define FLASH_ENTRY_SEQ							0x7f	//  ucTag Transaction Number
+#define FLASH_ENTRY_LAST						0x80	//  ucTag Set on a Transaction's Final Entry
+#define FLASH_SR_ERRORS							(FLASH_SR_OPERR | FLASH_SR_PROGERR | FLASH_SR_WRPERR | FLASH_SR_PGAERR | \
+																		 FLASH_SR_SIZERR | FLASH_SR_PGSERR | FLASH_SR_MISERR | FLASH_SR_FASTERR)
+
+enum FLASH_OP
+{
+  FLASH_OP_ERASE = 0,
+  FLASH_OP_PROGRAM
+};
+
+typedef void (*FlashCallback)(bool);		//  true = Completed Without Error
+
+typedef struct
+{
+	uint8_t ucOp;
+	uint32_t ulAddress;
+	const uint8_t *pData;
+	uint16_t uiLength;
+	FlashCallback pDone;
+} FlashJob;
+
+//  Page Header - First Double Word of the Parameter Page
+typedef struct
+{
+	uint32_t ulMagic;
+	uint8_t ucSeq;												//  Transaction Number the Base Image Includes
+	uint8_t ucReserved;
+	uint16_t uiGeneration;								//  Counts Base Rewrites - Newer Page Wins
+} FlashHeader;
+
+//  Journal Entry - One Changed Holding Register, One Double Word
+typedef struct
+{
+	uint32_t ulValue;											//  16 Bit Values in the Low Half
+	uint8_t ucKey;												//  sHRegFields Index
+	uint8_t ucTag;												//  Transaction Number | FLASH_ENTRY_LAST
+	uint16_t uiCRC;												//  Over the First 6 Bytes, Low Byte First
+} FlashEntry;
 
 bool FlashRestore(void);
 bool FlashInitialize(void);
@@ -14,8 +62,14 @@ bool FlashErase(void);
 bool FlashUnlock(void);
 void FlashRestoreDefaults(void);
 bool FlashCommit(void);
+void FlashService(void);
 uint16_t FlashGetRecordSize(void);
 uint16_t Flash_CRC(uint8_t *, uint16_t);
+bool FlashQueueErase(uint32_t, FlashCallback);
+bool FlashQueueProgram(uint32_t, const uint8_t *, uint16_t, FlashCallback);
+bool FlashBusy(void);
+void Flash_EOP_Callback(void);
+void Flash_Error_Callback(void);
 
 #define	DEFAULT_MODEL_NUMBER								6713u								// 4000
 #define	DEFAULT_MFG_DATA										0xffff
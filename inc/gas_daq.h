@@ -11,6 +11,23 @@
 #define GAS_DAQ_H
 
 #define LAMP_ON_STEPS		3
+
+/** @brief      Lamp PWM (TIM14) periods per 10 mS register tick. The lamp and
+ *              settle times in the holding registers are in 10 mS ticks and
+ *              are counted out in TIM14 update events (2 mS each). */
+#define GAS_DAQ_PERIODS_PER_TICK	5
+
+/** @brief      Full scale of the lamp_data_volt_N registers (12-bit lamp DAC
+ *              counts carried over from the T67xx), mapped onto 100% duty. */
+#define LAMP_DAC_FULL_SCALE				4095u
+
+/** @brief      Extra 10 mS ticks allowed beyond the programmed cycle before
+ *              gas_daq_task() gives up on a measurement. */
+#define GAS_DAQ_TIMEOUT_TICKS			10u
+
+/** @brief      Longest single wait between cycles, in 10 mS ticks (fits the
+ *              16-bit mS scheduler delay). */
+#define GAS_DAQ_MAX_IDLE_TICKS		6000u
 	 
 /* Measurement variables found in this module. */
 
@@ -57,6 +74,23 @@ extern "C" {
 //void gas_daq_task(pTcb tcb);
 void gas_daq_task(void);
 
+/** @brief      10 mS ticks until the next cycle is due, or 0 while a cycle is
+ *              in progress or already due. */
+uint16_t gas_daq_idle_ticks(void);
+
+/** @brief      Starts a lamp-synchronous measurement cycle. */
+void gas_daq_start(void);
+
+/** @brief      Advances the cycle; called from the TIM14 update interrupt. */
+void gas_daq_lamp_callback(void);
+
+/** @brief      Latches the oversampled nadir or zenith burst result for the
+ *              current phase; called from the scan DMA interrupt.
+ *  @param [in] puiScan
+ *              Completed scan block, indexed by ADC_SCAN_RANK.
+ */
+void gas_daq_scan_callback(volatile uint16_t *puiScan);
+
 #ifdef __cplusplus
 }
 #endif
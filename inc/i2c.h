@@ -3,7 +3,8 @@
 
 
 void I2C1_Init(void);
-void I2C_SendMessage(void);
+void I2C_SendMessage(Buffer &);
+void I2C_TxComplete_Callback(void);
 /*
 void Slave_Ready_To_Transmit_Callback(void);
 void Slave_Complete_Callback(void);
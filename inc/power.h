@@ -0,0 +1,21 @@
+#define TICKLESS_IDLE										//  Stop Mode Between Tasks (Comment Out for Sleep Only)
+
+//  RTC on LSI (32 kHz): Sub Second Counter Steps Every mS, Wraps Every Second
+#define RTC_PREDIV_A						31u
+#define RTC_PREDIV_S						999u
+#define RTC_SS_PER_SECOND				(RTC_PREDIV_S + 1u)
+#define RTC_ALMA_SS_BITS				10u			//  Alarm Compares SS[9:0] Only - Fires Once a Second
+
+#define TICKLESS_MIN_MS					3u			//  Shorter Idle Just Sleeps (WFI)
+#define TICKLESS_MAX_MS					(RTC_SS_PER_SECOND - 1u)
+
+/* Exported functions prototypes ---------------------------------------------*/
+void Power_Init(void);
+uint16_t Power_Idle(uint16_t);
+uint16_t Power_GetSubSecond(void);
+void RTC_Alarm_Callback(void);
+
+extern uint32_t ulStopCount;
+
+
+
@@ -0,0 +1,50 @@
+
+//  Section Profiler - TIM17 Free Runs at 1 MHz (the Clock Governor Keeps the
+//  Rate at Every SYSCLK Level), Sections Up to 65 mS
+#define PROF_TIMER							TIM17
+#define PROF_TIMER_HZ						1000000u
+#define PROF_AVG_SHIFT					4u		//  Running Average Weight 1/16
+
+//  Instrumented Sections - Each Gets a Block of Input Registers
+#define PROF_SECTION_LIST(M, X) \
+	M(X, GAS_DAQ,       gas_daq      )		/*  gas_daq_task */ \
+	M(X, DSP,           dsp          )		/*  dsp_calculate_gas_ppm */ \
+	M(X, MODBUS,        modbus       )		/*  Handle_Rcvd_Msg */ \
+	M(X, FLASH_COMMIT,  flash_commit )		/*  FlashCommit */ \
+	M(X, ISR_USART,     isr_usart    ) \
+	M(X, ISR_ADC_DMA,   isr_adc_dma  ) \
+	M(X, ISR_FLASH,     isr_flash    ) \
+	M(X, ISR_LAMP,      isr_lamp     )
+
+#define PROF_ENUM(X, Id, Name)				PROF_##Id,
+
+enum PROF_SECTION
+{
+	PROF_SECTION_LIST(PROF_ENUM, ~)
+	PROF_SECTION_COUNT
+};
+
+//  Input Registers per Section: Minimum, Maximum and Running Average in uS,
+//  and the Number of Runs
+#define PROF_INPUT_REGS(X, Id, Name) \
+	X(U16, prof_##Name##_min,   0,   NULL                   ) \
+	X(U16, prof_##Name##_max,   0,   NULL                   ) \
+	X(U16, prof_##Name##_avg,   0,   NULL                   ) \
+	X(U32, prof_##Name##_count, 0,   NULL                   )
+
+typedef struct
+{
+	uint16_t uiMin;
+	uint16_t uiMax;
+	uint32_t ulAvg;												//  Scaled by 1 << PROF_AVG_SHIFT
+	uint32_t ulCount;
+} ProfStat;
+
+//  Section Entry - Timestamp to Hand to Prof_End
+#define Prof_Start()						((uint16_t)PROF_TIMER->CNT)
+
+/* Exported functions prototypes ---------------------------------------------*/
+void Prof_Init(void);
+void Prof_End(uint8_t, uint16_t);
+void Prof_Publish(void);
+
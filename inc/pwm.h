@@ -3,4 +3,6 @@
 
 void TIM14_Init(void);
 bool SetDutyCycle(uint8_t);
+void TIM14_EnableUpdateIT(void);
+void TIM14_DisableUpdateIT(void);
 
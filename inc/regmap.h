@@ -0,0 +1,158 @@
+
+
+//  Modbus Register Map. HoldRegs, InputRegs and the Descriptor Tables Used by
+//  the Modbus Handlers (One Entry per Register Number) are All Expanded From
+//  the Two Lists Below, so a Register is Added in One Place Only. The Default
+//  Column Initializes the Struct Members, and FlashRestoreDefaults() Restores
+//  From a Default Constructed HoldRegs.
+//
+//  X(Type, Name, Default, Validator)
+//    Type      - U16, U32 or F32. 32 Bit Values Take Two Registers, High Word
+//                First.
+//    Validator - bool Function(uint16_t) a Written Value Must Pass, or NULL.
+//
+//  List Order is Register Order and Also the Flash Record Layout - Append Only.
+
+#define UNSIGNED_INTEGER		1
+#define UNSIGNED_LONG				2
+#define FLOAT_VALUE					3
+
+#define REG_READ_ONLY				0
+#define REG_READ_WRITE			1
+
+#define REG_CTYPE_U16				uint16_t
+#define REG_CTYPE_U32				uint32_t
+#define REG_CTYPE_F32				float
+
+#define HOLDING_REGISTER_MAP(X) \
+	X(U16, model_number,           DEFAULT_MODEL_NUMBER,           NULL                   )	/* 4000 */ \
+	X(U16, mfg_data,               DEFAULT_MFG_DATA,               NULL                   ) \
+	X(U32, serial_number,          DEFAULT_SERIAL_NUMBER,          NULL                   ) \
+	X(U16, ops_flag,               DEFAULT_OPS_FLAG,               NULL                   ) \
+	X(U16, slave_address,          DEFAULT_SLAVE_ADDRESS,          Reg_Valid_Slave_Address) \
+	X(U16, baud_rate,              DEFAULT_BAUD_RATE,              Reg_Valid_Baud_Rate    ) \
+	X(U16, parity,                 DEFAULT_PARITY,                 NULL                   ) \
+	X(U16, sample_time,            DEFAULT_SAMPLE_TIME,            NULL                   ) \
+	X(U16, nadir_time,             DEFAULT_NADIR_TIME,             NULL                   ) \
+	X(U16, zenith_time,            DEFAULT_ZENITH_TIME,            NULL                   )	/* 4010 */ \
+	X(U16, cal_samples,            DEFAULT_CAL_SAMPLES,            NULL                   ) \
+	X(F32, temp_divisor,           DEFAULT_TEMP_DIVISOR,           NULL                   ) \
+	X(U16, co2_bound_limit_hi,     DEFAULT_CO2_BOUND_LIMIT_HI,     NULL                   ) \
+	X(U16, co2_bound_limit_lo,     DEFAULT_CO2_BOUND_LIMIT_LO,     NULL                   ) \
+	X(U16, zero_cal_target_ppm,    DEFAULT_ZERO_CAL_TARGET_PPM,    NULL                   ) \
+	X(F32, zero_cal_result,        DEFAULT_ZERO_CAL_RESULT,        NULL                   ) \
+	X(U16, span1_cal_target_ppm,   DEFAULT_SPAN1_CAL_TARGET_PPM,   NULL                   ) \
+	X(F32, span1_cal_result,       DEFAULT_SPAN1_CAL_RESULT,       NULL                   )	/* 4020 */ \
+	X(F32, span1_zero_ratio,       DEFAULT_SPAN1_ZERO_RATIO,       NULL                   ) \
+	X(U16, span2_cal_target_ppm,   DEFAULT_SPAN2_CAL_TARGET_PPM,   NULL                   ) \
+	X(F32, span2_cal_result,       DEFAULT_SPAN2_CAL_RESULT,       NULL                   ) \
+	X(F32, span2_zero_ratio,       DEFAULT_SPAN2_ZERO_RATIO,       NULL                   ) \
+	X(U16, sngpt_cal_target_ppm,   DEFAULT_SNGPT_CAL_TARGET_PPM,   NULL                   ) \
+	X(F32, tcor_factor,            DEFAULT_TCOR_FACTOR,            NULL                   )	/* 4030 */ \
+	X(F32, tcor1_coeff_x0,         DEFAULT_TCOR1_COEFF_X0,         NULL                   ) \
+	X(F32, tcor1_coeff_x1,         DEFAULT_TCOR1_COEFF_X1,         NULL                   ) \
+	X(F32, tcor1_coeff_x2,         DEFAULT_TCOR1_COEFF_X2,         NULL                   ) \
+	X(F32, tcor1_coeff_x3,         DEFAULT_TCOR1_COEFF_X3,         NULL                   ) \
+	X(F32, tcor2_coeff_x0,         DEFAULT_TCOR2_COEFF_X0,         NULL                   )	/* 4040 */ \
+	X(F32, tcor2_coeff_x1,         DEFAULT_TCOR2_COEFF_X1,         NULL                   ) \
+	X(F32, tcor2_coeff_x2,         DEFAULT_TCOR2_COEFF_X2,         NULL                   ) \
+	X(F32, tcor2_coeff_x3,         DEFAULT_TCOR2_COEFF_X3,         NULL                   ) \
+	X(F32, tcor3_coeff_x0,         DEFAULT_TCOR3_COEFF_X0,         NULL                   ) \
+	X(F32, tcor3_coeff_x1,         DEFAULT_TCOR3_COEFF_X1,         NULL                   )	/* 4050 */ \
+	X(F32, tcor3_coeff_x2,         DEFAULT_TCOR3_COEFF_X2,         NULL                   ) \
+	X(F32, tcor3_coeff_x3,         DEFAULT_TCOR3_COEFF_X3,         NULL                   ) \
+	X(F32, gas1_ppm_coeff_x0,      DEFAULT_GAS1_PPM_COEFF_X0,      NULL                   ) \
+	X(F32, gas1_ppm_coeff_x1,      DEFAULT_GAS1_PPM_COEFF_X1,      NULL                   ) \
+	X(F32, gas1_ppm_coeff_x2,      DEFAULT_GAS1_PPM_COEFF_X2,      NULL                   )	/* 4060 */ \
+	X(F32, gas1_ppm_coeff_x3,      DEFAULT_GAS1_PPM_COEFF_X3,      NULL                   ) \
+	X(F32, gas2_ppm_coeff_x0,      DEFAULT_GAS2_PPM_COEFF_X0,      NULL                   ) \
+	X(F32, gas2_ppm_coeff_x1,      DEFAULT_GAS2_PPM_COEFF_X1,      NULL                   ) \
+	X(F32, gas2_ppm_coeff_x2,      DEFAULT_GAS2_PPM_COEFF_X2,      NULL                   ) \
+	X(F32, gas2_ppm_coeff_x3,      DEFAULT_GAS2_PPM_COEFF_X3,      NULL                   )	/* 4070 */ \
+	X(F32, gas2_ppm_coeff_x4,      DEFAULT_GAS2_PPM_COEFF_X4,      NULL                   ) \
+	X(F32, gas2_ppm_coeff_x5,      DEFAULT_GAS2_PPM_COEFF_X5,      NULL                   ) \
+	X(F32, gas2_ppm_coeff_x6,      DEFAULT_GAS2_PPM_COEFF_X6,      NULL                   ) \
+	X(F32, gas2_ppm_coeff_x7,      DEFAULT_GAS2_PPM_COEFF_X7,      NULL                   ) \
+	X(U16, lamp_data_time_0,       DEFAULT_LAMP_DATA_TIME_0,       NULL                   )	/* 4080 */ \
+	X(U16, lamp_data_volt_0,       DEFAULT_LAMP_DATA_VOLT_0,       NULL                   ) \
+	X(U16, lamp_data_time_1,       DEFAULT_LAMP_DATA_TIME_1,       NULL                   ) \
+	X(U16, lamp_data_volt_1,       DEFAULT_LAMP_DATA_VOLT_1,       NULL                   ) \
+	X(U16, lamp_data_time_2,       DEFAULT_LAMP_DATA_TIME_2,       NULL                   ) \
+	X(U16, lamp_data_volt_2,       DEFAULT_LAMP_DATA_VOLT_2,       NULL                   ) \
+	X(F32, abc_correlation_factor, DEFAULT_ABC_CORRELATION_FACTOR, NULL                   ) \
+	X(U16, abc_sample_rate,        DEFAULT_ABC_SAMPLE_RATE,        NULL                   ) \
+	X(U16, abc_eval_count,         DEFAULT_ABC_EVAL_COUNT,         NULL                   ) \
+	X(U16, abc_sample_count,       DEFAULT_ABC_SAMPLE_COUNT,       NULL                   )	/* 4090 */ \
+	X(F32, dsp_alpha_coeff,        DEFAULT_DSP_ALPHA_COEFF,        NULL                   ) \
+	X(F32, dsp_adapt_coeff,        DEFAULT_DSP_ADAPT_COEFF,        NULL                   ) \
+	X(F32, dsp_adapt_bound,        DEFAULT_DSP_ADAPT_BOUND,        NULL                   ) \
+	X(U16, gas_ppm_upper_bound_1,  DEFAULT_GAS_UPPER_BOUND_1,      NULL                   ) \
+	X(U16, gas_ppm_upper_bound_2,  DEFAULT_GAS_UPPER_BOUND_2,      NULL                   ) \
+	X(F32, altitude,               DEFAULT_ALTITUDE,               NULL                   )	/* 4100 */ \
+	X(F32, cal_altitude,           DEFAULT_CAL_ALTITUDE,           NULL                   ) \
+	X(F32, pressure,               DEFAULT_PRESSURE,               NULL                   ) \
+	X(U16, warm_up_time,           DEFAULT_WARM_UP_TIME,           NULL                   ) \
+	X(U16, dac_ctrl,               DEFAULT_DAC_CTRL,               NULL                   ) \
+	X(F32, first_sample_cf,        DEFAULT_FIRST_SAMPLE_CF,        NULL                   ) \
+	X(U16, avg_ctrl,               DEFAULT_AVG_CTRL,               Reg_Valid_Avg_Ctrl     )	/* 4109 */
+
+#define INPUT_REGISTER_MAP(X) \
+	X(U16, update_count,       0,   NULL                   ) \
+	X(U16, firmware_revision,  132, NULL                   ) \
+	X(U16, status,             0,   NULL                   ) \
+	X(U16, gas_ppm,            0,   NULL                   ) \
+	X(U16, raw_sig,            0,   NULL                   ) \
+	X(F32, tcor_sig,           0,   NULL                   ) \
+	X(F32, norm_sig,           0,   NULL                   ) \
+	X(F32, norm_sig_avg,       0,   NULL                   ) \
+	X(F32, norm_sig_avg_alpha, 0,   NULL                   ) \
+	X(U16, nadir,              0,   NULL                   ) \
+	X(U16, zenith,             0,   NULL                   ) \
+	X(U16, temp_signal,        0,   NULL                   ) \
+	X(U16, v_lamp_plus,        0,   NULL                   ) \
+	X(U16, v_lamp_minus,       0,   NULL                   ) \
+	X(U16, vin_adc,            0,   NULL                   ) \
+	X(U16, co2_bound_value,    0,   NULL                   ) \
+	X(U16, prof_sections,      PROF_SECTION_COUNT, NULL    ) \
+	X(U16, prof_resolution_us, 1,   NULL                   ) \
+	X(U16, rt_ops_flag,        0,   NULL                   ) \
+	X(U32, up_time,            0,   NULL                   ) \
+	X(U16, flash_erase_time,   0,   NULL                   ) \
+	X(U16, flash_erase_max,    0,   NULL                   ) \
+	X(U32, flash_erase_count,  0,   NULL                   ) \
+	PROF_SECTION_LIST(PROF_INPUT_REGS, X)
+
+//  Expands a List Entry to a Struct Member Initialized to its Default
+#define REG_MEMBER(Type, Name, Default, Validator)		REG_CTYPE_##Type Name = Default;
+
+typedef bool (*RegValidator)(uint16_t);
+
+typedef struct
+{
+	uint16_t uiOffset;						//  Byte Offset of This Register's 16 Bits in the Struct
+	uint8_t ucType;								//  UNSIGNED_INTEGER, UNSIGNED_LONG or FLOAT_VALUE
+	uint8_t ucAccess;							//  REG_READ_ONLY or REG_READ_WRITE
+	RegValidator pValidate;
+} RegDesc;
+
+//  One per Holding Register Value, Whatever its Width - the Journal Key
+typedef struct
+{
+	uint16_t uiOffset;						//  Byte Offset of the Value in HoldRegs
+	uint8_t ucSize;								//  2 or 4 Bytes
+} RegField;
+
+bool Reg_Valid_Slave_Address(uint16_t);
+bool Reg_Valid_Baud_Rate(uint16_t);
+bool Reg_Valid_Avg_Ctrl(uint16_t);
+
+extern const RegDesc sHRegMap[];
+extern const RegDesc sIRegMap[];
+extern const uint16_t uiHRegCount;
+extern const uint16_t uiIRegCount;
+extern const uint16_t uiHRegRecordSize;
+extern const RegField sHRegFields[];
+extern const uint16_t uiHRegFieldCount;
+
+
+
@@ -0,0 +1,51 @@
+//  Tasks in Priority Order - When Several are Ready the Lowest Number Runs First
+enum SCHED_TASK
+{
+  TASK_MODBUS = 0,							//  Received Frame Waiting in RxBuff
+  TASK_GAS_DAQ,									//  Measurement Cycle Sequencing, 10 mS
+  TASK_COMM_TIMEOUT,						//  Transmit Cleanup if TC Never Comes
+  TASK_1S,											//  Up Time, Flash Commit, Watchdog
+  TASK_ROBUST,									//  Periodic Peripheral Re-Init
+  SCHED_TASK_COUNT
+};
+
+enum TASK_STATE
+{
+  TASK_WAITING = 0,
+  TASK_READY,
+  TASK_RUNNING
+};
+
+//  Events (One Bit Each) Posted to a Task
+#define EVT_TIMER								0x0001	//  Task Delay Expired
+#define EVT_MODBUS_FRAME				0x0002	//  USART Receiver Timeout Ended a Frame for Us
+#define EVT_GAS_DAQ_COMPLETE		0x0004	//  Zenith Burst Finished
+
+#define COMM_TIMEOUT_MS					5u			//  Transmit Cleanup Delay
+
+typedef void (*TaskFunc)(uint16_t);		//  Called With the Events That Made it Ready
+
+typedef struct
+{
+	TaskFunc pTask;
+	uint16_t uiPeriod;							//  mS Between Runs, 0 = Only When Delayed/Posted
+	uint16_t uiEventMask;						//  Events That Make the Task Ready
+	volatile uint16_t uiDelay;			//  mS Until EVT_TIMER, 0 = Stopped
+	volatile uint16_t uiEvents;			//  Posted, Not Yet Handled
+	volatile uint8_t ucState;
+} Tcb;
+
+/* Exported functions prototypes ---------------------------------------------*/
+void Sched_Init(void);
+__NO_RETURN void Sched_Run(void);
+void Sched_Tick(void);
+void Sched_Post(uint8_t, uint16_t);
+void Sched_Delay(uint8_t, uint16_t);
+void Sched_Advance(uint16_t);
+uint16_t Sched_NextDelay(void);
+
+extern Tcb sTasks[SCHED_TASK_COUNT];
+extern volatile uint16_t uiSchedReady;
+
+
+
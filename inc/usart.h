@@ -3,22 +3,37 @@
 
 #define BUFFER_SIZE	128
 
+//  Modbus RTU Frame Timing (Receiver Timeout is Counted in Bit Times)
+#define MODBUS_BITS_PER_CHAR		11			//  Start + 8 Data + Parity + Stop
+#define MODBUS_FIXED_T35_BAUD		19200u	//  Above This t3.5 is Fixed at 1750 uS
+#define MODBUS_FIXED_T35_US			1750u
+
+#define TX_DMA_CHANNEL					LL_DMA_CHANNEL_2	//  Shared by USART1 and I2C1 Transmit
+#define RX_DMA_CHANNEL					LL_DMA_CHANNEL_3	//  USART1 Receive, Circular
+#define RX_RING_SIZE						256				//  Power of 2
+
 //  Exported Variables
 typedef struct{
-	uint16_t Buff[BUFFER_SIZE];
-	uint16_t end;
-	uint16_t ptr;
+	uint8_t Buff[BUFFER_SIZE];			//  One Frame Byte per Element
+	uint16_t end;										//  Bytes in Frame
+	uint16_t ptr;										//  Next Byte to Send
 } Buffer;
 
 //  Exported functions prototypes
 void USART1_Init(void);
-void USART1_CharReception_Callback(void);
-void USART1_SendMessage(void);
+void USART1_SendMessage(Buffer &);
+void USART1_TxComplete_Callback(void);
 void USART1_Error_Callback(void);
+void USART1_RxTimeout_Callback(void);
+void USART1_Address_Callback(void);
+uint32_t USART1_GetBaudRate(void);
+void TX_DMA_Init(uint32_t, uint32_t);
+void TX_DMA_Start(const Buffer &);
+void TX_DMA_Error_Callback(void);
+void RX_DMA_Error_Callback(void);
 //uint16_t Calc_crc(Buffer, uint16_t);
 
 extern Buffer RxBuff;
 extern Buffer TxBuff;
-extern uint8_t ucCommTimeout;
 extern uint16_t uiCommit_Timer;
 
@@ -127,23 +127,7 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
 	ulTicks ++;
-	uiIntFlags.bTick_1mS = 1;
-  if(++ucTick_10mS_acc >= 10)
-  {
-		uiIntFlags.bTick_10mS = 1;
-	  ucTick_10mS_acc = 0;
-  }
-  if(++uiTick_1S_acc >= 1000)
-  {
-		uiIntFlags.bTick_1S = 1;
-    uiTick_1S_acc = 0;
-
-    uiTick_1S_Ctr ++;
-    if(!(uiTick_1S_Ctr & 0x0f))
-    {
-			uiIntFlags.bRobust = 1;
-    }
-  }
+	Sched_Tick();
 }
 
 /******************************************************************************/
@@ -153,6 +137,36 @@ void SysTick_Handler(void)
 /* please refer to the startup file (startup_stm32c0xx.s).                    */
 /******************************************************************************/
 
+/**
+  * @brief This function handles Flash global interrupt.
+  */
+void FLASH_IRQHandler(void)
+{
+	uint16_t uiStart = Prof_Start();
+
+	if(READ_BIT(FLASH->SR, FLASH_SR_ERRORS))
+	{
+		Flash_Error_Callback();
+	}
+	else if(READ_BIT(FLASH->SR, FLASH_SR_EOP))
+	{
+		WRITE_REG(FLASH->SR, FLASH_SR_EOP);
+		Flash_EOP_Callback();
+	}
+	Prof_End(PROF_ISR_FLASH, uiStart);
+}
+
+/**
+  * @brief This function handles RTC interrupt through EXTI line 19.
+  */
+void RTC_IRQHandler(void)
+{
+	if(LL_RTC_IsActiveFlag_ALRA(RTC))
+	{
+		RTC_Alarm_Callback();
+	}
+}
+
 /**
   * @brief This function handles EXTI line 4 to 15 interrupts.
   */
@@ -176,6 +190,7 @@ void EXTI4_15_IRQHandler(void)
 void USART1_IRQHandler(void)
 {
   volatile uint32_t isr_reg;
+	uint16_t uiStart = Prof_Start();
 	
   /* USER CODE BEGIN USART1_IRQn 0 */
   isr_reg = LL_USART_ReadReg(USART1, ISR);
@@ -202,21 +217,25 @@ void USART1_IRQHandler(void)
 		}
 	}
 
-  /* Check RXNE flag value in ISR register */
-  if (LL_USART_IsActiveFlag_RXNE(USART1) && LL_USART_IsEnabledIT_RXNE(USART1))
+  /* Address Byte Only; the Rest of an Addressed Frame Goes to Memory by DMA */
+  if (LL_USART_IsActiveFlag_RXNE_RXFNE(USART1) && LL_USART_IsEnabledIT_RXNE_RXFNE(USART1))
   {
-    /* RXNE flag will be cleared by reading of RDR register (done in call) */
-    /* Call function in charge of handling Character reception */
-    USART1_CharReception_Callback();
+    USART1_Address_Callback();
   }
+	else if(LL_USART_IsActiveFlag_RTO(USART1) && LL_USART_IsEnabledIT_RTO(USART1))
+	{
+		LL_USART_ClearFlag_RTO(USART1);
+		USART1_RxTimeout_Callback();			//  t3.5 Silence, End of Frame
+	}
 	else if(LL_USART_IsActiveFlag_TC(USART1))
 	{
-		USART1_SendMessage();
+		USART1_TxComplete_Callback();		//  Last Byte of DMA Transfer Sent
 	}
   else
 	{
 		USART1_Error_Callback();		//  Cleanup
 	}
+	Prof_End(PROF_ISR_USART, uiStart);
 }
 
 /**
@@ -238,8 +257,8 @@ void I2C1_IRQHandler(void)
         /* Clear ADDR flag value in ISR register */
         LL_I2C_ClearFlag_ADDR(I2C1);
 
-        /* Enable Transmit Interrupt */
-        LL_I2C_EnableIT_TX(I2C1);
+        /* Start DMA Transmit of the Response */
+        I2C_SendMessage(TxBuff);
       }
       else
       {
@@ -282,9 +301,12 @@ void I2C1_IRQHandler(void)
   /* Check TXIS flag value in ISR register */
   else if (LL_I2C_IsActiveFlag_TXIS(I2C1))
   {
-    /* Call function Slave Ready to Transmit Callback */
+    /* Master Reading Past the End of the Response (DMA Done) - Pad */
 //    Slave_Ready_To_Transmit_Callback();
-		I2C_SendMessage();
+		if(LL_DMA_GetDataLength(DMA1, TX_DMA_CHANNEL) == 0)
+		{
+			LL_I2C_TransmitData8(I2C1, 0xff);
+		}
   }
   /* Check STOP flag value in ISR register */
   else if (LL_I2C_IsActiveFlag_STOP(I2C1))
@@ -292,6 +314,7 @@ void I2C1_IRQHandler(void)
     /* Clear STOP flag value in ISR register */
     LL_I2C_ClearFlag_STOP(I2C1);
 		uiFlags.bI2C_RcvInProcess = false;
+		I2C_TxComplete_Callback();
 //		Handle_Rcvd_Msg();
 //  	LL_I2C_HandleTransfer(I2C1, sHRegs.slave_address, LL_I2C_ADDRSLAVE_7BIT, 1, LL_I2C_MODE_AUTOEND, LL_I2C_GENERATE_START_READ);
 		
@@ -390,3 +413,67 @@ void ADC1_IRQHandler(void)
     LL_ADC_ClearFlag_OVR(ADC1);
   }
 }
+
+/**
+  * @brief  This function handles DMA1 Channel 1 interrupt request (ADC scans).
+  * @param  None
+  * @retval None
+  */
+void DMA1_Channel1_IRQHandler(void)
+{
+	uint16_t uiStart = Prof_Start();
+
+  if(LL_DMA_IsActiveFlag_HT1(DMA1) != 0)
+  {
+    LL_DMA_ClearFlag_HT1(DMA1);
+    ADC_Scan_Complete_Callback(0);
+  }
+  if(LL_DMA_IsActiveFlag_TC1(DMA1) != 0)
+  {
+    LL_DMA_ClearFlag_TC1(DMA1);
+    ADC_Scan_Complete_Callback(1);
+  }
+  if(LL_DMA_IsActiveFlag_TE1(DMA1) != 0)
+  {
+    LL_DMA_ClearFlag_TE1(DMA1);
+  }
+	Prof_End(PROF_ISR_ADC_DMA, uiStart);
+}
+
+/**
+  * @brief  This function handles DMA1 Channel 2 and 3 interrupt request.
+  *         Channel 2 is the USART1/I2C1 Transmit DMA, Channel 3 the USART1
+  *         Receive Ring.
+  * @param  None
+  * @retval None
+  */
+void DMA1_Channel2_3_IRQHandler(void)
+{
+  if(LL_DMA_IsActiveFlag_TE2(DMA1) != 0)
+  {
+    LL_DMA_ClearFlag_TE2(DMA1);
+    TX_DMA_Error_Callback();
+  }
+  if(LL_DMA_IsActiveFlag_TE3(DMA1) != 0)
+  {
+    LL_DMA_ClearFlag_TE3(DMA1);
+    RX_DMA_Error_Callback();
+  }
+}
+
+/**
+  * @brief  This function handles TIM14 interrupt request (lamp PWM update).
+  * @param  None
+  * @retval None
+  */
+void TIM14_IRQHandler(void)
+{
+	uint16_t uiStart = Prof_Start();
+
+  if(LL_TIM_IsActiveFlag_UPDATE(TIM14) != 0)
+  {
+    LL_TIM_ClearFlag_UPDATE(TIM14);
+    gas_daq_lamp_callback();
+  }
+	Prof_End(PROF_ISR_LAMP, uiStart);
+}
@@ -0,0 +1,292 @@
+
+#include "main.h"
+
+#if defined(__ICCARM__)
+//  Keep the Linker Out of the Sample Ring
+#pragma location = ABC_RING_BASE
+__root __no_init const uint8_t ucAbcRingPages[ABC_RING_PAGES * FLASH_PAGE_BYTES];
+#endif
+
+//  Rolling Maximum - Monotonic Deque, Values Falling From Front to Back, so
+//  the Front is Always the Peak of the Window
+typedef struct
+{
+	float fSignal;
+	uint16_t uiSeq;
+} AbcSample;
+
+static AbcSample sAbcDeque[ABC_MAX_SAMPLE_COUNT];
+static uint8_t ucAbcFront;
+static uint8_t ucAbcCount;
+static uint16_t uiAbcWindow;									//  Samples the Deque Spans
+
+static uint16_t uiAbcNext;										//  Ring Position of the Next Entry
+static uint16_t uiAbcSeq;											//  Sample Number of the Next Entry
+static uint16_t uiAbcSamples;									//  Since the Last Evaluation
+static uint32_t ulAbcPeriodStart;							//  ulTicks at the Start of the Period
+static float fAbcPeak;												//  Highest Signal so Far This Period
+static bool bAbcPeak;													//  fAbcPeak Holds a Value
+static bool bAbcPending;											//  Sample Waiting for Room in the Flash Queue
+static bool bAbcErased;												//  Erase of the Next Entry's Page Already Queued
+static uint64_t ullAbcEntry;									//  Entry Being Programmed
+
+static void Abc_Rebuild(void);
+static void Abc_Push(float, uint16_t);
+static bool Abc_Append(void);
+static void Abc_Evaluate(void);
+static bool Abc_EntryValid(const AbcEntry *);
+static uint16_t Abc_PageEnd(uint32_t);
+
+/**
+  * @brief  Find the End of the Sample Ring (a Binary Search of Each Page) and
+  *         Rebuild the Rolling Maximum From the Samples Inside the Window.
+  *         Call After the Holding Registers are Restored.
+  * @param  None
+  * @retval None
+  */
+void Abc_Init(void)
+{
+	const AbcEntry *pRing = (const AbcEntry*)ABC_RING_BASE;
+	uint16_t uiEnd[ABC_RING_PAGES];
+	uint16_t uiPage, uiLast;
+	bool bFound = false;
+
+	uiAbcNext = 0;
+	uiAbcSeq = 0;
+	for(uiPage = 0; uiPage < ABC_RING_PAGES; uiPage ++)
+	{
+		uiEnd[uiPage] = Abc_PageEnd(ABC_RING_BASE + uiPage * FLASH_PAGE_BYTES);
+		if(uiEnd[uiPage] == 0)
+		{
+			continue;
+		}
+		uiLast = uiPage * ABC_PAGE_ENTRIES + uiEnd[uiPage] - 1u;
+		if(!bFound || ((int16_t)(pRing[uiLast].uiSeq - uiAbcSeq) >= 0))
+		{
+			bFound = true;
+			uiAbcSeq = pRing[uiLast].uiSeq + 1u;				//  Newest Page So Far
+			uiAbcNext = (uiLast + 1u) % ABC_RING_ENTRIES;
+		}
+	}
+
+	Abc_Rebuild();
+	ulAbcPeriodStart = ulTicks;
+}
+
+/**
+  * @brief  Track the Peak Signal of the Period. Called With Each New
+  *         norm_sig_avg Once Warmed Up.
+  * @param  fSignal - norm_sig_avg
+  * @retval None
+  */
+void Abc_Update(float fSignal)
+{
+	if(!bAbcPeak || (fSignal > fAbcPeak))
+	{
+		fAbcPeak = fSignal;
+		bAbcPeak = true;
+	}
+}
+
+/**
+  * @brief  Once a Second: at the End of Each abc_sample_rate Hour Period the
+  *         Period's Peak is Appended to the Ring and Pushed Into the Rolling
+  *         Maximum, and Every abc_eval_count Samples the Maximum Becomes
+  *         abc_correlation_factor. An abc_sample_rate of 0 Turns ABC Off.
+  * @param  None
+  * @retval None
+  */
+void Abc_Tick_1S(void)
+{
+	uint32_t ulRate = sHRegs.abc_sample_rate;
+	AbcEntry *pEntry = (AbcEntry*)&ullAbcEntry;
+
+	if(ulRate == 0)
+	{
+		ulAbcPeriodStart = ulTicks;
+		bAbcPeak = false;
+		return;
+	}
+	if(ulRate > ABC_MAX_SAMPLE_RATE)
+	{
+		ulRate = ABC_MAX_SAMPLE_RATE;
+	}
+	if(uiAbcWindow != ((sHRegs.abc_sample_count < ABC_MAX_SAMPLE_COUNT) ? sHRegs.abc_sample_count : ABC_MAX_SAMPLE_COUNT))
+	{
+		Abc_Rebuild();															//  Look Back Changed
+	}
+
+	if(!bAbcPending && ((ulTicks - ulAbcPeriodStart) >= ulRate * ABC_MS_PER_HOUR))
+	{
+		ulAbcPeriodStart = ulTicks;
+		if(bAbcPeak)
+		{
+			pEntry->fSignal = fAbcPeak;
+			pEntry->uiSeq = uiAbcSeq;
+			pEntry->uiCRC = Flash_CRC((uint8_t*)pEntry, ABC_ENTRY_CRC_BYTES);
+			bAbcPeak = false;
+			bAbcPending = true;
+		}
+	}
+
+	if(bAbcPending && Abc_Append())
+	{
+		bAbcPending = false;
+		Abc_Push(pEntry->fSignal, pEntry->uiSeq);
+		uiAbcSeq ++;
+		if(++uiAbcSamples >= sHRegs.abc_eval_count)
+		{
+			Abc_Evaluate();
+		}
+	}
+}
+
+/**
+  * @brief  Refill the Deque From the Last uiAbcWindow Entries of the Ring.
+  * @param  None
+  * @retval None
+  */
+static void Abc_Rebuild(void)
+{
+	const AbcEntry *pRing = (const AbcEntry*)ABC_RING_BASE;
+	const AbcEntry *pEntry;
+	uint16_t i;
+
+	uiAbcWindow = (sHRegs.abc_sample_count < ABC_MAX_SAMPLE_COUNT) ? sHRegs.abc_sample_count : ABC_MAX_SAMPLE_COUNT;
+	ucAbcFront = 0;
+	ucAbcCount = 0;
+	for(i = uiAbcWindow; i > 0; i --)
+	{
+		pEntry = &pRing[(uiAbcNext + ABC_RING_ENTRIES - i) % ABC_RING_ENTRIES];
+		if(Abc_EntryValid(pEntry))
+		{
+			Abc_Push(pEntry->fSignal, pEntry->uiSeq);
+		}
+	}
+}
+
+/**
+  * @brief  Add the Newest Sample: Drop From the Front What Has Left the
+  *         Window, and From the Back Everything it Outranks. Amortized O(1).
+  * @param  fSignal - Period Peak
+  * @param  uiSeq - its Sample Number
+  * @retval None
+  */
+static void Abc_Push(float fSignal, uint16_t uiSeq)
+{
+	AbcSample *pBack;
+
+	while(ucAbcCount && ((uint16_t)(uiSeq - sAbcDeque[ucAbcFront].uiSeq) >= uiAbcWindow))
+	{
+		ucAbcFront = (ucAbcFront + 1u) % ABC_MAX_SAMPLE_COUNT;
+		ucAbcCount --;
+	}
+	while(ucAbcCount &&
+				(sAbcDeque[(ucAbcFront + ucAbcCount - 1u) % ABC_MAX_SAMPLE_COUNT].fSignal <= fSignal))
+	{
+		ucAbcCount --;
+	}
+	if(uiAbcWindow == 0)
+	{
+		return;
+	}
+	pBack = &sAbcDeque[(ucAbcFront + ucAbcCount) % ABC_MAX_SAMPLE_COUNT];
+	pBack->fSignal = fSignal;
+	pBack->uiSeq = uiSeq;
+	ucAbcCount ++;
+}
+
+/**
+  * @brief  Queue the Pending Entry at the End of the Ring, Erasing the Page
+  *         First When Starting a New One (its Samples Are Older Than any
+  *         Window). Returns at Once. If Only the Erase Fits in the Queue, the
+  *         Retry Queues Just the Program, so the Page is Not Erased Again.
+  * @param  None
+  * @retval false if the Flash Queue is Full - Retry Next Second
+  */
+static bool Abc_Append(void)
+{
+	uint32_t ulAddress = ABC_RING_BASE + (uint32_t)uiAbcNext * sizeof(AbcEntry);
+
+	if(((uiAbcNext % ABC_PAGE_ENTRIES) == 0) && !bAbcErased)
+	{
+		if(!FlashQueueErase(ulAddress, NULL))
+		{
+			return false;
+		}
+		bAbcErased = true;
+	}
+	if(!FlashQueueProgram(ulAddress, (const uint8_t*)&ullAbcEntry, sizeof(AbcEntry), NULL))
+	{
+		return false;
+	}
+	bAbcErased = false;
+	uiAbcNext = (uiAbcNext + 1u) % ABC_RING_ENTRIES;
+	return true;
+}
+
+/**
+  * @brief  Make the Window's Peak the New Correlation Factor, Reload the DSP
+  *         and Save it (One Journal Entry).
+  * @param  None
+  * @retval None
+  */
+static void Abc_Evaluate(void)
+{
+	float fFactor;
+
+	uiAbcSamples = 0;
+	if(ucAbcCount == 0)
+	{
+		return;
+	}
+	fFactor = sAbcDeque[ucAbcFront].fSignal;
+	if((fFactor < ABC_FACTOR_MIN) || (fFactor > ABC_FACTOR_MAX) || (fFactor == sHRegs.abc_correlation_factor))
+	{
+		return;
+	}
+	sHRegs.abc_correlation_factor = fFactor;
+	uiFlags.bDSP_Reload = true;
+	uiFlags.bFlashCommitInProcess = true;
+	uiCommit_Timer = 0;
+}
+
+/**
+  * @brief  A Ring Entry is Valid When its CRC Checks. A Blank (Erased) Entry
+  *         is Never Valid.
+  * @param  pEntry - Entry in Flash
+  * @retval true if Valid
+  */
+static bool Abc_EntryValid(const AbcEntry *pEntry)
+{
+	return (pEntry->uiCRC != 0xffff) &&
+				 (Flash_CRC((uint8_t*)pEntry, ABC_ENTRY_CRC_BYTES + 2) == 0);
+}
+
+/**
+  * @brief  Binary Search a Ring Page for its First Blank Entry; Entries Are
+  *         Only Programmed in Order, so Blanks Form the Tail.
+  * @param  ulPage - Page Address
+  * @retval Entries Used, ABC_PAGE_ENTRIES if Full
+  */
+static uint16_t Abc_PageEnd(uint32_t ulPage)
+{
+	const uint32_t *pWords = (const uint32_t*)ulPage;
+	uint16_t uiLow = 0;
+	uint16_t uiHigh = ABC_PAGE_ENTRIES;
+	uint16_t uiMid;
+
+	while(uiLow < uiHigh)
+	{
+		uiMid = (uiLow + uiHigh) / 2u;
+		if((pWords[uiMid * 2u] == 0xffffffff) && (pWords[uiMid * 2u + 1u] == 0xffffffff))
+		{
+			uiHigh = uiMid;
+		}
+		else
+		{
+			uiLow = uiMid + 1u;
+		}
+	}
+	return uiLow;
+}
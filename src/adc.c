@@ -30,6 +30,9 @@ uint16_t uiADC_VLamp_Plus_Reading;
 uint16_t uiADC_VLamp_Minus_Reading;
 uint16_t uiADC_Config_Reading;
 
+volatile uint16_t uiADC_ScanBuff[ADC_SCAN_BLOCKS][ADC_SCAN_LENGTH];		//  DMA Target, Scan Blocks Back to Back
+volatile uint16_t *puiADC_ScanResult;										//  Last Completed Block
+
 
 /**
   * @brief ADC1 Initialization Function
@@ -40,6 +43,7 @@ void ADC1_Init(void)
 {
   LL_ADC_InitTypeDef ADC_InitStruct = {0};
   LL_ADC_REG_InitTypeDef ADC_REG_InitStruct = {0};
+  __IO uint32_t wait_loop_index = 0U;
 
   LL_RCC_SetADCClockSource(LL_RCC_ADC_CLKSOURCE_SYSCLK);
 
@@ -49,7 +53,7 @@ void ADC1_Init(void)
   // ADC1 interrupt Init
   NVIC_SetPriority(ADC1_IRQn, 2);
   NVIC_EnableIRQ(ADC1_IRQn);
-  LL_ADC_EnableIT_EOC(ADC1);
+  LL_ADC_EnableIT_OVR(ADC1);									//  Results Moved by DMA, Only Overrun Interrupts
 
   /** Configure the global features of the ADC (Clock, Resolution, Data Alignment and number of conversion)
   */
@@ -58,15 +62,35 @@ void ADC1_Init(void)
   ADC_InitStruct.DataAlignment = LL_ADC_DATA_ALIGN_RIGHT;
   ADC_InitStruct.LowPowerMode = LL_ADC_LP_MODE_NONE;
   LL_ADC_Init(ADC1, &ADC_InitStruct);
-  LL_ADC_REG_SetSequencerConfigurable(ADC1, LL_ADC_REG_SEQ_FIXED);
-	
-	ADC_REG_InitStruct.TriggerSource = LL_ADC_REG_TRIG_SOFTWARE;
-	ADC_REG_InitStruct.SequencerLength = LL_ADC_REG_SEQ_SCAN_DISABLE;
-	ADC_REG_InitStruct.SequencerDiscont = LL_ADC_REG_SEQ_DISCONT_DISABLE;
-	ADC_REG_InitStruct.ContinuousMode = LL_ADC_REG_CONV_SINGLE;
-	ADC_REG_InitStruct.DMATransfer = LL_ADC_REG_DMA_TRANSFER_NONE;
-	ADC_REG_InitStruct.Overrun = LL_ADC_REG_OVR_DATA_OVERWRITTEN;
-	LL_ADC_REG_Init(ADC1, &ADC_REG_InitStruct);
+
+	//  Sequencer Can Only be Reconfigured With the ADC Disabled (Robust Routine Leaves it Running)
+	if(LL_ADC_IsEnabled(ADC1) == 0)
+	{
+	  LL_ADC_REG_SetSequencerConfigurable(ADC1, LL_ADC_REG_SEQ_CONFIGURABLE);
+
+		ADC_REG_InitStruct.TriggerSource = LL_ADC_REG_TRIG_EXT_TIM3_TRGO;
+		ADC_REG_InitStruct.SequencerLength = LL_ADC_REG_SEQ_SCAN_ENABLE_6RANKS;
+		ADC_REG_InitStruct.SequencerDiscont = LL_ADC_REG_SEQ_DISCONT_DISABLE;
+		ADC_REG_InitStruct.ContinuousMode = LL_ADC_REG_CONV_SINGLE;
+		ADC_REG_InitStruct.DMATransfer = LL_ADC_REG_DMA_TRANSFER_UNLIMITED;
+		ADC_REG_InitStruct.Overrun = LL_ADC_REG_OVR_DATA_OVERWRITTEN;
+		LL_ADC_REG_Init(ADC1, &ADC_REG_InitStruct);
+
+		//  Scan Order Must Match enum ADC_SCAN_RANK
+		LL_ADC_REG_SetSequencerRanks(ADC1, LL_ADC_REG_RANK_1, LL_ADC_CHANNEL_8);		//  Gas Signal
+		LL_ADC_REG_SetSequencerRanks(ADC1, LL_ADC_REG_RANK_2, LL_ADC_CHANNEL_9);		//  Temp Signal
+		LL_ADC_REG_SetSequencerRanks(ADC1, LL_ADC_REG_RANK_3, LL_ADC_CHANNEL_1);		//  VIN
+		LL_ADC_REG_SetSequencerRanks(ADC1, LL_ADC_REG_RANK_4, LL_ADC_CHANNEL_7);		//  V_Lamp+
+		LL_ADC_REG_SetSequencerRanks(ADC1, LL_ADC_REG_RANK_5, LL_ADC_CHANNEL_5);		//  V_Lamp-
+		LL_ADC_REG_SetSequencerRanks(ADC1, LL_ADC_REG_RANK_6, LL_ADC_CHANNEL_0);		//  IO Config
+
+		wait_loop_index = 1000u;
+		while((LL_ADC_IsActiveFlag_CCRDY(ADC1) == 0) && (wait_loop_index != 0))
+		{
+			wait_loop_index--;
+		}
+		LL_ADC_ClearFlag_CCRDY(ADC1);
+	}
 
 	// Enable ADC Internal Voltage Regulator & ADC
 	LL_ADC_EnableInternalRegulator(ADC1);				//  For Robust Routine
@@ -145,18 +169,148 @@ void AdcGrpRegularOverrunError_Callback(void)
   Error_Handler();
 }
 
-uint16_t ADC_Measure(uint8_t ucChannel)
+/**
+  * @brief  Setup the Scan Engine - TIM3 Paces the Scans, DMA Channel 1 Moves
+  *         Each Scan into the Double Buffer Without CPU Involvement.
+  * @note   Must Follow ADC1_Activate() as Calibration Suspends DMA Requests.
+  * @param  None
+  * @retval None
+  */
+void ADC_Scan_Init(void)
 {
-	uint16_t result = 0;
-	
-	ADC1->CHSELR = (1 << ucChannel);
-	SET_BIT(ADC1->CR, ADC_CR_ADSTART);
-	while((ADC1->ISR & ADC_ISR_EOS) == 0)
+  LL_TIM_InitTypeDef TIM_InitStruct = {0};
+
+	//  TIM3 - 1 MHz Count, Update Event Routed to TRGO to Trigger the ADC
+  LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_TIM3);
+
+  TIM_InitStruct.Prescaler = __LL_TIM_CALC_PSC(SystemCoreClock, 1000000);
+  TIM_InitStruct.CounterMode = LL_TIM_COUNTERMODE_UP;
+  TIM_InitStruct.Autoreload = ADC_SCAN_PERIOD_US - 1u;
+  TIM_InitStruct.ClockDivision = LL_TIM_CLOCKDIVISION_DIV1;
+  LL_TIM_Init(TIM3, &TIM_InitStruct);
+  LL_TIM_DisableARRPreload(TIM3);
+  LL_TIM_SetTriggerOutput(TIM3, LL_TIM_TRGO_UPDATE);
+  LL_TIM_DisableMasterSlaveMode(TIM3);
+
+	//  DMA1 Channel 1 - ADC Data Register to Scan Buffer, Circular Over Both Blocks
+  LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+
+  NVIC_SetPriority(DMA1_Channel1_IRQn, 2);
+  NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+
+  LL_DMA_DisableChannel(DMA1, LL_DMA_CHANNEL_1);
+  LL_DMA_SetPeriphRequest(DMA1, LL_DMA_CHANNEL_1, LL_DMAMUX_REQ_ADC1);
+  LL_DMA_ConfigTransfer(DMA1, LL_DMA_CHANNEL_1,
+                        LL_DMA_DIRECTION_PERIPH_TO_MEMORY |
+                        LL_DMA_MODE_CIRCULAR |
+                        LL_DMA_PERIPH_NOINCREMENT |
+                        LL_DMA_MEMORY_INCREMENT |
+                        LL_DMA_PDATAALIGN_HALFWORD |
+                        LL_DMA_MDATAALIGN_HALFWORD |
+                        LL_DMA_PRIORITY_HIGH);
+  LL_DMA_ConfigAddresses(DMA1, LL_DMA_CHANNEL_1,
+                         LL_ADC_DMA_GetRegAddr(ADC1, LL_ADC_DMA_REG_REGULAR_DATA),
+                         (uint32_t)(uintptr_t)&uiADC_ScanBuff[0][0],
+                         LL_DMA_DIRECTION_PERIPH_TO_MEMORY);
+  LL_DMA_SetDataLength(DMA1, LL_DMA_CHANNEL_1, ADC_SCAN_BLOCKS * ADC_SCAN_LENGTH);
+  LL_DMA_EnableIT_HT(DMA1, LL_DMA_CHANNEL_1);			//  Half Transfer = Block 0 Complete
+  LL_DMA_EnableIT_TC(DMA1, LL_DMA_CHANNEL_1);			//  Transfer Complete = Block 1 Complete
+  LL_DMA_EnableIT_TE(DMA1, LL_DMA_CHANNEL_1);
+  LL_DMA_EnableChannel(DMA1, LL_DMA_CHANNEL_1);
+
+	puiADC_ScanResult = uiADC_ScanBuff[0];
+	uiIntFlags.bADC_ScanReady = false;
+}
+
+/**
+  * @brief  Start Timer Paced Scans. The First Scan Completes One Trigger
+  *         Period Later and Every Period After That Until Stopped.
+  * @param  None
+  * @retval None
+  */
+void ADC_Scan_Start(void)
+{
+	if(LL_ADC_REG_IsConversionOngoing(ADC1) == 0)
 	{
-		;
+		LL_ADC_REG_StartConversion(ADC1);			//  Arm - Conversions Wait for TIM3 TRGO
 	}
-	ADC1->ISR &= ~0x01;
-	result = ADC1->DR;
-	
-	return result;
+	LL_TIM_SetCounter(TIM3, 0);
+	LL_TIM_EnableCounter(TIM3);
+}
+
+/**
+  * @brief  Stop Issuing Triggers. A Scan Already Triggered Still Completes.
+  * @param  None
+  * @retval None
+  */
+void ADC_Scan_Stop(void)
+{
+	LL_TIM_DisableCounter(TIM3);
+}
+
+/**
+  * @brief  Set the Hardware Oversampler so Each Conversion in a Scan is the
+  *         Average of uiSamples Back to Back Conversions (Rounded Down to a
+  *         Power of 2, 2 to 256; Fewer Turns it Off). The Sum is Shifted
+  *         Back to 12 Bits, so Results Keep Their Scale. The ADC Must be
+  *         Disabled to Change it, so Only Call Between Bursts.
+  * @param  uiSamples - Conversions per Result
+  * @retval None
+  */
+void ADC_Set_Oversampling(uint16_t uiSamples)
+{
+	static uint8_t ucCurrentLog2 = 0xff;				//  Unknown Until First Set
+	uint8_t ucLog2 = 0;
+
+	while((ucLog2 < ADC_OVS_MAX_LOG2) && ((2u << ucLog2) <= uiSamples))
+	{
+		ucLog2 ++;
+	}
+	if(ucLog2 == ucCurrentLog2)
+	{
+		return;
+	}
+
+	if(LL_ADC_REG_IsConversionOngoing(ADC1))
+	{
+		LL_ADC_REG_StopConversion(ADC1);				//  Armed by ADC_Scan_Start
+		while(LL_ADC_REG_IsStopConversionOngoing(ADC1))
+		{
+		}
+	}
+	LL_ADC_Disable(ADC1);
+	while(LL_ADC_IsEnabled(ADC1))
+	{
+	}
+
+	if(ucLog2 == 0)
+	{
+		LL_ADC_SetOverSamplingScope(ADC1, LL_ADC_OVS_DISABLE);
+	}
+	else
+	{
+		LL_ADC_SetOverSamplingScope(ADC1, LL_ADC_OVS_GRP_REGULAR_CONTINUED);
+		LL_ADC_SetOverSamplingDiscont(ADC1, LL_ADC_OVS_REG_CONT);		//  One Trigger Does the Whole Scan
+		LL_ADC_ConfigOverSamplingRatioShift(ADC1, (uint32_t)(ucLog2 - 1u) << ADC_CFGR2_OVSR_Pos,
+																				(uint32_t)ucLog2 << ADC_CFGR2_OVSS_Pos);
+	}
+	ucCurrentLog2 = ucLog2;
+
+	LL_ADC_ClearFlag_ADRDY(ADC1);
+	LL_ADC_Enable(ADC1);
+	while(LL_ADC_IsActiveFlag_ADRDY(ADC1) == 0)
+	{
+	}
+}
+
+/**
+  * @brief  Called From DMA1 Channel 1 IRQ When a Scan Block has Been Filled.
+  * @param  ucBlock: Index of the Block Just Completed
+  * @retval None
+  */
+void ADC_Scan_Complete_Callback(uint8_t ucBlock)
+{
+	puiADC_ScanResult = uiADC_ScanBuff[ucBlock];
+	uiIntFlags.bADC_ScanReady = true;
+	gas_daq_scan_callback(puiADC_ScanResult);
 }
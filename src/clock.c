@@ -0,0 +1,103 @@
+
+#include "main.h"
+
+volatile uint8_t ucClockClients = CLOCK_CLIENT_BOOT;	//  CLOCK_CLIENT_ Bits Holding Full Speed
+
+static void Clock_Set(uint32_t ulHSIDiv, uint32_t ulHz);
+
+/**
+  * @brief  Ask for Full Speed. The First Client Raises SYSCLK to 48 MHz; Safe
+  *         From Interrupts.
+  * @param  ucClient - CLOCK_CLIENT_
+  * @retval None
+  */
+void Clock_Request(uint8_t ucClient)
+{
+	uint32_t ulPrimask = __get_PRIMASK();
+
+	__disable_irq();
+	if((ucClockClients == 0) && ucClient)
+	{
+		Clock_Set(LL_RCC_HSI_DIV_1, CLOCK_FULL_HZ);
+	}
+	ucClockClients |= ucClient;
+	__set_PRIMASK(ulPrimask);
+}
+
+/**
+  * @brief  Done With Full Speed. When the Last Client Lets Go SYSCLK Drops to
+  *         CLOCK_LOW_HZ; Safe From Interrupts.
+  * @param  ucClient - CLOCK_CLIENT_
+  * @retval None
+  */
+void Clock_Release(uint8_t ucClient)
+{
+	uint32_t ulPrimask = __get_PRIMASK();
+
+	__disable_irq();
+	if(ucClockClients & ucClient)
+	{
+		ucClockClients &= ~ucClient;
+		if(ucClockClients == 0)
+		{
+			Clock_Set(CLOCK_LOW_HSIDIV, CLOCK_LOW_HZ);
+		}
+	}
+	__set_PRIMASK(ulPrimask);
+}
+
+/**
+  * @brief  Switch the HSI Divider and Re-derive Everything Timed From SYSCLK:
+  *         Flash Wait States (Raised Before Speeding Up, Lowered After Slowing
+  *         Down), SysTick Reload and the TIM14 and TIM17 Prescalers. TIM14
+  *         Keeps its 20 uS Count and TIM17 (Profiler) its 1 uS Count at Every
+  *         Level, so Their Counters are Carried Over the Forced Prescaler
+  *         Load and the Lamp Period in Progress is Unchanged.
+  *         Call With Interrupts Masked.
+  * @param  ulHSIDiv - LL_RCC_HSI_DIV_
+  * @param  ulHz - Resulting SYSCLK
+  * @retval None
+  */
+static void Clock_Set(uint32_t ulHSIDiv, uint32_t ulHz)
+{
+	uint32_t ulCount;
+
+	if(ulHz > CLOCK_LATENCY_1_HZ)
+	{
+		LL_FLASH_SetLatency(LL_FLASH_LATENCY_1);
+		while(LL_FLASH_GetLatency() != LL_FLASH_LATENCY_1)
+		{
+		}
+	}
+
+	LL_RCC_SetHSIDiv(ulHSIDiv);
+	while(LL_RCC_HSI_IsReady() != 1)
+	{
+	}
+
+	if(ulHz <= CLOCK_LATENCY_1_HZ)
+	{
+		LL_FLASH_SetLatency(LL_FLASH_LATENCY_0);
+	}
+	LL_SetSystemCoreClock(ulHz);
+
+	SysTick->LOAD = ulHz / 1000u - 1u;				//  Partial mS in Progress Restarts
+	SysTick->VAL = 0;
+
+	if(LL_TIM_IsEnabledCounter(TIM14))
+	{
+		ulCount = LL_TIM_GetCounter(TIM14);
+		LL_TIM_SetPrescaler(TIM14, __LL_TIM_CALC_PSC(ulHz, 50000));
+		LL_TIM_SetUpdateSource(TIM14, LL_TIM_UPDATESOURCE_COUNTER);	//  No Interrupt for the Forced Load
+		LL_TIM_GenerateEvent_UPDATE(TIM14);
+		LL_TIM_SetUpdateSource(TIM14, LL_TIM_UPDATESOURCE_REGULAR);
+		LL_TIM_SetCounter(TIM14, ulCount);
+	}
+	if(LL_TIM_IsEnabledCounter(PROF_TIMER))
+	{
+		ulCount = LL_TIM_GetCounter(PROF_TIMER);
+		LL_TIM_SetPrescaler(PROF_TIMER, __LL_TIM_CALC_PSC(ulHz, PROF_TIMER_HZ));
+		LL_TIM_GenerateEvent_UPDATE(PROF_TIMER);		//  No Update Interrupt Enabled
+		LL_TIM_SetCounter(PROF_TIMER, ulCount);
+	}
+}
@@ -3,34 +3,39 @@
 #include "main.h"
 
 
-void Handle_Rcvd_Msg(void)
+static void Send_Response(Buffer &);
+
+/**
+  * @brief  Decode a Validated Modbus Request and Build the Response
+  * @param  sRx - Received Frame, Address Through CRC
+  * @param  sTx - Buffer the Response is Built and Sent From
+  * @retval None
+  */
+void Handle_Rcvd_Msg(const Buffer &sRx, Buffer &sTx)
 {
 	uint16_t uiCommand;
-	uint16_t uiAddress, uiStartAddress, uiEndAddress;
-	uint16_t uiQty_Regs;
-	uint16_t uiData_Offset, uiType_Offset;
-	uint16_t uiCRC;
+	uint16_t uiStartAddress;
+	uint16_t uiQty_Regs, uiRegCount;
+	uint16_t uiValue;
 	uint16_t i;
 	uint8_t ucErrorCommand;
 	uint8_t ucErrorCode = 0;
-	HRegTypes sHRegType;
-	IRegTypes sIRegType;
-	uint8_t *pType, *pData;
+	const RegDesc *pMap;
+	uint8_t *pData;
 	uint8_t *pDataLoc;
-	uint8_t *pTypeLoc;
 
 	//  Decipher Receive Parameters
-	uiCommand = RxBuff.Buff[1];
+	uiCommand = sRx.Buff[1];
 	ucErrorCommand = uiCommand & 0xff;
-	uiStartAddress = RxBuff.Buff[2] << 8;
-	uiStartAddress += RxBuff.Buff[3];
-	uiQty_Regs = RxBuff.Buff[4] << 8;
-	uiQty_Regs += RxBuff.Buff[5];
+	uiStartAddress = sRx.Buff[2] << 8;
+	uiStartAddress += sRx.Buff[3];
+	uiQty_Regs = sRx.Buff[4] << 8;
+	uiQty_Regs += sRx.Buff[5];
 	
 	//  Setup Transmit Buffer
-	TxBuff.Buff[0] = sHRegs.slave_address;
-	TxBuff.Buff[1] = uiCommand;
-	TxBuff.ptr = 2;
+	sTx.Buff[0] = sHRegs.slave_address;
+	sTx.Buff[1] = uiCommand;
+	sTx.ptr = 2;
 
 	switch(uiCommand)
 	{
@@ -45,9 +50,9 @@ void Handle_Rcvd_Msg(void)
 				break;
 			}
 			uiStartAddress = uiStartAddress - HOLDING_REGISTERS_OFFSET;
-			uiEndAddress = uiStartAddress + uiQty_Regs;
+			pMap = sHRegMap;
+			uiRegCount = uiHRegCount;
 			pData = (uint8_t*)pHRegs;
-			pType = (uint8_t*)&sHRegType;
 		}
 		else
 		{
@@ -57,195 +62,100 @@ void Handle_Rcvd_Msg(void)
 				break;
 			}
 			uiStartAddress = uiStartAddress - INPUT_REGISTERS_OFFSET;
-			uiEndAddress = uiStartAddress + uiQty_Regs;
+			pMap = sIRegMap;
+			uiRegCount = uiIRegCount;
 			pData = (uint8_t*)pIRegs;
-			pType = (uint8_t*)&sIRegType;
 		}
-		if(uiQty_Regs > 0x7d)							//  Confirm Number of Registers in Range
+		if((uiQty_Regs == 0) || (uiQty_Regs > 0x7d) || (uiQty_Regs * 2u + 5u > BUFFER_SIZE))		//  Confirm Number of Registers in Range (and Response Fits)
 		{
 			ucErrorCode = 3u;
 			break;
 		}
-		
-		TxBuff.Buff[TxBuff.ptr++] = uiQty_Regs * 2;			//  Use Register Qty to Calc Qty of Bytes
-		uiData_Offset = 0;															//  Initialize Offset Variables
-		uiType_Offset = 0;
-
-		for(uiAddress = 0; uiAddress < uiEndAddress; uiAddress += 0)
+		if(uiStartAddress + uiQty_Regs > uiRegCount)
 		{
-			//  Reset Type Location Pointer
-			pTypeLoc = pType;
-			pTypeLoc += uiType_Offset;
-			pDataLoc = pData;
-			pDataLoc += uiData_Offset;
-			
-			//  If in Range, Read Register Values
-			if(uiAddress >= uiStartAddress)
-			{
-				if(*pTypeLoc > 1)
-				{
-					if((uint64_t)pDataLoc % 4 > 0)
-					{
-						pDataLoc += 2;
-					}
-					TxBuff.Buff[TxBuff.ptr + 3] = *pDataLoc;
-					pDataLoc ++;
-					TxBuff.Buff[TxBuff.ptr + 2] = *pDataLoc;
-					pDataLoc ++;
-					TxBuff.Buff[TxBuff.ptr + 1] = *pDataLoc;
-					pDataLoc ++;
-					TxBuff.Buff[TxBuff.ptr] = *pDataLoc;
-					pDataLoc ++;
-					TxBuff.ptr += 4u;
-				}
-				else
-				{
-					TxBuff.Buff[TxBuff.ptr + 1] = *pDataLoc;
-					pDataLoc ++;
-					TxBuff.Buff[TxBuff.ptr] = *pDataLoc;
-					pDataLoc ++;
-					TxBuff.ptr += 2u;
-				}
-			}
-			if(*pTypeLoc > 1)
-			{
-				if((uint64_t)pDataLoc % 4 > 0)
-				{
-					uiData_Offset += 2;
-				}
-				uiData_Offset += 4;
-				uiAddress += 2;
-			}
-			else
-			{
-				uiData_Offset += 2;
-				uiAddress ++;
-			}
-			uiType_Offset ++;
-		}
-
-		TxBuff.end = TxBuff.ptr;					//  Needed for CRC Routine
-		uiCRC = Calc_crc(TxBuff);
-		TxBuff.Buff[TxBuff.ptr++] = uiCRC & 0xff;
-		TxBuff.Buff[TxBuff.ptr++] = (uiCRC >> 8) & 0xff;
-		TxBuff.end = TxBuff.ptr;
-
-		if(uiFlags.bI2C_Mode == true)
-		{
-			I2C_SendMessage();
+			ucErrorCode = 2u;
+			break;
 		}
-		else
+		
+		//  Straight to the First Requested Register - Map Gives Each One's Location
+		sTx.Buff[sTx.ptr++] = uiQty_Regs * 2;			//  Use Register Qty to Calc Qty of Bytes
+		pMap += uiStartAddress;
+		for(i = 0; i < uiQty_Regs; i++)
 		{
-			USART1_SendMessage();
+			pDataLoc = pData + pMap[i].uiOffset;
+			sTx.Buff[sTx.ptr++] = pDataLoc[1];			//  High Byte First
+			sTx.Buff[sTx.ptr++] = pDataLoc[0];
 		}
+
+		Send_Response(sTx);
 		break;
 		
 	case 5:													//  Write Single Coil Register
 		;		// Coil Action
 		
-		TxBuff.Buff[TxBuff.ptr++] = (uiStartAddress >> 8) & 0xff;
-		TxBuff.Buff[TxBuff.ptr++] = uiStartAddress & 0xff;
-		TxBuff.Buff[TxBuff.ptr++] = (uiQty_Regs >> 8) & 0xff;
-		TxBuff.Buff[TxBuff.ptr++] = uiQty_Regs & 0xff;
+		sTx.Buff[sTx.ptr++] = (uiStartAddress >> 8) & 0xff;
+		sTx.Buff[sTx.ptr++] = uiStartAddress & 0xff;
+		sTx.Buff[sTx.ptr++] = (uiQty_Regs >> 8) & 0xff;
+		sTx.Buff[sTx.ptr++] = uiQty_Regs & 0xff;
 		
-		TxBuff.end = TxBuff.ptr;					//  Needed for CRC Routine
-		uiCRC = Calc_crc(TxBuff);
-		TxBuff.Buff[TxBuff.ptr++] = uiCRC & 0xff;
-		TxBuff.Buff[TxBuff.ptr++] = (uiCRC >> 8) & 0xff;
-		TxBuff.end = TxBuff.ptr;
-
-		if(uiFlags.bI2C_Mode == true)
-		{
-			I2C_SendMessage();
-		}
-		else
-		{
-			USART1_SendMessage();
-		}
+		Send_Response(sTx);
 		break;
 		
 	case 16:																				//  Write Multiple Holding Registers
+		if(uiStartAddress < HOLDING_REGISTERS_OFFSET)
+		{
+			ucErrorCode = 2u;
+			break;
+		}
 		uiStartAddress = uiStartAddress - HOLDING_REGISTERS_OFFSET;
-		uiEndAddress = uiStartAddress + uiQty_Regs;
-		pData = (uint8_t*)pHRegs;
-		pType = (uint8_t*)&sHRegType;
-		
-		uiData_Offset = 0;									// Initialize Variables
-		uiType_Offset = 0;
-		i = 7;															//  First Data Position in Receive Buffer
+		if((uiQty_Regs == 0) || (uiQty_Regs > 0x7b) ||
+			 (sRx.Buff[6] != uiQty_Regs * 2u) || (sRx.end != uiQty_Regs * 2u + 9u))
+		{
+			ucErrorCode = 3u;
+			break;
+		}
+		if(uiStartAddress + uiQty_Regs > uiHRegCount)
+		{
+			ucErrorCode = 2u;
+			break;
+		}
+		pMap = sHRegMap + uiStartAddress;
 
-		for(uiAddress = 0; uiAddress < uiEndAddress; uiAddress += 0)
+		//  Check Every Value Before Writing Any, so a Rejected Request Changes Nothing
+		for(i = 0; i < uiQty_Regs; i++)
 		{
-			//  Reset Type Location Pointer
-			pTypeLoc = pType;
-			pTypeLoc += uiType_Offset;
-			pDataLoc = pData;
-			pDataLoc += uiData_Offset;
-			if(uiAddress >= uiStartAddress)
-			{
-				//  If in Range, Write Register Values
-				if(*pTypeLoc > 1)
-				{
-					if((uint32_t)pDataLoc % 4 > 0)
-					{
-						pDataLoc += 2;
-					}
-					*pDataLoc = RxBuff.Buff[i + 3];
-					pDataLoc ++;
-					*pDataLoc = RxBuff.Buff[i + 2];
-					pDataLoc ++;
-					*pDataLoc = RxBuff.Buff[i + 1];
-					pDataLoc ++;
-					*pDataLoc = RxBuff.Buff[i];
-					pDataLoc ++;
-					i += 4;
-				}
-				else
-				{
-					*pDataLoc = RxBuff.Buff[i + 1];
-					pDataLoc ++;
-					*pDataLoc = RxBuff.Buff[i];
-					pDataLoc ++;
-					i += 2;
-				}
-			}
-			if(*pTypeLoc > 1)
+			uiValue = (sRx.Buff[7 + 2 * i] << 8) + sRx.Buff[8 + 2 * i];
+			if(pMap[i].ucAccess != REG_READ_WRITE)
 			{
-				if((uint32_t)pDataLoc % 4 > 0)
-				{
-					uiData_Offset += 2;
-				}
-				uiData_Offset += 4;
-				uiAddress += 2;
+				ucErrorCode = 2u;
+				break;
 			}
-			else
+			if((pMap[i].pValidate != NULL) && !pMap[i].pValidate(uiValue))
 			{
-				uiData_Offset += 2;
-				uiAddress ++;
+				ucErrorCode = 3u;
+				break;
 			}
-			uiType_Offset ++;
 		}
-		
-		//  Setup and Send Response
-		TxBuff.Buff[2] = RxBuff.Buff[2];
-		TxBuff.Buff[3] = RxBuff.Buff[3];
-		TxBuff.Buff[4] = RxBuff.Buff[4];
-		TxBuff.Buff[5] = RxBuff.Buff[5];
-		TxBuff.end = 6;
-		TxBuff.ptr = 6;
-		uiCRC = Calc_crc(TxBuff);
-		TxBuff.Buff[TxBuff.ptr++] = uiCRC & 0xff;
-		TxBuff.Buff[TxBuff.ptr++] = (uiCRC >> 8) & 0xff;
-		TxBuff.end = TxBuff.ptr;
-
-		if(uiFlags.bI2C_Mode == true)
+		if(ucErrorCode)
 		{
-			I2C_SendMessage();
+			break;
 		}
-		else
+
+		for(i = 0; i < uiQty_Regs; i++)
 		{
-			USART1_SendMessage();
+			pDataLoc = (uint8_t*)pHRegs + pMap[i].uiOffset;
+			pDataLoc[1] = sRx.Buff[7 + 2 * i];			//  High Byte First
+			pDataLoc[0] = sRx.Buff[8 + 2 * i];
 		}
+		uiFlags.bDSP_Reload = true;					//  Coefficients May Have Changed
+		
+		//  Setup and Send Response
+		sTx.Buff[2] = sRx.Buff[2];
+		sTx.Buff[3] = sRx.Buff[3];
+		sTx.Buff[4] = sRx.Buff[4];
+		sTx.Buff[5] = sRx.Buff[5];
+		sTx.ptr = 6;
+		Send_Response(sTx);
 		uiFlags.bFlashCommitInProcess = true;				//  Setup Commit Timer
 		uiCommit_Timer = 0;
 		break;
@@ -262,58 +172,53 @@ void Handle_Rcvd_Msg(void)
 	//  Handle Any Receive or Protocol Errors
 	if(ucErrorCode)
 	{
-		TxBuff.Buff[1] = 0x80 + ucErrorCommand;
-		TxBuff.Buff[TxBuff.ptr++] = ucErrorCode;
-		TxBuff.end = 3u;
-		uiCRC = Calc_crc(TxBuff);
-		TxBuff.Buff[TxBuff.ptr++] = uiCRC & 0xff;
-		TxBuff.Buff[TxBuff.ptr++] = (uiCRC >> 8) & 0xff;
-		TxBuff.end = TxBuff.ptr;
-		if(uiFlags.bI2C_Mode == true)
-		{
-			I2C_SendMessage();
-		}
-		else
-		{
-			USART1_SendMessage();
-		}
+		sTx.Buff[1] = 0x80 + ucErrorCommand;
+		sTx.ptr = 2;
+		sTx.Buff[sTx.ptr++] = ucErrorCode;
+		Send_Response(sTx);
 	}
 /*
 	//  Reset Receive Buffer
-	for(RxBuff.ptr = 0; RxBuff.ptr < RxBuff.end; RxBuff.ptr ++)
+	for(sRx.ptr = 0; sRx.ptr < sRx.end; sRx.ptr ++)
 	{
-		RxBuff.Buff[RxBuff.ptr] = 0;
+		sRx.Buff[sRx.ptr] = 0;
 	}
-	RxBuff.end = 0;
-	RxBuff.ptr = 0;
+	sRx.end = 0;
+	sRx.ptr = 0;
 */
 }
 
-uint16_t Calc_crc(Buffer buff)
+uint16_t Calc_crc(const Buffer &buff)
 {
-  uint8_t  bits;
-  uint16_t crc = 0xffff;
+	if(buff.end >= BUFFER_SIZE)
+	{
+		return 0;
+	}
+	return CRC_Calc(buff.Buff, buff.end);
+}  /* crc16 */
 
-	buff.ptr = 0;
-  while(buff.ptr < buff.end)
-  {
-    crc ^= (uint16_t)buff.Buff[buff.ptr];
-    for (bits=0; bits < 8u; bits++)
-    {
-      if (crc & 0x0001)
-      {
-        crc = (crc >> 1) ^ 0xA001;
-      }
-      else
-      {
-        crc >>= 1;
-      }
-    }
-	  if(++buff.ptr >= BUFFER_SIZE)
-	  {
-			return 0;
-		}
-  }
+/**
+  * @brief  Append the CRC to the Response in the Transmit Buffer and Start
+  *         Sending it on Whichever Interface the Request Came From
+  * @param  sTx - Response, Bytes 0 to ptr - 1 Filled In
+  * @retval None
+  */
+static void Send_Response(Buffer &sTx)
+{
+	uint16_t uiCRC;
 
-  return crc;
-}  /* crc16 */
+	sTx.end = sTx.ptr;					//  Needed for CRC Routine
+	uiCRC = Calc_crc(sTx);
+	sTx.Buff[sTx.ptr++] = uiCRC & 0xff;
+	sTx.Buff[sTx.ptr++] = (uiCRC >> 8) & 0xff;
+	sTx.end = sTx.ptr;
+
+	if(uiFlags.bI2C_Mode == true)
+	{
+		I2C_SendMessage(sTx);
+	}
+	else
+	{
+		USART1_SendMessage(sTx);
+	}
+}
@@ -0,0 +1,75 @@
+
+#include "main.h"
+
+//  CRC-16/MODBUS Remainders for Each 4 Bit Value (Reflected Polynomial 0xA001)
+static const uint16_t uiCRC_Nibble[16] =
+{
+	0x0000, 0xcc01, 0xd801, 0x1400, 0xf001, 0x3c00, 0x2800, 0xe401,
+	0xa001, 0x6c00, 0x7800, 0xb401, 0x5000, 0x9c01, 0x8801, 0x4400
+};
+
+uint16_t uiRxCRC = CRC16_INIT_VALUE;		//  Running CRC of the Frame Being Received
+
+/**
+  * @brief  CRC Peripheral Initialization Function. Programs the Unit for
+  *         CRC-16/MODBUS: 16 Bit Polynomial 0x8005, Seed 0xFFFF, Input Bits
+  *         Reversed by Byte and Output Reversed (i.e., the 0xA001 Form).
+  * @param  None
+  * @retval None
+  */
+void CRC_Init(void)
+{
+#ifdef CRC_USE_HARDWARE
+	LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_CRC);
+
+	LL_CRC_SetPolynomialSize(CRC, LL_CRC_POLYLENGTH_16B);
+	LL_CRC_SetPolynomialCoef(CRC, CRC16_POLYNOMIAL);
+	LL_CRC_SetInitialData(CRC, CRC16_INIT_VALUE);
+	LL_CRC_SetInputDataReverseMode(CRC, LL_CRC_INDATA_REVERSE_BYTE);
+	LL_CRC_SetOutputDataReverseMode(CRC, LL_CRC_OUTDATA_REVERSE_BIT);
+#endif
+}
+
+/**
+  * @brief  Calculate the CRC-16/MODBUS of a Byte Array. Running the Check Over
+  *         a Message Including its CRC Gives 0 When the Message is Intact.
+  *         Uses the CRC Peripheral, so Only Call From Main Context.
+  * @param  pData - First Byte
+  * @param  uiLength - Number of Bytes
+  * @retval CRC
+  */
+uint16_t CRC_Calc(const uint8_t *pData, uint16_t uiLength)
+{
+#ifdef CRC_USE_HARDWARE
+	LL_CRC_ResetCRCCalculationUnit(CRC);		//  Reload Seed
+	while(uiLength --)
+	{
+		LL_CRC_FeedData8(CRC, *pData ++);
+	}
+	return LL_CRC_ReadData16(CRC);
+#else
+	uint16_t uiCRC = CRC16_INIT_VALUE;
+
+	while(uiLength --)
+	{
+		uiCRC = CRC_Update(uiCRC, *pData ++);
+	}
+	return uiCRC;
+#endif
+}
+
+/**
+  * @brief  Add One Byte to a Running CRC-16/MODBUS. Table Driven, Two Lookups
+  *         per Byte, and Does Not Touch the CRC Peripheral so it is Safe in
+  *         Interrupt Handlers. Start From CRC16_INIT_VALUE.
+  * @param  uiCRC - CRC So Far
+  * @param  ucData - Next Byte
+  * @retval Updated CRC
+  */
+uint16_t CRC_Update(uint16_t uiCRC, uint8_t ucData)
+{
+	uiCRC ^= ucData;
+	uiCRC = (uiCRC >> 4) ^ uiCRC_Nibble[uiCRC & 0x0f];
+	uiCRC = (uiCRC >> 4) ^ uiCRC_Nibble[uiCRC & 0x0f];
+	return uiCRC;
+}
@@ -0,0 +1,635 @@
+/* -----------------------------------------------------------------------------
+ *            file: dsp.cpp
+ *        synopsis: The functions that turn the nadir/zenith/temperature
+ *                  measurements from gas_daq_task() into gas ppm.
+ *
+ *                  Two builds of the arithmetic are provided. The default
+ *                  float path evaluates the holding register coefficients
+ *                  directly. With DSP_FIXED_POINT defined (see main.h) the
+ *                  coefficients are converted once, by dsp_load_coefficients(),
+ *                  into Q31 block-floating polynomials and every per-sample
+ *                  stage runs in integer arithmetic; the Cortex-M0+ has no FPU
+ *                  so each soft-float multiply or add costs far more than the
+ *                  32x32 multiplies used here. Floats are only produced at the
+ *                  end to fill the Modbus input registers.
+ *
+ *                  Signal chain, per sample:
+ *                    t        = detector_temperature / temp_divisor
+ *                    tcor_sig = raw_sig * tcor_factor * tcorN(t)
+ *                    norm_sig = tcor_sig / zero_cal_result
+ *                    norm_sig_avg <- adaptive exponential filter(norm_sig)
+ *                    x        = dsp_calculate_tcor_hat()
+ *                    gas_ppm  = altitude_correction(gas1(x) or gas2(x))
+ */
+
+#include "main.h"
+
+/* ----- data types --------------------------------------------------------- */
+#ifdef DSP_FIXED_POINT
+/** @brief      A polynomial in Q31 block-floating form. The input is scaled
+ *              x = X * 2^x_shift with X a Q31 fraction, and the coefficients
+ *              are pre-multiplied so that p(x) = acc * 2^(exponent - 31) where
+ *              acc is the Horner result in X. The coefficients are sized so
+ *              the sum of their magnitudes is below 2^31, so no intermediate
+ *              of the Horner loop can overflow while |X| < 1. */
+typedef struct
+{
+  int32_t   coeff[NUM_GAS2_PPM_COEFF];
+  uint8_t   count;
+  uint8_t   x_shift;
+  int8_t    exponent;
+} Dsp_Poly_Q31;
+#endif
+
+/* ----- definitions -------------------------------------------------------- */
+#define Q30_ONE               ((int32_t)0x40000000)
+#define Q31_MAX               ((int32_t)0x7fffffff)
+#define DSP_PPM_X_SHIFT       3u      /* tcor hat range +/-8 span units */
+#define DSP_TCOR_X_SHIFT_MIN  1u      /* t range at least 0..2 */
+#define DSP_TCOR_X_SHIFT_MAX  16u     /* every detector_temperature at temp_divisor 1 */
+
+/* ----- local variables ---------------------------------------------------- */
+static float    norm_alpha_base;        /* alpha with no adaption */
+static float    norm_alpha_max;         /* alpha with full adaption */
+
+#ifdef DSP_FIXED_POINT
+static Dsp_Poly_Q31 tcor_poly[3];       /* tcorN * tcor_factor / zero_cal */
+static Dsp_Poly_Q31 gas1_poly;
+static Dsp_Poly_Q31 gas2_poly;
+static uint32_t inv_temp_divisor_q31;   /* 1 / (temp_divisor * 2^x_shift) */
+static int32_t  inv_abc_q30;
+static int32_t  tcor_hat_scale_q24;     /* 1 / (1 - span1_zero_ratio) */
+static int32_t  adapt_coeff_q28;
+static int32_t  inv_adapt_coeff_q30;
+static int32_t  adapt_bound_q30;
+static int32_t  alpha_base_q30;
+static int32_t  alpha_max_q30;
+static int32_t  alpha_q30;
+static int32_t  altitude_q30;
+static int32_t  norm_sig_q30;
+static int32_t  norm_sig_avg_q30;
+#endif
+
+/* ----- global declarations ------------------------------------------------ */
+uint16_t  gas_ppm;
+float     tcor_sig;
+float     norm_sig;
+float     norm_sig_avg;
+float     norm_sig_avg_alpha;
+
+uint32_t  dsp_stage_cycles[DSP_STAGE_COUNT];
+uint32_t  dsp_total_cycles;
+uint16_t  dsp_budget_overruns;
+
+#ifdef DSP_FIXED_POINT
+const uint32_t dsp_stage_budget[DSP_STAGE_COUNT] =
+{
+  400u,           /* DSP_STAGE_TCOR     */
+  200u,           /* DSP_STAGE_NORM     */
+  300u,           /* DSP_STAGE_FILTER   */
+  700u,           /* DSP_STAGE_PPM      */
+  200u            /* DSP_STAGE_ALTITUDE */
+};
+#else
+const uint32_t dsp_stage_budget[DSP_STAGE_COUNT] =
+{
+  1500u,          /* DSP_STAGE_TCOR     */
+  600u,           /* DSP_STAGE_NORM     */
+  1500u,          /* DSP_STAGE_FILTER   */
+  3000u,          /* DSP_STAGE_PPM      */
+  600u            /* DSP_STAGE_ALTITUDE */
+};
+#endif
+
+/* ----- forward declarations ----------------------------------------------- */
+static void dsp_calculate_norm_sig(uint32_t *stamp);
+static void dsp_publish(void);
+static uint32_t dsp_stage_end(Dsp_Stages stage, uint32_t start);
+#ifndef DSP_FIXED_POINT
+static float dsp_poly(const float *coeff, uint16_t count, float x);
+#endif
+static uint8_t dsp_select_tcor(void);
+#ifdef DSP_FIXED_POINT
+static void dsp_poly_load(Dsp_Poly_Q31 *p, const float *coeff, uint16_t count,
+                          uint8_t x_shift, float scale);
+static int32_t dsp_poly_q31(const Dsp_Poly_Q31 *p, int32_t x);
+static int32_t dsp_shift(int64_t value, int16_t shift);
+static int32_t dsp_to_q(float value, uint8_t frac_bits);
+static int32_t dsp_tcor_hat_q31(void);
+#endif
+
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Calculate the gas ppm based on the current raw signal,
+ *                  temperature correction and calibration factors. The
+ *                  result is left in 'gas_ppm' and the input registers.
+ */
+void dsp_calculate_gas_ppm(void)
+{
+  uint32_t stamp;
+  uint16_t i;
+
+  if (uiFlags.bDSP_Reload)
+  {
+    dsp_load_coefficients();
+  }
+
+  stamp = SysTick->VAL;
+  dsp_calculate_norm_sig(&stamp);
+
+#ifdef DSP_FIXED_POINT
+  {
+    int32_t err_q30, x_q31, acc;
+    int32_t ppm_int;
+
+    /* adaptive exponential filter */
+    err_q30 = norm_sig_q30 - norm_sig_avg_q30;
+    if (sHRegs.avg_ctrl == DEFAULT_AVERAGING)
+    {
+      if (((err_q30 < 0) ? -err_q30 : err_q30) > adapt_bound_q30)
+      {
+        alpha_q30 = dsp_shift((int64_t)alpha_q30 * adapt_coeff_q28, 28);
+        if (alpha_q30 > alpha_max_q30)
+        {
+          alpha_q30 = alpha_max_q30;
+        }
+        dsp_adapt_counter++;
+      }
+      else
+      {
+        alpha_q30 = dsp_shift((int64_t)alpha_q30 * inv_adapt_coeff_q30, 30);
+        if (alpha_q30 < alpha_base_q30)
+        {
+          alpha_q30 = alpha_base_q30;
+        }
+      }
+    }
+    norm_sig_avg_q30 += dsp_shift((int64_t)alpha_q30 * err_q30, 30);
+    stamp = dsp_stage_end(DSP_STAGE_FILTER, stamp);
+
+    /* tcor hat and the gas polynomials */
+    x_q31 = dsp_tcor_hat_q31();
+    acc = dsp_poly_q31(&gas1_poly, x_q31);
+    ppm_int = dsp_shift(acc, 31 - gas1_poly.exponent);
+    if (ppm_int > (int32_t)sHRegs.span1_cal_target_ppm)
+    {
+      acc = dsp_poly_q31(&gas2_poly, x_q31);
+      ppm_int = dsp_shift(acc, 31 - gas2_poly.exponent);
+    }
+    stamp = dsp_stage_end(DSP_STAGE_PPM, stamp);
+
+    /* altitude correction */
+    ppm_int = dsp_shift((int64_t)ppm_int * altitude_q30, 30);
+    if (ppm_int < 0)
+    {
+      ppm_int = 0;
+    }
+    else if (ppm_int > (int32_t)sHRegs.gas_ppm_upper_bound_2)
+    {
+      ppm_int = sHRegs.gas_ppm_upper_bound_2;
+    }
+    gas_ppm = (uint16_t)ppm_int;
+  }
+#else
+  {
+    float err, x, ppm;
+
+    /* adaptive exponential filter */
+    err = norm_sig - norm_sig_avg;
+    if (sHRegs.avg_ctrl == DEFAULT_AVERAGING)
+    {
+      if (((err < 0.0f) ? -err : err) >
+          sHRegs.dsp_adapt_bound * (1.0f - sHRegs.span1_zero_ratio))
+      {
+        norm_sig_avg_alpha *= sHRegs.dsp_adapt_coeff;
+        if (norm_sig_avg_alpha > norm_alpha_max)
+        {
+          norm_sig_avg_alpha = norm_alpha_max;
+        }
+        dsp_adapt_counter++;
+      }
+      else
+      {
+        norm_sig_avg_alpha /= sHRegs.dsp_adapt_coeff;
+        if (norm_sig_avg_alpha < norm_alpha_base)
+        {
+          norm_sig_avg_alpha = norm_alpha_base;
+        }
+      }
+    }
+    norm_sig_avg += norm_sig_avg_alpha * err;
+    stamp = dsp_stage_end(DSP_STAGE_FILTER, stamp);
+
+    /* tcor hat and the gas polynomials */
+    x = dsp_calculate_tcor_hat();
+    ppm = dsp_poly(GAS1_PPM_COEFFS, NUM_GAS1_PPM_COEFF, x);
+    if (ppm > (float)sHRegs.span1_cal_target_ppm)
+    {
+      ppm = dsp_poly(GAS2_PPM_COEFFS, NUM_GAS2_PPM_COEFF, x);
+    }
+    stamp = dsp_stage_end(DSP_STAGE_PPM, stamp);
+
+    /* altitude correction */
+    ppm = dsp_altitude_correction(ppm);
+    if (ppm < 0.0f)
+    {
+      ppm = 0.0f;
+    }
+    else if (ppm > (float)sHRegs.gas_ppm_upper_bound_2)
+    {
+      ppm = (float)sHRegs.gas_ppm_upper_bound_2;
+    }
+    gas_ppm = (uint16_t)(ppm + 0.5f);
+  }
+#endif
+  (void)dsp_stage_end(DSP_STAGE_ALTITUDE, stamp);
+
+  dsp_total_cycles = 0u;
+  for (i = 0u; i < DSP_STAGE_COUNT; i++)
+  {
+    dsp_total_cycles += dsp_stage_cycles[i];
+  }
+
+  dsp_publish();
+} /* dsp_calculate_gas_ppm */
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Implements the algorithm that adjusts the gas ppm by
+ *                  considering the altitude and pressure. 'pressure' is the
+ *                  fractional change in reading per unit of altitude, so the
+ *                  reading is scaled back to the calibration altitude.
+ *     param [in] : x - assumed to be the current gas calculation.
+ *         return : The result of the altitude correction.
+ */
+float dsp_altitude_correction(float x)
+{
+  return x * (1.0f + sHRegs.pressure * (sHRegs.altitude - sHRegs.cal_altitude));
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : The absorbance, in span (1) units, of the filtered signal.
+ *                  See dsp.h.
+ *         return : The result of the calculation
+ */
+float dsp_calculate_tcor_hat(void)
+{
+#ifdef DSP_FIXED_POINT
+  return (float)dsp_tcor_hat_q31() * ((float)(1u << DSP_PPM_X_SHIFT) / 2147483648.0f);
+#else
+  return (1.0f - norm_sig_avg / sHRegs.abc_correlation_factor) /
+         (1.0f - sHRegs.span1_zero_ratio);
+#endif
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Re-initialize the adaptive filter so it restarts from the
+ *                  current sample and reports 'gas' until it has settled.
+ *     param [in] : gas - the gas ppm to report.
+ */
+void dsp_initialize_adaptive_filter(float gas)
+{
+  dsp_adapt_counter = 0u;
+  norm_sig_avg_alpha = norm_alpha_base;
+  norm_sig_avg = norm_sig;
+#ifdef DSP_FIXED_POINT
+  alpha_q30 = alpha_base_q30;
+  norm_sig_avg_q30 = norm_sig_q30;
+#endif
+  if (gas < 0.0f)
+  {
+    gas = 0.0f;
+  }
+  gas_ppm = (uint16_t)gas;
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Initializes data structures and the first gas ppm. Used
+ *                  while the sensor is warming up.
+ */
+void dsp_initialize_gas_ppm(void)
+{
+  uint32_t stamp;
+
+  dsp_load_coefficients();
+
+  stamp = SysTick->VAL;
+  dsp_calculate_norm_sig(&stamp);
+
+  if (sHRegs.avg_ctrl == SPECIAL_MEDIA_FEATURE)
+  {
+    dsp_initialize_adaptive_filter((float)INITIAL_PPM);
+  }
+  else
+  {
+    dsp_initialize_adaptive_filter(0.0f);
+  }
+  dsp_publish();
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Re-derive everything that depends only on the holding
+ *                  registers, so the per-sample path does not have to.
+ */
+void dsp_load_coefficients(void)
+{
+  uiFlags.bDSP_Reload = false;
+
+  switch (sHRegs.avg_ctrl)
+  {
+    case NO_AVERAGING :       { norm_alpha_base = (float)NO_AVERAGING_VALUE; } break;
+    case MINIMAL_AVERAGING :  { norm_alpha_base = (float)MINIMAL_AVERAGING_VALUE; } break;
+    case HALF_AVERAGING :     { norm_alpha_base = (float)HALF_AVERAGING_VALUE; } break;
+    case QUARTER_AVERAGING :  { norm_alpha_base = (float)QUARTER_AVERAGING_VALUE; } break;
+    case EIGHTH_AVERAGING :   { norm_alpha_base = (float)EIGHTH_AVERAGING_VALUE; } break;
+    default :                 { norm_alpha_base = sHRegs.dsp_alpha_coeff; } break;
+  }
+  norm_alpha_max = norm_alpha_base * DSP_ADAPT_COEFF_QUAD;
+  if (norm_alpha_max > 1.0f)
+  {
+    norm_alpha_max = 1.0f;
+  }
+  if (norm_sig_avg_alpha < norm_alpha_base)
+  {
+    norm_sig_avg_alpha = norm_alpha_base;
+  }
+
+#ifdef DSP_FIXED_POINT
+  {
+    float norm_scale = sHRegs.tcor_factor / sHRegs.zero_cal_result;
+    float span = 1.0f - sHRegs.span1_zero_ratio;
+    float t_divisor;
+    uint8_t t_shift = DSP_TCOR_X_SHIFT_MIN;
+
+    /* t = detector_temperature / temp_divisor may exceed 1, so give the tcor
+       polynomials the smallest x_shift that holds every uint16 reading */
+    while ((t_shift < DSP_TCOR_X_SHIFT_MAX) &&
+           ((float)UINT16_MAX >= sHRegs.temp_divisor * (float)(1u << t_shift)))
+    {
+      t_shift++;
+    }
+    t_divisor = sHRegs.temp_divisor * (float)(1u << t_shift);
+
+    dsp_poly_load(&tcor_poly[0], TCOR1_COEFFS, NUM_TCOR_COEFF, t_shift, norm_scale);
+    dsp_poly_load(&tcor_poly[1], TCOR2_COEFFS, NUM_TCOR_COEFF, t_shift, norm_scale);
+    dsp_poly_load(&tcor_poly[2], TCOR3_COEFFS, NUM_TCOR_COEFF, t_shift, norm_scale);
+    dsp_poly_load(&gas1_poly, GAS1_PPM_COEFFS, NUM_GAS1_PPM_COEFF, DSP_PPM_X_SHIFT, 1.0f);
+    dsp_poly_load(&gas2_poly, GAS2_PPM_COEFFS, NUM_GAS2_PPM_COEFF, DSP_PPM_X_SHIFT, 1.0f);
+
+    inv_temp_divisor_q31 = (t_divisor > 1.0f) ?
+                           (uint32_t)(2147483648.0f / t_divisor) : 0x7fffffffu;
+    inv_abc_q30 = dsp_to_q(1.0f / sHRegs.abc_correlation_factor, 30u);
+    tcor_hat_scale_q24 = dsp_to_q(1.0f / span, 24u);
+    adapt_coeff_q28 = dsp_to_q(sHRegs.dsp_adapt_coeff, 28u);
+    inv_adapt_coeff_q30 = dsp_to_q(1.0f / sHRegs.dsp_adapt_coeff, 30u);
+    adapt_bound_q30 = dsp_to_q(sHRegs.dsp_adapt_bound * span, 30u);
+    alpha_base_q30 = dsp_to_q(norm_alpha_base, 30u);
+    alpha_max_q30 = dsp_to_q(norm_alpha_max, 30u);
+    if (alpha_q30 < alpha_base_q30)
+    {
+      alpha_q30 = alpha_base_q30;
+    }
+    altitude_q30 = dsp_to_q(dsp_altitude_correction(1.0f), 30u);
+  }
+#endif
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : The temperature correction and normalization stages, shared
+ *                  by the calculation and the initialization.
+ *  param [inout] : stamp - SysTick value at the start of the stage.
+ */
+static void dsp_calculate_norm_sig(uint32_t *stamp)
+{
+#ifdef DSP_FIXED_POINT
+  const Dsp_Poly_Q31 *poly;
+  uint64_t t;
+  int32_t  t_q31, acc;
+
+  /* t / 2^x_shift in Q31; only saturates for a temp_divisor below 1 */
+  t = (uint64_t)detector_temperature * inv_temp_divisor_q31;
+  t_q31 = (t > (uint64_t)Q31_MAX) ? Q31_MAX : (int32_t)t;
+
+  poly = &tcor_poly[dsp_select_tcor()];
+  acc = dsp_poly_q31(poly, t_q31);
+  *stamp = dsp_stage_end(DSP_STAGE_TCOR, *stamp);
+
+  /* norm = raw * acc * 2^(exponent - 31) in Q30 */
+  norm_sig_q30 = dsp_shift((int64_t)raw_sig * acc, 1 - poly->exponent);
+  *stamp = dsp_stage_end(DSP_STAGE_NORM, *stamp);
+#else
+  static const float * const tcor_coeffs[3] =
+  {
+    TCOR1_COEFFS, TCOR2_COEFFS, TCOR3_COEFFS
+  };
+  float t;
+
+  t = (float)detector_temperature / sHRegs.temp_divisor;
+  tcor_sig = (float)raw_sig * sHRegs.tcor_factor *
+             dsp_poly(tcor_coeffs[dsp_select_tcor()], NUM_TCOR_COEFF, t);
+  *stamp = dsp_stage_end(DSP_STAGE_TCOR, *stamp);
+
+  norm_sig = tcor_sig / sHRegs.zero_cal_result;
+  *stamp = dsp_stage_end(DSP_STAGE_NORM, *stamp);
+#endif
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Copy the results into the Modbus input registers. The fixed
+ *                  point path converts to float here, once per sample.
+ */
+static void dsp_publish(void)
+{
+#ifdef DSP_FIXED_POINT
+  norm_sig = (float)norm_sig_q30 * (1.0f / 1073741824.0f);
+  norm_sig_avg = (float)norm_sig_avg_q30 * (1.0f / 1073741824.0f);
+  norm_sig_avg_alpha = (float)alpha_q30 * (1.0f / 1073741824.0f);
+  tcor_sig = norm_sig * sHRegs.zero_cal_result;
+#endif
+  sIRegs.gas_ppm = gas_ppm;
+  sIRegs.tcor_sig = tcor_sig;
+  sIRegs.norm_sig = norm_sig;
+  sIRegs.norm_sig_avg = norm_sig_avg;
+  sIRegs.norm_sig_avg_alpha = norm_sig_avg_alpha;
+  sIRegs.update_count++;
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Record the cycles used by a stage (SysTick counts down and
+ *                  reloads every millisecond) and check it against the budget.
+ *     param [in] : stage - the stage that just finished.
+ *     param [in] : start - SysTick value when the stage started.
+ *         return : SysTick value now, i.e., the start of the next stage.
+ */
+static uint32_t dsp_stage_end(Dsp_Stages stage, uint32_t start)
+{
+  uint32_t now = SysTick->VAL;
+  uint32_t cycles;
+
+  if (start >= now)
+  {
+    cycles = start - now;
+  }
+  else
+  {
+    cycles = start + SysTick->LOAD + 1u - now;
+  }
+  dsp_stage_cycles[stage] = cycles;
+  if (cycles > dsp_stage_budget[stage])
+  {
+    dsp_budget_overruns++;
+  }
+  return now;
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Picks the temperature correction coefficients from the
+ *                  last gas reading relative to the span calibration points.
+ *         return : 0 for TCOR1_COEFFS, 1 for TCOR2_COEFFS, 2 for TCOR3_COEFFS.
+ */
+static uint8_t dsp_select_tcor(void)
+{
+  if (gas_ppm < sHRegs.span1_cal_target_ppm)
+  {
+    return 0u;
+  }
+  if (gas_ppm < sHRegs.span2_cal_target_ppm)
+  {
+    return 1u;
+  }
+  return 2u;
+}
+
+#ifndef DSP_FIXED_POINT
+/* -----------------------------------------------------------------------------
+ *       synopsis : Horner evaluation of coeff[0] + coeff[1]x + ... in float.
+ */
+static float dsp_poly(const float *coeff, uint16_t count, float x)
+{
+  float result = coeff[count - 1u];
+
+  while (--count > 0u)
+  {
+    result = result * x + coeff[count - 1u];
+  }
+  return result;
+}
+#endif
+
+#ifdef DSP_FIXED_POINT
+/* -----------------------------------------------------------------------------
+ *       synopsis : Convert float coefficients to a Q31 block-floating
+ *                  polynomial. Runs only when the coefficients change.
+ *     param [in] : coeff, count - the float coefficients, lowest order first.
+ *     param [in] : x_shift - the input will be x = X * 2^x_shift.
+ *     param [in] : scale - folded into every coefficient.
+ */
+static void dsp_poly_load(Dsp_Poly_Q31 *p, const float *coeff, uint16_t count,
+                          uint8_t x_shift, float scale)
+{
+  float    scaled[NUM_GAS2_PPM_COEFF];
+  float    sum = 0.0f;
+  float    limit = 1.0f;
+  float    x_scale = 1.0f;
+  int8_t   exponent = 0;
+  uint16_t i;
+
+  for (i = 0u; i < count; i++)
+  {
+    scaled[i] = coeff[i] * scale * x_scale;
+    sum += (scaled[i] < 0.0f) ? -scaled[i] : scaled[i];
+    x_scale *= (float)(1u << x_shift);
+  }
+
+  /* smallest exponent with sum < 2^exponent */
+  while ((sum >= limit) && (exponent < 62))
+  {
+    limit *= 2.0f;
+    exponent++;
+  }
+  while ((sum < limit * 0.5f) && (exponent > -62))
+  {
+    limit *= 0.5f;
+    exponent--;
+  }
+
+  for (i = 0u; i < NUM_GAS2_PPM_COEFF; i++)
+  {
+    p->coeff[i] = (i < count) ? (int32_t)(scaled[i] / limit * 2147483520.0f) : 0;
+  }
+  p->count = (uint8_t)count;
+  p->x_shift = x_shift;
+  p->exponent = exponent;
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Horner evaluation of a Q31 polynomial.
+ *     param [in] : x - Q31 input, already divided by 2^x_shift.
+ *         return : acc, where p(x) = acc * 2^(exponent - 31).
+ */
+static int32_t dsp_poly_q31(const Dsp_Poly_Q31 *p, int32_t x)
+{
+  uint8_t i = p->count - 1u;
+  int32_t acc = p->coeff[i];
+
+  while (i-- > 0u)
+  {
+    acc = (int32_t)(((int64_t)acc * x) >> 31) + p->coeff[i];
+  }
+  return acc;
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Arithmetic shift right (or left for a negative shift) with
+ *                  rounding and saturation to int32.
+ */
+static int32_t dsp_shift(int64_t value, int16_t shift)
+{
+  if (shift > 0)
+  {
+    value = (value + ((int64_t)1 << (shift - 1))) >> shift;
+  }
+  else if (shift < 0)
+  {
+    value = value * ((int64_t)1 << (-shift));
+  }
+  if (value > (int64_t)Q31_MAX)
+  {
+    return Q31_MAX;
+  }
+  if (value < -(int64_t)Q31_MAX)
+  {
+    return -Q31_MAX;
+  }
+  return (int32_t)value;
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Float to saturated fixed point with frac_bits fraction bits.
+ */
+static int32_t dsp_to_q(float value, uint8_t frac_bits)
+{
+  float q = value * (float)((uint32_t)1u << frac_bits);
+
+  if (q >= 2147483520.0f)
+  {
+    return Q31_MAX;
+  }
+  if (q <= -2147483520.0f)
+  {
+    return -Q31_MAX;
+  }
+  return (int32_t)q;
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Fixed point dsp_calculate_tcor_hat().
+ *         return : x / 2^DSP_PPM_X_SHIFT in Q31.
+ */
+static int32_t dsp_tcor_hat_q31(void)
+{
+  int32_t d_q30;
+
+  d_q30 = Q30_ONE - dsp_shift((int64_t)norm_sig_avg_q30 * inv_abc_q30, 30);
+  return dsp_shift((int64_t)d_q30 * tcor_hat_scale_q24, 23 + DSP_PPM_X_SHIFT);
+}
+#endif
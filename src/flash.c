@@ -1,7 +1,151 @@
 
 #include "main.h"
 
+#if defined(__ICCARM__)
+//  Keep the Linker Out of the Two Parameter Pages
+#pragma location = FLASH_PAGE_A
+__root __no_init const uint8_t ucFlashParamPages[2 * FLASH_PAGE_BYTES];
+#endif
+
+//  Job Queue - Started in Order, Advanced From the EOP Interrupt
+static FlashJob sFlashQueue[FLASH_QUEUE_SIZE];
+static volatile uint8_t ucFlashHead = 0;
+static volatile uint8_t ucFlashJobs = 0;			//  Queued, Including the Running One
+static uint16_t uiFlashOffset;								//  Program Progress in the Running Job
+static uint16_t uiEraseStart;									//  RTC Sub Second at Erase Start
+static uint64_t ullFlashImage[FLASH_JOURNAL_OFFSET / 8];		//  Base Image or Entries Being Programmed
+
+//  Parameter Journal State
+static HoldRegs sHRegsStored;									//  What a Restore Would Give Now
+static uint8_t ucJournalSeq;									//  Transaction Number of the Last Entries
+static bool bJournalCompact;									//  Next Commit Rewrites the Base Image
+static uint16_t uiJournalNext;								//  First Free Entry - Found Once at Boot
+static uint16_t uiJournalGeneration;					//  Header Generation of the Current Base
+
+//  A/B Pages - the Spare Takes the Next Base Image, Then Becomes Active
+static uint32_t ulFlashActive = FLASH_PAGE_B;
+static uint32_t ulFlashSpare = FLASH_PAGE_A;
+static bool bSpareBlank;											//  Checked Once Idle, Erased if Need Be
+static uint16_t uiCompactBytes;								//  Length of the Image Being Verified
+static const uint64_t ullFlashRetire = 0;			//  Programmed Over a Retired Header
+
+static bool FlashRestoreLegacy(void);
+static bool FlashCompact(void);
+static void FlashCompact_Done(bool);
+static void FlashSpare_Erased(bool);
+static bool FlashPageValid(uint32_t);
+static bool FlashAppend(void);
+static bool FlashEntryValid(const FlashEntry *);
+static uint16_t FlashJournalEnd(void);
+static uint16_t FlashFieldChanged(uint16_t, uint32_t *);
+static void FlashCommit_Done(bool);
+static bool FlashQueue(uint8_t, uint32_t, const uint8_t *, uint16_t, FlashCallback);
+static void FlashStartJob(void);
+static void FlashProgramDoubleWord(FlashJob *);
+static void FlashFinishJob(bool);
+
+/**
+  * @brief  Restore the Holding Registers From the Active Parameter Page: the
+  *         Base Image, Then Every Complete Transaction in the Journal Behind
+  *         it, in Order. The Active Page is the Valid One, or the Newer
+  *         Generation if a Switch Was Cut Short Before the Old Page Was
+  *         Retired. A Page in the Old Fixed Record Format is Read and Queued
+  *         for Rewriting.
+  * @param  None
+  * @retval false if Nothing Usable Was Found
+  */
 bool FlashRestore(void)
+{
+	const FlashHeader *pHeader;
+	const FlashEntry *pEntry;
+	const FlashEntry *pApplied;
+	bool bValidA = FlashPageValid(FLASH_PAGE_A);
+	bool bValidB = FlashPageValid(FLASH_PAGE_B);
+	uint16_t uiBytes, i;
+	uint8_t ucSeq;
+	uint8_t *pSource;
+	uint8_t *pDestination;
+
+	if(bValidA && (!bValidB || (int16_t)(((const FlashHeader*)FLASH_PAGE_A)->uiGeneration -
+																			 ((const FlashHeader*)FLASH_PAGE_B)->uiGeneration) > 0))
+	{
+		ulFlashActive = FLASH_PAGE_A;
+		ulFlashSpare = FLASH_PAGE_B;
+	}
+	else if(!bValidB)
+	{
+		bJournalCompact = true;
+		if(FlashRestoreLegacy() == false)
+		{
+			return false;
+		}
+		sHRegsStored = sHRegs;
+		uiFlags.bFlashCommitInProcess = true;			//  Move to the New Format
+		return true;
+	}
+	pHeader = (const FlashHeader*)ulFlashActive;
+	pEntry = (const FlashEntry*)(ulFlashActive + FLASH_JOURNAL_OFFSET);
+
+	uiBytes = FlashGetRecordSize();
+	pSource = (uint8_t*)(ulFlashActive + FLASH_BASE_OFFSET);
+	pDestination = (uint8_t*)pHRegs;
+	for(i = 0; i < uiBytes; i ++)
+	{
+		pDestination[i] = pSource[i];
+	}
+
+	//  Find the End of the Last Complete Transaction
+	uiJournalGeneration = pHeader->uiGeneration;
+	uiJournalNext = FlashJournalEnd();
+	pApplied = pEntry;
+	ucSeq = pHeader->ucSeq;
+	for(i = 0; (i < uiJournalNext) && FlashEntryValid(&pEntry[i]); i ++)
+	{
+		if((pEntry[i].ucTag & FLASH_ENTRY_SEQ) != ((ucSeq + 1u) & FLASH_ENTRY_SEQ))
+		{
+			break;													//  Not the Next Transaction
+		}
+		if(pEntry[i].ucTag & FLASH_ENTRY_LAST)
+		{
+			ucSeq ++;
+			pApplied = &pEntry[i + 1];
+		}
+	}
+	if((i != uiJournalNext) || (&pEntry[i] != pApplied))
+	{
+		bJournalCompact = true;							//  Torn Write - Move to a Clean Page
+	}
+
+	for(; pEntry < pApplied; pEntry ++)
+	{
+		pDestination = (uint8_t*)pHRegs + sHRegFields[pEntry->ucKey].uiOffset;
+		if(sHRegFields[pEntry->ucKey].ucSize == 2)
+		{
+			*(uint16_t*)pDestination = (uint16_t)pEntry->ulValue;
+		}
+		else
+		{
+			*(uint32_t*)pDestination = pEntry->ulValue;
+		}
+	}
+	ucJournalSeq = ucSeq;
+	sHRegsStored = sHRegs;
+
+	if(bJournalCompact)
+	{
+		uiFlags.bFlashCommitInProcess = true;			//  Rewrite Soon
+	}
+	return true;
+}
+
+/**
+  * @brief  Read the Newest Record of the Original Fixed Slot Format (Up to 8
+  *         Whole Images, Newest Last), so Units in the Field Keep Their
+  *         Calibration Through the Update.
+  * @param  None
+  * @retval true if a Record Was Restored
+  */
+static bool FlashRestoreLegacy(void)
 {
 	uint16_t i;
 	uint16_t uiRecord, uiCRC;
@@ -46,57 +190,46 @@ bool FlashRestore(void)
 
 uint16_t FlashGetRecordSize(void)
 {
-	uint16_t uiBytes, i;	
-	uint8_t *pDataLoc;
-	uint8_t *pTypeLoc;
-	HRegTypes sHRegType;
-
-	uiBytes = 0;															//  Initialize Offset Variables
-	pDataLoc = (uint8_t*)pHRegs;
-	pTypeLoc = (uint8_t*)&sHRegType;
-	for(i = 0; i < QTY_HREGTYPES; i++)
-	{
-		if(*pTypeLoc == 1)
-		{
-			uiBytes += 2;
-			pDataLoc += 2;
-		}
-		else
-		{
-			uiBytes += 4;
-			if((uint64_t)pDataLoc % 4)
-			{
-				uiBytes += 2;
-				pDataLoc += 2;
-			}
-			pDataLoc += 4;
-		}
-		pTypeLoc ++;
-	}
-	return uiBytes;
+	return uiHRegRecordSize;								//  From the Register Map, Fixed at Compile Time
 }
 
+/**
+  * @brief  Queue an Erase of the Spare Parameter Page. Returns at Once; the
+  *         Erase Runs Behind Anything Already Queued. The Active Page is Never
+  *         Erased.
+  * @param  None
+  * @retval false if the Queue is Full
+  */
 bool FlashErase(void)
 {
-	if(READ_BIT(FLASH->SR, FLASH_SR_BSY1) != 0)
+	return FlashQueueErase(ulFlashSpare, FlashSpare_Erased);
+}
+
+/**
+  * @brief  Background Upkeep, Called Once a Second When no Commit is
+  *         Pending: Makes Sure the Spare Page is Blank Before the Next Base
+  *         Rewrite Needs it, so the Erase Stays Off the Commit Path.
+  * @param  None
+  * @retval None
+  */
+void FlashService(void)
+{
+	const uint32_t *pWord = (const uint32_t*)ulFlashSpare;
+	uint16_t i;
+
+	if(bSpareBlank || FlashBusy())
 	{
-		return false;
+		return;
 	}
-
-	FlashUnlock();
-	SET_BIT(FLASH->CR, 0x7a);
-	
-	SET_BIT(FLASH->CR, FLASH_CR_STRT);
-	
-	while(READ_BIT(FLASH->SR, FLASH_SR_BSY1) == 1)
-	{
-		;
-	}
-	CLEAR_BIT(FLASH->CR, FLASH_CR_PER);
-	CLEAR_BIT(FLASH->SR, FLASH_SR_PGSERR);
-	SET_BIT(FLASH->CR, FLASH_CR_LOCK);
-	
-	return true;
+	for(i = 0; i < FLASH_PAGE_BYTES / 4; i ++)
+	{
+		if(pWord[i] != 0xffffffff)
+		{
+			FlashErase();
+			return;
+		}
+	}
+	bSpareBlank = true;
 }
 
 bool FlashUnlock(void)
@@ -118,163 +251,475 @@ bool FlashUnlock(void)
 
 bool FlashInitialize(void)
 {
-	FlashErase();						//  First Ensure Sector is Blank
 	FlashRestoreDefaults();
+	ucJournalSeq = 0;
 
-	return FlashCommit();
+	return FlashCompact();
 }
 
+/**
+  * @brief  Save the Holding Registers. Each Field That Differs From the Page
+  *         is Appended to the Journal as One Entry, the Lot Forming One
+  *         Transaction; Only When the Journal is Full (or Damaged) is the Page
+  *         Erased and the Base Image Rewritten. Returns Once the Job is Queued.
+  * @param  None
+  * @retval false if a Commit is Still in Flight - Try Again Later
+  */
 bool FlashCommit(void)
 {
-	uint16_t uiBytes, uiLines;
-	uint16_t uiCRC, i;
-	uint16_t uiRecord;
-	uint64_t dwData;
-	uint8_t *pDataLoc;
-	uint32_t ulWriteLoc;
-	bool bBlank;
+	if(FlashBusy())
+	{
+		return false;
+	}
+	if(bJournalCompact || !FlashAppend())
+	{
+		return FlashCompact();
+	}
+	return true;
+}
+
+/**
+  * @brief  Write the Holding Registers as a New Base Image (Registers and
+  *         Their CRC, Low Byte First) in the Spare Page, With an Empty
+  *         Journal. The Header Goes Last, so Until it is Down the Old Page
+  *         Stays the Valid One. The Spare is Only Erased Here if Background
+  *         Upkeep Has Not Done it Yet.
+  * @param  None
+  * @retval false if the Queue is Full
+  */
+static bool FlashCompact(void)
+{
+	uint16_t uiBytes, uiCRC, i;
+	FlashHeader *pHeader = (FlashHeader*)ullFlashImage;
+	uint8_t *pImage = (uint8_t*)ullFlashImage + FLASH_BASE_OFFSET;
+	uint8_t *pSource = (uint8_t*)pHRegs;
+
+	pHeader->ulMagic = FLASH_STORE_MAGIC;
+	pHeader->ucSeq = ucJournalSeq;
+	pHeader->ucReserved = 0xff;
+	pHeader->uiGeneration = uiJournalGeneration + 1u;
+
+	uiBytes = FlashGetRecordSize();
+	for(i = 0; i < uiBytes; i ++)
+	{
+		pImage[i] = pSource[i];
+	}
+	uiCRC = Flash_CRC(pImage, uiBytes);
+	pImage[uiBytes ++] = uiCRC & 0xff;
+	pImage[uiBytes ++] = uiCRC >> 8;
+	for(i = uiBytes; i % 8; i ++)
+	{
+		pImage[i] = 0xff;
+	}
+
+	if(!bSpareBlank && (FlashQueueErase(ulFlashSpare, NULL) == false))
+	{
+		return false;
+	}
+	uiCompactBytes = FLASH_BASE_OFFSET + i;
+	if(!FlashQueueProgram(ulFlashSpare + FLASH_BASE_OFFSET, (uint8_t*)ullFlashImage + FLASH_BASE_OFFSET,
+												uiCompactBytes - FLASH_BASE_OFFSET, NULL) ||
+		 !FlashQueueProgram(ulFlashSpare, (uint8_t*)ullFlashImage, FLASH_BASE_OFFSET, FlashCompact_Done))
+	{
+		return false;
+	}
+	bSpareBlank = false;
+	sHRegsStored = sHRegs;
+	bJournalCompact = false;
+	uiJournalGeneration ++;
+	return true;
+}
+
+/**
+  * @brief  New Base Image Down. Read it Back, and Only if it Matches Make the
+  *         Spare the Active Page and Retire the Old One by Zeroing its Header.
+  *         The Old Page is Erased Later, When Idle.
+  * @param  bOK - false if the Flash Reported an Error
+  * @retval None
+  */
+static void FlashCompact_Done(bool bOK)
+{
+	const uint32_t *pWritten = (const uint32_t*)ulFlashSpare;
+	const uint32_t *pImage = (const uint32_t*)ullFlashImage;
+	uint32_t ulRetired = ulFlashActive;
+	uint16_t i;
 
-	uiBytes = FlashGetRecordSize();					//  Initialize Record Parameters
-	uiLines = uiBytes >> 3;
-	if(uiBytes % 8)
+	for(i = 0; bOK && (i < uiCompactBytes / 4); i ++)
 	{
-		uiLines ++;
+		bOK = (pWritten[i] == pImage[i]);
 	}
+	if(!bOK || !FlashPageValid(ulFlashSpare))
+	{
+		FlashCommit_Done(false);
+		return;
+	}
+	ulFlashActive = ulFlashSpare;
+	ulFlashSpare = ulRetired;
+	uiJournalNext = 0;
+	FlashQueueProgram(ulRetired, (const uint8_t*)&ullFlashRetire, 8, NULL);
+}
 
-	//  Find First Blank Record and Verify Entire Record Blank
-	bBlank = false;
-	uiRecord = 0;
-	while(bBlank == false)
+/**
+  * @brief  Spare Page Erase Finished
+  * @param  bOK - false if the Flash Reported an Error
+  * @retval None
+  */
+static void FlashSpare_Erased(bool bOK)
+{
+	bSpareBlank = bOK;
+}
+
+/**
+  * @brief  A Page is Valid When its Header is Down and its Base Image CRC
+  *         Checks. A Retired or Half Written Page is Not. Uses the Table CRC,
+  *         as FlashCompact_Done Calls it From the Flash Interrupt, Which May
+  *         Land in the Middle of a Main Loop CRC on the Peripheral.
+  * @param  ulPage - Page Address
+  * @retval true if Valid
+  */
+static bool FlashPageValid(uint32_t ulPage)
+{
+	const uint8_t *pData = (const uint8_t*)(ulPage + FLASH_BASE_OFFSET);
+	uint16_t uiLength = FlashGetRecordSize() + 2;
+	uint16_t uiCRC = CRC16_INIT_VALUE;
+
+	if(((const FlashHeader*)ulPage)->ulMagic != FLASH_STORE_MAGIC)
 	{
-		pDataLoc = ((uint8_t*)FLASH_E2_BASE + (uiRecord * FLASH_RECORD_ALLOCATION));
-		bBlank = true;
-		for(i = 0; i < FLASH_RECORD_ALLOCATION; i++)
+		return false;
+	}
+	while(uiLength --)
+	{
+		uiCRC = CRC_Update(uiCRC, *pData ++);
+	}
+	return (uiCRC == 0);
+}
+
+/**
+  * @brief  Append Every Changed Field to the Journal as One Transaction.
+  * @param  None
+  * @retval false if it Does Not Fit - Compact Instead
+  */
+static bool FlashAppend(void)
+{
+	const FlashEntry *pEntry = (const FlashEntry*)(ulFlashActive + FLASH_JOURNAL_OFFSET);
+	FlashEntry *pNew = (FlashEntry*)ullFlashImage;
+	uint16_t uiFree = FLASH_JOURNAL_ENTRIES - uiJournalNext;
+	uint16_t uiCount, i;
+	uint32_t ulValue;
+
+	uiCount = 0;
+	for(i = 0; i < uiHRegFieldCount; i ++)
+	{
+		if(FlashFieldChanged(i, &ulValue))
 		{
-			if(*(pDataLoc + i) != 0xff)
+			if((uiCount >= uiFree) || (uiCount >= FLASH_JOURNAL_OFFSET / sizeof(FlashEntry)))
 			{
-				bBlank = false;
-				i = FLASH_RECORD_ALLOCATION;	//  Force Exit from For Loop
+				return false;
 			}
+			pNew[uiCount].ulValue = ulValue;
+			pNew[uiCount].ucKey = i;
+			pNew[uiCount].ucTag = (ucJournalSeq + 1u) & FLASH_ENTRY_SEQ;
+			uiCount ++;
 		}
-		if(bBlank == false)
+	}
+	if(uiCount == 0)
+	{
+		return true;														//  Nothing Changed
+	}
+
+	pNew[uiCount - 1].ucTag |= FLASH_ENTRY_LAST;
+	for(i = 0; i < uiCount; i ++)
+	{
+		pNew[i].uiCRC = Flash_CRC((uint8_t*)&pNew[i], FLASH_ENTRY_CRC_BYTES);
+	}
+	if(!FlashQueueProgram((uint32_t)(uintptr_t)&pEntry[uiJournalNext], (uint8_t*)pNew,
+												uiCount * sizeof(FlashEntry), FlashCommit_Done))
+	{
+		return false;
+	}
+
+	ucJournalSeq ++;
+	uiJournalNext += uiCount;
+	for(i = 0; i < uiHRegFieldCount; i ++)
+	{
+		if(FlashFieldChanged(i, &ulValue))
 		{
-			if(++uiRecord >= FLASH_NUMBER_OF_RECORDS)
+			if(sHRegFields[i].ucSize == 2)
+			{
+				*(uint16_t*)((uint8_t*)&sHRegsStored + sHRegFields[i].uiOffset) = (uint16_t)ulValue;
+			}
+			else
 			{
-				uiRecord = 0;
-				bBlank = FlashErase();
+				*(uint32_t*)((uint8_t*)&sHRegsStored + sHRegFields[i].uiOffset) = ulValue;
 			}
 		}
 	}
+	return true;
+}
+
+/**
+  * @brief  A Journal Entry is Valid When its Key Names a Field and its CRC
+  *         Checks. A Blank (Erased) Entry is Never Valid.
+  * @param  pEntry - Entry in Flash
+  * @retval true if Valid
+  */
+static bool FlashEntryValid(const FlashEntry *pEntry)
+{
+	return (pEntry->ucKey < uiHRegFieldCount) &&
+				 (Flash_CRC((uint8_t*)pEntry, FLASH_ENTRY_CRC_BYTES + 2) == 0);
+}
+
+/**
+  * @brief  Binary Search for the First Blank Journal Entry. Entries are Only
+  *         Ever Programmed in Order, so Blanks Form the Tail of the Journal
+  *         and Only log2(FLASH_JOURNAL_ENTRIES) Entries are Read.
+  * @param  None
+  * @retval Entry Index, FLASH_JOURNAL_ENTRIES if Full
+  */
+static uint16_t FlashJournalEnd(void)
+{
+	const uint32_t *pWords = (const uint32_t*)(ulFlashActive + FLASH_JOURNAL_OFFSET);
+	uint16_t uiLow = 0;
+	uint16_t uiHigh = FLASH_JOURNAL_ENTRIES;
+	uint16_t uiMid;
+
+	while(uiLow < uiHigh)
+	{
+		uiMid = (uiLow + uiHigh) / 2u;
+		if((pWords[uiMid * 2u] == 0xffffffff) && (pWords[uiMid * 2u + 1u] == 0xffffffff))
+		{
+			uiHigh = uiMid;
+		}
+		else
+		{
+			uiLow = uiMid + 1u;
+		}
+	}
+	return uiLow;
+}
+
+/**
+  * @brief  Compare a Holding Register Field With the Stored Copy.
+  * @param  uiField - sHRegFields Index
+  * @param  pValue - Current Value (16 Bit Fields in the Low Half)
+  * @retval Non Zero if it Differs
+  */
+static uint16_t FlashFieldChanged(uint16_t uiField, uint32_t *pValue)
+{
+	uint16_t uiOffset = sHRegFields[uiField].uiOffset;
 
-	uiCRC = Flash_CRC((uint8_t*)pHRegs, uiBytes);
-	
-	//  Commit Sequence
-	if(READ_BIT(FLASH->SR, FLASH_SR_BSY1) != 0)
+	if(sHRegFields[uiField].ucSize == 2)
 	{
-		return false;
+		*pValue = *(uint16_t*)((uint8_t*)pHRegs + uiOffset);
+		return *pValue != *(uint16_t*)((uint8_t*)&sHRegsStored + uiOffset);
 	}
-	FlashUnlock();
-	SET_BIT(FLASH->SR, 0xc2fa);						//  Check for Errors and Clear if Needed
+	*pValue = *(uint32_t*)((uint8_t*)pHRegs + uiOffset);
+	return *pValue != *(uint32_t*)((uint8_t*)&sHRegsStored + uiOffset);
+}
 
-	pDataLoc = (uint8_t*)pHRegs;					//  Reinitialize Data Location
-	ulWriteLoc = (uint32_t)(FLASH_E2_BASE + (uiRecord * FLASH_RECORD_ALLOCATION));
-	
-	for(i = 0; i < uiLines; i ++)
+/**
+  * @brief  Journal or Base Program Finished. On Failure the Page No Longer
+  *         Matches sHRegsStored, so Rewrite it on the Next Commit and Arm the
+  *         Commit Timer.
+  * @param  bOK - false if the Flash Reported an Error
+  * @retval None
+  */
+static void FlashCommit_Done(bool bOK)
+{
+	if(!bOK)
 	{
-		dwData = *(uint64_t*)pDataLoc;
-		if(uiBytes < 8)
+		bJournalCompact = true;
+		uiCommit_Timer = 0;
+		uiFlags.bFlashCommitInProcess = true;
+	}
+}
+
+/**
+  * @brief  Queue a Page Erase.
+  * @param  ulAddress - Any Address in the Page
+  * @param  pDone - Called (From the Flash Interrupt) When Finished, or NULL
+  * @retval false if the Queue is Full
+  */
+bool FlashQueueErase(uint32_t ulAddress, FlashCallback pDone)
+{
+	return FlashQueue(FLASH_OP_ERASE, ulAddress, NULL, 0, pDone);
+}
+
+/**
+  * @brief  Queue Programming of Whole Double Words. The Source (Word Aligned)
+  *         is Read as the Job Runs, so it Must Stay Unchanged Until pDone.
+  * @param  ulAddress - Double Word Aligned Destination
+  * @param  pData - Source
+  * @param  uiLength - Bytes, a Multiple of 8
+  * @param  pDone - Called (From the Flash Interrupt) When Finished, or NULL
+  * @retval false if the Queue is Full
+  */
+bool FlashQueueProgram(uint32_t ulAddress, const uint8_t *pData, uint16_t uiLength, FlashCallback pDone)
+{
+	return FlashQueue(FLASH_OP_PROGRAM, ulAddress, pData, uiLength, pDone);
+}
+
+/**
+  * @brief  Any Flash Job Queued or Running
+  * @param  None
+  * @retval true if Busy
+  */
+bool FlashBusy(void)
+{
+	return ucFlashJobs != 0;
+}
+
+/**
+  * @brief  Function called from FLASH IRQ Handler on End of Operation. Starts
+  *         the Next Double Word of a Program Job, Else Finishes the Job. An
+  *         Erase Also Records its Time in the Input Registers.
+  * @param  None
+  * @retval None
+  */
+void Flash_EOP_Callback(void)
+{
+	FlashJob *pJob = &sFlashQueue[ucFlashHead];
+	uint16_t uiTime;
+
+	if(pJob->ucOp == FLASH_OP_PROGRAM)
+	{
+		uiFlashOffset += 8;
+		if(uiFlashOffset < pJob->uiLength)
 		{
-			///// need better method of calculating offsets
-			dwData += (uint64_t)((uiCRC >> 8) & 0xff) << 56;
-			dwData += (uint64_t)(uiCRC & 0xff) << 48;
+			FlashProgramDoubleWord(pJob);
+			return;
 		}
-		SET_BIT(FLASH->CR, FLASH_CR_PG);
-		*(uint32_t*)ulWriteLoc = (uint32_t)dwData;
-		*(uint32_t*)(ulWriteLoc + 4u)= (uint32_t)(dwData >> 32u);
-		CLEAR_BIT(FLASH->CR, FLASH_CR_PG);
-		ulWriteLoc += 8;
-		pDataLoc += 8;
-		if(uiBytes >= 8)
+	}
+	else
+	{
+		uiTime = (uiEraseStart + RTC_SS_PER_SECOND - Power_GetSubSecond()) % RTC_SS_PER_SECOND;
+		sIRegs.flash_erase_time = uiTime;
+		if(uiTime > sIRegs.flash_erase_max)
 		{
-			uiBytes -= 8;
+			sIRegs.flash_erase_max = uiTime;
 		}
+		sIRegs.flash_erase_count ++;
 	}
-	SET_BIT(FLASH->CR, FLASH_CR_LOCK);			//  Lock Flash
+	FlashFinishJob(true);
+}
+
+/**
+  * @brief  Function called from FLASH IRQ Handler on an Operation Error. The
+  *         Job is Dropped and the Queue Moves On.
+  * @param  None
+  * @retval None
+  */
+void Flash_Error_Callback(void)
+{
+	FlashFinishJob(false);
+}
+
+/**
+  * @brief  Add a Job, Starting it if the Flash is Idle.
+  * @retval false if the Queue is Full
+  */
+static bool FlashQueue(uint8_t ucOp, uint32_t ulAddress, const uint8_t *pData, uint16_t uiLength, FlashCallback pDone)
+{
+	FlashJob *pJob;
+	uint32_t ulPrimask = __get_PRIMASK();
+
+	__disable_irq();
+	if(ucFlashJobs >= FLASH_QUEUE_SIZE)
+	{
+		__set_PRIMASK(ulPrimask);
+		return false;
+	}
+	pJob = &sFlashQueue[(ucFlashHead + ucFlashJobs) % FLASH_QUEUE_SIZE];
+	pJob->ucOp = ucOp;
+	pJob->ulAddress = ulAddress;
+	pJob->pData = pData;
+	pJob->uiLength = uiLength;
+	pJob->pDone = pDone;
+	if(++ucFlashJobs == 1)
+	{
+		FlashStartJob();
+	}
+	__set_PRIMASK(ulPrimask);
 	return true;
 }
 
+/**
+  * @brief  Start the Job at the Head of the Queue. Interrupts Masked or From
+  *         the Flash Interrupt.
+  */
+static void FlashStartJob(void)
+{
+	FlashJob *pJob = &sFlashQueue[ucFlashHead];
+
+	FlashUnlock();
+	WRITE_REG(FLASH->SR, FLASH_SR_ERRORS | FLASH_SR_EOP);		//  Clear Leftovers
+	NVIC_SetPriority(FLASH_IRQn, 2);
+	NVIC_EnableIRQ(FLASH_IRQn);
+
+	if(pJob->ucOp == FLASH_OP_ERASE)
+	{
+		MODIFY_REG(FLASH->CR, FLASH_CR_PNB | FLASH_CR_PG,
+							 (((pJob->ulAddress - FLASH_BASE) / FLASH_PAGE_BYTES) << FLASH_CR_PNB_Pos) |
+							 FLASH_CR_PER | FLASH_CR_EOPIE | FLASH_CR_ERRIE);
+		uiEraseStart = Power_GetSubSecond();			//  RTC - SysTick Can Not Interrupt a Stalled Fetch
+		SET_BIT(FLASH->CR, FLASH_CR_STRT);
+	}
+	else
+	{
+		uiFlashOffset = 0;
+		SET_BIT(FLASH->CR, FLASH_CR_PG | FLASH_CR_EOPIE | FLASH_CR_ERRIE);
+		FlashProgramDoubleWord(pJob);
+	}
+}
+
+/**
+  * @brief  Write the Next Double Word of a Program Job; the Second Word Write
+  *         Starts the Operation.
+  */
+static void FlashProgramDoubleWord(FlashJob *pJob)
+{
+	const uint32_t *pSource = (const uint32_t*)(pJob->pData + uiFlashOffset);
+
+	*(volatile uint32_t*)(pJob->ulAddress + uiFlashOffset) = pSource[0];
+	*(volatile uint32_t*)(pJob->ulAddress + uiFlashOffset + 4u) = pSource[1];
+}
+
+/**
+  * @brief  Close the Head Job, Start the Next or Lock the Flash, Then Report
+  *         it - so the Callback May Queue Follow Up Jobs.
+  */
+static void FlashFinishJob(bool bOK)
+{
+	FlashCallback pDone = sFlashQueue[ucFlashHead].pDone;
+
+	CLEAR_BIT(FLASH->CR, FLASH_CR_PG | FLASH_CR_PER | FLASH_CR_EOPIE | FLASH_CR_ERRIE);
+	WRITE_REG(FLASH->SR, FLASH_SR_ERRORS | FLASH_SR_EOP);
+	ucFlashHead = (ucFlashHead + 1) % FLASH_QUEUE_SIZE;
+	ucFlashJobs --;
+
+	if(ucFlashJobs)
+	{
+		FlashStartJob();
+	}
+	else
+	{
+		SET_BIT(FLASH->CR, FLASH_CR_LOCK);			//  Lock Flash
+	}
+	if(pDone != NULL)
+	{
+		pDone(bOK);
+	}
+}
+
+/**
+  * @brief  Every Holding Register to its Default - the Map's Default Column,
+  *         Which HoldRegs' Member Initializers Already Carry (REG_MEMBER).
+  * @param  None
+  * @retval None
+  */
 void FlashRestoreDefaults(void)
 {
-	sHRegs.model_number = DEFAULT_MODEL_NUMBER;										// 4000
-	sHRegs.mfg_data = DEFAULT_MFG_DATA;
-	sHRegs.serial_number = DEFAULT_SERIAL_NUMBER;
-	sHRegs.ops_flag = DEFAULT_OPS_FLAG;
-	sHRegs.slave_address = DEFAULT_SLAVE_ADDRESS;
-	sHRegs.baud_rate = DEFAULT_BAUD_RATE;
-	sHRegs.parity = DEFAULT_PARITY;
-	sHRegs.sample_time = DEFAULT_SAMPLE_TIME;
-	sHRegs.nadir_time = DEFAULT_NADIR_TIME;
-	sHRegs.zenith_time = DEFAULT_ZENITH_TIME;											// 4010
-	sHRegs.cal_samples = DEFAULT_CAL_SAMPLES;
-	sHRegs.temp_divisor = DEFAULT_TEMP_DIVISOR;
-	sHRegs.co2_bound_limit_hi = DEFAULT_CO2_BOUND_LIMIT_HI;
-	sHRegs.co2_bound_limit_lo = DEFAULT_CO2_BOUND_LIMIT_LO;
-	sHRegs.zero_cal_target_ppm = DEFAULT_ZERO_CAL_TARGET_PPM;
-	sHRegs.zero_cal_result = DEFAULT_ZERO_CAL_RESULT;
-	sHRegs.span1_cal_target_ppm = DEFAULT_SPAN1_CAL_TARGET_PPM;
-	sHRegs.span1_cal_result = DEFAULT_SPAN1_CAL_RESULT;						// 4020
-	sHRegs.span1_zero_ratio = DEFAULT_SPAN1_ZERO_RATIO;
-	sHRegs.span2_cal_target_ppm = DEFAULT_SPAN2_CAL_TARGET_PPM;
-	sHRegs.span2_cal_result = DEFAULT_SPAN2_CAL_RESULT;
-	sHRegs.span2_zero_ratio = DEFAULT_SPAN2_ZERO_RATIO;
-	sHRegs.sngpt_cal_target_ppm = DEFAULT_SNGPT_CAL_TARGET_PPM;
-	sHRegs.tcor_factor = DEFAULT_TCOR_FACTOR;											// 4030
-	sHRegs.tcor1_coeff_x0 = DEFAULT_TCOR1_COEFF_X0;
-	sHRegs.tcor1_coeff_x1 = DEFAULT_TCOR1_COEFF_X1;
-	sHRegs.tcor1_coeff_x2 = DEFAULT_TCOR1_COEFF_X2;
-	sHRegs.tcor1_coeff_x3 = DEFAULT_TCOR1_COEFF_X3;
-	sHRegs.tcor2_coeff_x0 = DEFAULT_TCOR2_COEFF_X0;								// 4040
-	sHRegs.tcor2_coeff_x1 = DEFAULT_TCOR2_COEFF_X1;
-	sHRegs.tcor2_coeff_x2 = DEFAULT_TCOR2_COEFF_X2;
-	sHRegs.tcor2_coeff_x3 = DEFAULT_TCOR2_COEFF_X3;
-	sHRegs.tcor3_coeff_x0 = DEFAULT_TCOR3_COEFF_X0;
-	sHRegs.tcor3_coeff_x1 = DEFAULT_TCOR3_COEFF_X1;								// 4050
-	sHRegs.tcor3_coeff_x2 = DEFAULT_TCOR3_COEFF_X2;
-	sHRegs.tcor3_coeff_x3 = DEFAULT_TCOR3_COEFF_X3;
-	sHRegs.gas1_ppm_coeff_x0 = DEFAULT_GAS1_PPM_COEFF_X0;
-	sHRegs.gas1_ppm_coeff_x1 = DEFAULT_GAS1_PPM_COEFF_X1;
-	sHRegs.gas1_ppm_coeff_x2 = DEFAULT_GAS1_PPM_COEFF_X2;					// 4060
-	sHRegs.gas1_ppm_coeff_x3 = DEFAULT_GAS1_PPM_COEFF_X3;
-	sHRegs.gas2_ppm_coeff_x0 = DEFAULT_GAS2_PPM_COEFF_X0;
-	sHRegs.gas2_ppm_coeff_x1 = DEFAULT_GAS2_PPM_COEFF_X1;
-	sHRegs.gas2_ppm_coeff_x2 = DEFAULT_GAS2_PPM_COEFF_X2;
-	sHRegs.gas2_ppm_coeff_x3 = DEFAULT_GAS2_PPM_COEFF_X3;					// 4070
-	sHRegs.gas2_ppm_coeff_x4 = DEFAULT_GAS2_PPM_COEFF_X4;
-	sHRegs.gas2_ppm_coeff_x5 = DEFAULT_GAS2_PPM_COEFF_X5;
-	sHRegs.gas2_ppm_coeff_x6 = DEFAULT_GAS2_PPM_COEFF_X6;
-	sHRegs.gas2_ppm_coeff_x7 = DEFAULT_GAS2_PPM_COEFF_X7;
-	sHRegs.lamp_data_time_0 = DEFAULT_LAMP_DATA_TIME_0;						// 4080
-	sHRegs.lamp_data_volt_0 = DEFAULT_LAMP_DATA_VOLT_0;
-	sHRegs.lamp_data_time_1 = DEFAULT_LAMP_DATA_TIME_1;
-	sHRegs.lamp_data_volt_1 = DEFAULT_LAMP_DATA_VOLT_1;
-	sHRegs.lamp_data_time_2 = DEFAULT_LAMP_DATA_TIME_2;
-	sHRegs.lamp_data_volt_2 = DEFAULT_LAMP_DATA_VOLT_2;
-	sHRegs.abc_correlation_factor = DEFAULT_ABC_CORRELATION_FACTOR;
-	sHRegs.abc_sample_rate = DEFAULT_ABC_SAMPLE_RATE;
-	sHRegs.abc_eval_count = DEFAULT_ABC_EVAL_COUNT;
-	sHRegs.abc_sample_count = DEFAULT_ABC_SAMPLE_COUNT;						// 4090
-	sHRegs.dsp_alpha_coeff = DEFAULT_DSP_ALPHA_COEFF;
-	sHRegs.dsp_adapt_coeff = DEFAULT_DSP_ADAPT_COEFF;
-	sHRegs.dsp_adapt_bound = DEFAULT_DSP_ADAPT_BOUND;
-	sHRegs.gas_ppm_upper_bound_1 = DEFAULT_GAS_UPPER_BOUND_1;
-	sHRegs.gas_ppm_upper_bound_2 = DEFAULT_GAS_UPPER_BOUND_2;
-	sHRegs.altitude = DEFAULT_ALTITUDE;														// 4100
-	sHRegs.cal_altitude = DEFAULT_CAL_ALTITUDE;
-	sHRegs.pressure = DEFAULT_PRESSURE;
-	sHRegs.warm_up_time = DEFAULT_WARM_UP_TIME;
-	sHRegs.dac_ctrl = DEFAULT_DAC_CTRL;
-	sHRegs.first_sample_cf = DEFAULT_FIRST_SAMPLE_CF;
-	sHRegs.avg_ctrl = DEFAULT_AVG_CTRL;														// 4109
+	sHRegs = HoldRegs();
 }
 
 /* -----------------------------------------------------------------------------
@@ -290,26 +735,5 @@ void FlashRestoreDefaults(void)
  */
 uint16_t Flash_CRC(uint8_t *buffer, uint16_t uiLength)
 {
-  uint8_t  bits;
-  uint16_t crc = 0xffff;
-	uint16_t uiIndex = 0;
-
-	while(uiIndex < uiLength)
-  {
-    crc ^= (uint16_t)*buffer ++;
-    for (bits=0; bits < 8u; bits++)
-    {
-      if (crc & 0x0001)
-      {
-        crc = (crc >> 1) ^ 0xA001;
-      }
-      else
-      {
-        crc >>= 1;
-      }
-    }
-		uiIndex ++;
-  }
-
-  return crc;
+	return CRC_Calc(buffer, uiLength);
 }  // Flash_CRC
@@ -32,26 +32,42 @@
 	//#include  "wdog.h"            /* wdog_clear() */
 
 /* ----- data types --------------------------------------------------------- */
-/* ----- definitions -------------------------------------------------------- */
-static const uint16_t NUMBER_OF_SAMPLES = 16U;
-#define MEASURE_NADIR   (RUN+100)
-#define LAMP_STEP       (RUN+150)
-#define MEASURE_ZENITH  (RUN+200)
+/** @brief      Phases of one lamp-synchronous measurement cycle. Each phase is
+ *              advanced from the TIM14 update interrupt (one lamp PWM period)
+ *              or from the ADC scan completion callback. */
+enum GAS_DAQ_PHASE
+{
+  DAQ_IDLE = 0,
+  DAQ_NADIR_SETTLE,         /**< lamp off, waiting nadir_time */
+  DAQ_MEASURE_NADIR,        /**< ADC burst with the lamp off */
+  DAQ_LAMP_STEP,            /**< stair-stepping the lamp through lamp_data */
+  DAQ_ZENITH_SETTLE,        /**< lamp at last step, waiting zenith_time */
+  DAQ_MEASURE_ZENITH        /**< ADC burst with the lamp on */
+};
 
 /* ----- local variables ---------------------------------------------------- */
 static uint16_t temp_nadir;
 static uint16_t temp_zenith;
 static uint16_t temp_detector_temperature;
 static uint16_t temp_input_volts;
-//static uint16_t temp_lamp_plus_volts;
-//static uint16_t temp_lamp_minus_volts;
-static uint16_t lamp_ctrl_index;
-
-static uint16_t counter;
-static uint32_t avg_detector_temperature;
-static uint32_t avg_nadir;
-static uint32_t avg_zenith;
-//static uint8_t block_flag;
+static uint16_t temp_lamp_plus_volts;
+static uint16_t temp_lamp_minus_volts;
+static volatile uint16_t lamp_ctrl_index;
+
+/* burst results - each already averaged over cal_samples by the ADC */
+static volatile uint16_t avg_detector_temperature;
+static volatile uint16_t avg_nadir;
+static volatile uint16_t avg_zenith;
+static volatile uint16_t avg_input_volts;
+static volatile uint16_t avg_lamp_plus_volts;
+static volatile uint16_t avg_lamp_minus_volts;
+
+static volatile uint8_t  ucDAQ_Phase = DAQ_IDLE;
+static volatile uint16_t uiPhaseCtr;              /* lamp PWM periods left in phase */
+static uint16_t uiLampPeriods[LAMP_ON_STEPS];     /* latched at cycle start */
+static uint8_t  ucLampDuty[LAMP_ON_STEPS];
+static uint16_t uiZenithPeriods;
+static uint16_t uiCycleTicks;                     /* expected cycle length, 10 mS */
 
 /* ----- global declarations ------------------------------------------------ */
 uint16_t  nadir;
@@ -61,28 +77,27 @@ uint16_t  input_volts;
 uint16_t  lamp_plus_volts;
 uint16_t  lamp_minus_volts;
 uint16_t  dsp_adapt_counter;
+uint16_t  raw_sig;
 
 uint8_t		ucGas_DAQ_Step = 0;
 
 /* ----- forward declarations ----------------------------------------------- */
+static uint8_t lamp_volt_to_duty(uint16_t volt);
+static void gas_daq_abort(void);
 
 
 /* -----------------------------------------------------------------------------
- *       synopsis : Periodic task that does the CO2 measurement. The entire
- *                  measurement cycle (lamp control, ADC measurements, etc.) are
- *                  handled in this function.
- *     param [in] : tcb - pointer to the task control block (Tcb) for this task.
+ *       synopsis : Periodic task that does the CO2 measurement. The task only
+ *                  starts a cycle and collects the result; the lamp sequence
+ *                  and the ADC bursts are timed by TIM14/TIM3 in hardware.
  */
-//void gas_daq_task(pTcb tcb)
 void gas_daq_task(void)
 {
-//  uint16_t data;
-	uint16_t uiResult;
+	uint16_t uiStart;
 
 	switch(ucGas_DAQ_Step)
 	{
 	case 0:
-//		uiCO2_Measure_Tmr ++;
 		if(uiCO2_Measure_Tmr< sHRegs.sample_time)
 		{
 			break;
@@ -95,255 +110,225 @@ void gas_daq_task(void)
 	case 1:
 		if(ADC1->ISR & ADC_ISR_ADRDY)			//  Make Sure A/D Ready to Sample
 		{
-			if((uiResult = ADC_Measure(ADC_CHANNEL_GAS_SIGNAL))	> 0)			//  Start CO2 Measurement
-			{
-				sIRegs.raw_sig = uiResult;
-			}
+			gas_daq_start();
+			ucGas_DAQ_Step ++;
 		}
-		if(ADC1->ISR & ADC_ISR_ADRDY)			//  Make Sure A/D Ready to Sample
+		break;
+
+	case 2:
+		if(uiIntFlags.bGas_DAQ_Complete)		//  Set When Zenith Burst Finishes
 		{
-			if((uiResult = ADC_Measure(ADC_CHANNEL_TEMP_SIGNAL)) > 0)			//  Start CO2 Measurement
+			uiIntFlags.bGas_DAQ_Complete = false;
+
+			temp_detector_temperature = avg_detector_temperature;
+			temp_nadir = avg_nadir;
+			temp_zenith = avg_zenith;
+			temp_input_volts = avg_input_volts;
+			temp_lamp_plus_volts = avg_lamp_plus_volts;
+			temp_lamp_minus_volts = avg_lamp_minus_volts;
+
+			/* cache the current measurements so readings are somewhat current */
+			nadir = temp_nadir;
+			zenith = temp_zenith;
+			detector_temperature = temp_detector_temperature;
+			input_volts = temp_input_volts;
+			lamp_plus_volts = temp_lamp_plus_volts;
+			lamp_minus_volts = temp_lamp_minus_volts;
+
+			sIRegs.nadir = nadir;
+			sIRegs.zenith = zenith;
+			sIRegs.temp_signal = detector_temperature;
+			sIRegs.vin_adc = input_volts;
+			sIRegs.v_lamp_plus = lamp_plus_volts;
+			sIRegs.v_lamp_minus = lamp_minus_volts;
+			raw_sig = (zenith > nadir) ? (zenith - nadir) : 0;
+			sIRegs.raw_sig = raw_sig;
+
+			Clock_Request(CLOCK_CLIENT_DSP);
+			if(sIRegs.up_time < sHRegs.warm_up_time)
+				dsp_initialize_gas_ppm();			//  Track the Signal Until Warmed Up
+			else
 			{
-				sIRegs.temp_signal = uiResult;
+				uiStart = Prof_Start();
+				dsp_calculate_gas_ppm();
+				Prof_End(PROF_DSP, uiStart);
+				Abc_Update(norm_sig_avg);
 			}
+			Clock_Release(CLOCK_CLIENT_DSP);
+
+			uiFlags.bCO2_MeasureInProcess = false;
+			ucGas_DAQ_Step = 0;
+		}
+		else if(uiCO2_Measure_Tmr > uiCycleTicks + GAS_DAQ_TIMEOUT_TICKS)
+		{
+			gas_daq_abort();								//  Lamp Off, Try Again Next Period
+			uiFlags.bCO2_MeasureInProcess = false;
+			ucGas_DAQ_Step = 0;
 		}
-		ucGas_DAQ_Step ++;
 		break;
 
 	default:
 		ucGas_DAQ_Step = 0;
 	}
-
-//  switch (tcb->state)
-//  {
-    /* not taking measurements */
-//    case BLOCKED :
-    {
-      /* do nothing */
-      
-    }
-//    break;
-
-    /* Power the amplifier and detector on */
-//    case RUN :
-    {
-      /* let the delay schedule the task */
-//      clear_task_event_flag(GAS_DAQ_EVENT);
-    
-      /* For Sample on Demand */
-/*
-      if (block->first_sample_cf.re == 0)
-      {
-        if (counter1 < block->sample_time/100)
-        {
-          break;
-        }
-        else
-        {
-          counter1 = 0;
-        }
-*/
-        /*      This condition only used to put sensor in sleep for sample on  
-         *      damand while we power up sensor for the first time. 
-         */ 
-/*			
-        if(block_flag == 1)
-        {
-          tcb = get_task(MEAS_PERIOD_TASK);
-          tcb->state = BLOCKED;
-          tcb->delay = TICKS_PER_SECOND;
-          block_flag = 0;
-          flag = 1;
-          counter1 = block->sample_time;
-          norm_sig_avg_alpha = block->dsp_alpha_coeff.re;
-          dsp_adapt_counter = 0;
-          data = WRITE_SINGLE_COIL_ON;
-          break;
-        }
-      }
-*/
-      /* turn on the power to the amp and detector */
-//      data = WRITE_SINGLE_COIL_ON;
-//      (void)lamp_driver_power(0U, &data);
-//      (void)detector_power(0U, &data);
-      
-//      tcb->delay = block->nadir_time;
-//      tcb->state = MEASURE_NADIR;
-
-      /* make sure lamp is off */
-//      data = 0U;
-//      (void)set_dac_lamp_voltage_control(0U, &data);
-
-      /* initialize our measurement variables */
-      temp_nadir = 0U;
-      temp_zenith = 0U;
-      temp_detector_temperature = 0U;
-      temp_input_volts = 0U;
-
-      /* initialize the index into the lamp control array */
-      lamp_ctrl_index = 0U;
-      counter = 0U;
-      avg_detector_temperature = 0U;
-      avg_nadir = 0U;
-      avg_zenith = 0U;
-    }
-//    break;
-
-    /* measure the temperature, measure the nadir and turn on the lamp */
-//    case MEASURE_NADIR :
-    {
-      /* measure the detector temperature */
- //     (void)get_temp_signal(0U, &temp_detector_temperature);
-      avg_detector_temperature += temp_detector_temperature;
-
-      /* measure nadir */
-//      (void)get_gas_signal(0U, &temp_nadir);
-      avg_nadir += temp_nadir;
-
-      if (++counter >= NUMBER_OF_SAMPLES)
-      {
-//        tcb->state = MEASURE_NADIR + 1;
-      }
-      else
-      {
-//        tcb->delay = 1U;
-      }
-    }
-//    break;
-
-//    case MEASURE_NADIR + 1U :
-    {
-      temp_detector_temperature =
-        (uint16_t)(avg_detector_temperature / NUMBER_OF_SAMPLES);
-
-      temp_nadir = (uint16_t)(avg_nadir / NUMBER_OF_SAMPLES);
-
-      /* turn on the lamp */
-//      data = block->lamp_data[lamp_ctrl_index].volt;
-//      (void)set_dac_lamp_voltage_control(0U, &data);
-
-      /* delay before we measure the zenith */
-//      tcb->delay = block->lamp_data[lamp_ctrl_index].time;
-//      tcb->state = LAMP_STEP;
-    }
-//    break;
-
-    /* stairstep the lamp on (i.e., lamp control) */
-//    case LAMP_STEP :
-    {
-      lamp_ctrl_index++;
-      if (lamp_ctrl_index < LAMP_ON_STEPS)
-      {
-//        data = block->lamp_data[lamp_ctrl_index].volt;
-//        (void)set_dac_lamp_voltage_control(0U, &data);
-//        tcb->delay = block->lamp_data[lamp_ctrl_index].time;
-//        tcb->state = LAMP_STEP;
-      }
-      else
-      {
-        counter = 0U;
-        avg_zenith = 0U;
-//        tcb->delay = block->zenith_time;
-//        tcb->state = MEASURE_ZENITH;
-      }
-    }
-//    break;
-
-    /* measure the zenith, measure the input voltage */
-//    case MEASURE_ZENITH :
-    {
-      /* measure zenith */
-//      (void)get_gas_signal(0U, &temp_zenith);
-      avg_zenith += temp_zenith;
-
-      if (++counter >= NUMBER_OF_SAMPLES)
-      {
-//        tcb->state = MEASURE_ZENITH + 1;
-      }
-      else
-      {
-//        tcb->delay = 1U;
-      }
-    }
-//    break;
-
-//    case MEASURE_ZENITH + 1 :
-    {
-      temp_zenith = (uint16_t)(avg_zenith / NUMBER_OF_SAMPLES);
-
-      /* measure the input voltage */
-		
-//      (void)get_vin_adc(0U, &temp_input_volts);
-
-      /* get the lamp voltage */
-/*      (void)get_v_lamp_plus(0U, &temp_lamp_plus_volts);
-      (void)get_v_lamp_minus(0U, &temp_lamp_minus_volts);
-
-      tcb->delay = 1U; // can't be 0 or it won't run!
-      tcb->state = FINISH;
-    }
-    break;
-*/
-//    case FINISH :
-//    {
-      /* turn off the power to the amp and detector */
-/*      data = WRITE_SINGLE_COIL_OFF;
-      (void)lamp_driver_power(0U, &data);
-      (void)detector_power(0U, &data);
-
-      data = 0U;
-      (void)set_dac_lamp_voltage_control(0U, &data);
-
-      tcb->delay = 0U; // has to be 0 or it won't stop!
-      tcb->state = RUN;
-*/
-      /* cache the current measurements so readings are somewhat current */
-/*
-      nadir = temp_nadir;
-      zenith = temp_zenith;
-      detector_temperature = temp_detector_temperature;
-      input_volts = temp_input_volts;
-      lamp_plus_volts = temp_lamp_plus_volts;
-      lamp_minus_volts = temp_lamp_minus_volts;
-*/
-//      if ((STATUS_WARMUP_MODE & status.get_device_status()) != STATUS_WARMUP_MODE)
-//      {
-        /* do the gas ppm calculation - the result is left in the global
-         * variable 'gas_ppm'. see dsp.cpp */
-//        dsp_calculate_gas_ppm();
-//      }
-//      else
-//      {  
-        /* initialize variable for calculating the gas ppm the first time
-         * through */       
-//        dsp_initialize_gas_ppm();
-//      }
-//    }
-//    break;
-/*
-    case INIT :
-    default :
-    {
-      tcb->id = GAS_DAQ_TASK;
-      tcb->state = RUN;
-      tcb->delay = 0U;
-      tcb->last = 0U;
-      tcb->events = GAS_DAQ_EVENT;
-      if (block->avg_ctrl == SPECIAL_MEDIA_FEATURE)
-      {
-        gas_ppm = 550U;
-      }
-      else
-      {
-        gas_ppm = 0U;
-      }
-      if ( block->first_sample_cf.re == 0)
-      {
-        block_flag = 1;
-      }
-    }
-    break;
-*/		
-  }
 } /* gas_daq_task */
 
+/* -----------------------------------------------------------------------------
+ *       synopsis : Number of 10 mS ticks before gas_daq_task() will start the
+ *                  next cycle, so the caller can sleep until then.
+ */
+uint16_t gas_daq_idle_ticks(void)
+{
+	if((ucGas_DAQ_Step != 0) || (uiCO2_Measure_Tmr >= sHRegs.sample_time))
+	{
+		return 0;
+	}
+	return sHRegs.sample_time - uiCO2_Measure_Tmr;
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Latches the lamp profile from the holding registers, turns
+ *                  the lamp off and arms the TIM14 update interrupt that paces
+ *                  the rest of the cycle.
+ */
+void gas_daq_start(void)
+{
+	uiLampPeriods[0] = sHRegs.lamp_data_time_0 * GAS_DAQ_PERIODS_PER_TICK;
+	uiLampPeriods[1] = sHRegs.lamp_data_time_1 * GAS_DAQ_PERIODS_PER_TICK;
+	uiLampPeriods[2] = sHRegs.lamp_data_time_2 * GAS_DAQ_PERIODS_PER_TICK;
+	ucLampDuty[0] = lamp_volt_to_duty(sHRegs.lamp_data_volt_0);
+	ucLampDuty[1] = lamp_volt_to_duty(sHRegs.lamp_data_volt_1);
+	ucLampDuty[2] = lamp_volt_to_duty(sHRegs.lamp_data_volt_2);
+	uiZenithPeriods = sHRegs.zenith_time * GAS_DAQ_PERIODS_PER_TICK;
+
+	uiCycleTicks = sHRegs.nadir_time + sHRegs.lamp_data_time_0 + sHRegs.lamp_data_time_1
+							 + sHRegs.lamp_data_time_2 + sHRegs.zenith_time;
+
+	/* initialize our measurement variables */
+	lamp_ctrl_index = 0U;
+	uiIntFlags.bGas_DAQ_Complete = false;
+	ADC_Set_Oversampling(sHRegs.cal_samples);		//  ADC is Idle Between Cycles
+
+	/* make sure lamp is off, then let the lamp timer schedule the task */
+	SetDutyCycle(0);
+	uiPhaseCtr = sHRegs.nadir_time * GAS_DAQ_PERIODS_PER_TICK;
+	ucDAQ_Phase = DAQ_NADIR_SETTLE;
+	TIM14_EnableUpdateIT();
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Called from the TIM14 update interrupt once per lamp PWM
+ *                  period. A duty cycle written here is preloaded and takes
+ *                  effect on the next update, so every lamp edge and every ADC
+ *                  burst start lands on a PWM period boundary.
+ */
+void gas_daq_lamp_callback(void)
+{
+	if(uiPhaseCtr > 0)
+	{
+		uiPhaseCtr --;
+		return;
+	}
+
+	switch(ucDAQ_Phase)
+	{
+	case DAQ_NADIR_SETTLE:
+		ucDAQ_Phase = DAQ_MEASURE_NADIR;
+		Clock_Request(CLOCK_CLIENT_ADC);			//  Settle Ran Slow, the Burst Runs at Full Speed
+		ADC_Scan_Start();								//  First Scan One Trigger Period After This Edge
+		break;
+
+	/* stairstep the lamp on (i.e., lamp control) */
+	case DAQ_LAMP_STEP:
+		if(++lamp_ctrl_index < LAMP_ON_STEPS)
+		{
+			SetDutyCycle(ucLampDuty[lamp_ctrl_index]);
+			uiPhaseCtr = uiLampPeriods[lamp_ctrl_index];
+		}
+		else
+		{
+			uiPhaseCtr = uiZenithPeriods;
+			ucDAQ_Phase = DAQ_ZENITH_SETTLE;
+		}
+		break;
+
+	case DAQ_ZENITH_SETTLE:
+		ucDAQ_Phase = DAQ_MEASURE_ZENITH;
+		Clock_Request(CLOCK_CLIENT_ADC);
+		ADC_Scan_Start();
+		break;
+
+	case DAQ_MEASURE_NADIR:
+	case DAQ_MEASURE_ZENITH:
+	case DAQ_IDLE:
+	default:
+		break;														//  Waiting on ADC Burst
+	}
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Called from the ADC scan completion callback (DMA interrupt)
+ *                  with a completed scan block. The ADC oversampler has already
+ *                  averaged every channel over the burst, so one scan is the
+ *                  whole burst and moves the cycle on.
+ *     param [in] : puiScan - the completed block, indexed by ADC_SCAN_RANK.
+ */
+void gas_daq_scan_callback(volatile uint16_t *puiScan)
+{
+	switch(ucDAQ_Phase)
+	{
+	/* measure the temperature, measure the nadir */
+	case DAQ_MEASURE_NADIR:
+		ADC_Scan_Stop();
+		Clock_Release(CLOCK_CLIENT_ADC);			//  Before the Duty Write - the Switch Loads TIM14 Preloads
+		avg_detector_temperature = puiScan[ADC_RANK_TEMP_SIGNAL];
+		avg_nadir = puiScan[ADC_RANK_GAS_SIGNAL];
+
+		/* turn on the lamp */
+		lamp_ctrl_index = 0U;
+		SetDutyCycle(ucLampDuty[0]);
+		uiPhaseCtr = uiLampPeriods[0];
+		ucDAQ_Phase = DAQ_LAMP_STEP;
+		break;
+
+	/* measure the zenith, the input voltage and the lamp voltages */
+	case DAQ_MEASURE_ZENITH:
+		ADC_Scan_Stop();
+		avg_zenith = puiScan[ADC_RANK_GAS_SIGNAL];
+		avg_input_volts = puiScan[ADC_RANK_VIN_ADC];
+		avg_lamp_plus_volts = puiScan[ADC_RANK_V_LAMP_PLUS];
+		avg_lamp_minus_volts = puiScan[ADC_RANK_V_LAMP_MINUS];
+		gas_daq_abort();								//  Lamp Off, Timer Interrupt Off
+		uiIntFlags.bGas_DAQ_Complete = true;
+		Sched_Post(TASK_GAS_DAQ, EVT_GAS_DAQ_COMPLETE);
+		break;
+
+	default:
+		break;														//  Trailing Scan After a Stop
+	}
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Ends the cycle - lamp off and the TIM14 update interrupt
+ *                  released so an idle sensor takes no lamp interrupts.
+ */
+static void gas_daq_abort(void)
+{
+	TIM14_DisableUpdateIT();
+	ADC_Scan_Stop();
+	Clock_Release(CLOCK_CLIENT_ADC);
+	ucDAQ_Phase = DAQ_IDLE;
+	SetDutyCycle(0);
+}
+
+/* -----------------------------------------------------------------------------
+ *       synopsis : Converts a lamp_data_volt_N register (lamp DAC counts) to
+ *                  the TIM14 duty cycle in percent.
+ */
+static uint8_t lamp_volt_to_duty(uint16_t volt)
+{
+	if(volt >= LAMP_DAC_FULL_SCALE)
+	{
+		return 100u;
+	}
+	return (uint8_t)(((uint32_t)volt * 100u) / LAMP_DAC_FULL_SCALE);
+}
@@ -20,7 +20,7 @@ void I2C1_Init(void)
 
 //  LL_GPIO_InitTypeDef GPIO_InitStruct = {0};
 
-//  LL_RCC_SetI2CClockSource(LL_RCC_I2C1_CLKSOURCE_PCLK1);
+  LL_RCC_SetI2CClockSource(LL_RCC_I2C1_CLKSOURCE_HSIKER);	//  48 MHz Whatever SYSCLK is - Timing Below Holds
 
 //  LL_IOP_GRP1_EnableClock(LL_IOP_GRP1_PERIPH_GPIOB);
   /**I2C1 GPIO Configuration
@@ -72,6 +72,7 @@ void I2C1_Init(void)
   LL_I2C_DisableOwnAddress2(I2C1);
   LL_I2C_DisableGeneralCall(I2C1);
   LL_I2C_EnableClockStretching(I2C1);
+	TX_DMA_Init(LL_DMAMUX_REQ_I2C1_TX, LL_I2C_DMA_GetRegAddr(I2C1, LL_I2C_DMA_REG_DATA_TRANSMIT));
   /* USER CODE BEGIN I2C1_Init 2 */
 #ifdef SLAVE_BOARD
   uint32_t timing = 0;
@@ -92,39 +93,47 @@ void I2C1_Init(void)
   LL_I2C_EnableIT_ERR(I2C1);
   LL_I2C_EnableIT_STOP(I2C1);
   /* USER CODE END I2C1_Init 2 */
+	if(!uiFlags.bI2C_Mode)
+	{
+		Clock_Request(CLOCK_CLIENT_COMM);				//  Byte Interrupts Need Full Speed
+	}
 	uiFlags.bI2C_Mode = true;
 }
 
-void I2C_SendMessage(void)
+/**
+  * @brief  Queue a Frame for the Master to Read. The DMA Request is TXIS, so
+  *         Nothing Moves Until the Master Addresses us for a Read; the Whole
+  *         Frame Then Goes Out Without Per Byte Interrupts.
+  * @param  sTx - Frame to Send
+  * @retval None
+  */
+void I2C_SendMessage(Buffer &sTx)
 {
-	uint16_t uiSend;
-	
-	if(uiFlags.bI2C_XmtInProcess == false)
+	if((uiFlags.bI2C_XmtInProcess == true) || (sTx.end == 0))
 	{
-		if(TxBuff.end != 0)
-		{
-			uiFlags.bI2C_XmtInProcess = true;
-			TxBuff.ptr = 0;
-//			LL_I2C_GENERATE_START_WRITE();
-		}
+		return;
 	}
 
-	if(TxBuff.ptr < TxBuff.end)
-	{
-		uiSend = TxBuff.Buff[TxBuff.ptr ++];
-	  LL_I2C_TransmitData8(I2C1, uiSend);		
-//		I2C1->TXDR = uiSend;
-//		SET_BIT(I2C1->CR1, I2C_CR1_TXIE);
-	}
-	else
-	{
-		////// send stop bit
-		CLEAR_BIT(I2C1->CR1, I2C_CR1_TXIE);
-		uiFlags.bI2C_XmtInProcess = false;
-	}
+	uiFlags.bI2C_XmtInProcess = true;
+	sTx.ptr = sTx.end;					//  Nothing Left for the CPU to Send
+	LL_I2C_EnableDMAReq_TX(I2C1);
+	TX_DMA_Start(sTx);
 //	ucCommTimeout = 0;					//  Reset Timeout Timer
 }
 
+/**
+  * @brief  Function called from I2C IRQ Handler on STOP - the Master Has
+  *         Finished Reading
+  * @param  None
+  * @retval None
+  */
+void I2C_TxComplete_Callback(void)
+{
+	LL_I2C_DisableDMAReq_TX(I2C1);
+	LL_DMA_DisableChannel(DMA1, TX_DMA_CHANNEL);
+	uiFlags.bI2C_XmtInProcess = false;
+}
+
 /*
 void Slave_Ready_To_Transmit_Callback(void)
 {
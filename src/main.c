@@ -13,9 +13,6 @@
 VolFlags uiIntFlags;								//  Flags Inside Interrupts
 Flags uiFlags;											//  Flags Outside Interrupts
 uint32_t ulTicks = 0;
-uint8_t  ucTick_10mS_acc = 0;
-uint16_t uiTick_1S_acc = 0;
-uint16_t uiTick_1S_Ctr = 0;
 HoldRegs sHRegs;
 HoldRegs *pHRegs = &sHRegs;
 InputRegs sIRegs;
@@ -29,12 +26,24 @@ uint16_t uiLED_Interval = 100;
 //  Function Prototypes
 void SystemClock_Config(void);
 void init(void);
-void Handle_Tick(void);
-void Handle_Tick_10mS(void);
-void Handle_Tick_1S(void);
-void Handle_Robust(void);
+void Handle_Modbus_Frame(uint16_t);
+void Handle_Gas_DAQ(uint16_t);
+void Handle_Comm_Timeout(uint16_t);
+void Handle_Tick_1S(uint16_t);
+void Handle_Robust(uint16_t);
 void IWDG_Init(void);
 
+//  Task Table, in SCHED_TASK (Priority) Order
+Tcb sTasks[SCHED_TASK_COUNT] =
+{
+	//  Task									Period (mS)		Events
+	{ Handle_Modbus_Frame,	0,						EVT_MODBUS_FRAME },
+	{ Handle_Gas_DAQ,				10,						EVT_TIMER | EVT_GAS_DAQ_COMPLETE },
+	{ Handle_Comm_Timeout,	0,						EVT_TIMER },
+	{ Handle_Tick_1S,				1000,					EVT_TIMER },
+	{ Handle_Robust,				16000,				EVT_TIMER }
+};
+
 #ifdef DEMO_BOARD
 /* USER CODE BEGIN PFP */
 void     LED_On(void);
@@ -50,25 +59,7 @@ int main(void)
 {
 	init();
 
-  while (1)
-  {
-		if(uiIntFlags.bTick_1mS)
-		{
-			Handle_Tick();
-		}
-		if(uiIntFlags.bTick_10mS)
-		{
-			Handle_Tick_10mS();
-		}
-		if(uiIntFlags.bTick_1S)
-		{
-			Handle_Tick_1S();
-		}
-		if(uiIntFlags.bRobust)
-		{
-			Handle_Robust();
-		}
-  }
+	Sched_Run();							//  Never Returns
 }
 
 void init(void)
@@ -78,81 +69,140 @@ void init(void)
   LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_PWR);
 
   SystemClock_Config();			//  Configure System Clock
+	CRC_Init();								//  Needed by FlashRestore
+	Power_Init();							//  RTC Wakeup for Stop Mode Idle, Times Flash Erases
 
 	//  Restore Holding Regs from Flash
 	if(FlashRestore() == false)
 	{
 		FlashInitialize();
 	}
+	dsp_load_coefficients();
+	Abc_Init();								//  Rolling Baseline From the Sample Ring
 	
-	Handle_Robust();
+	Handle_Robust(0);
 	ADC1_Activate();
+	ADC_Scan_Init();
 
+	Prof_Init();
 	IWDG_Init();							//  Configure Watchdog Timer
+	Sched_Init();
+	Clock_Release(CLOCK_CLIENT_BOOT);		//  Full Speed From Here Only on Request
 }
 
-void Handle_Tick(void)
+/**
+  * @brief  Measurement Task. Runs Every 10 mS During a Cycle and as Soon as a
+  *         Zenith Burst Completes, so the Result is Processed Without Waiting
+  *         for the Tick. Between Cycles it Sleeps Until the Next One is Due,
+  *         Leaving the Core Free to Stop.
+  * @param  uiEvents - EVT_TIMER and/or EVT_GAS_DAQ_COMPLETE
+  * @retval None
+  */
+void Handle_Gas_DAQ(uint16_t uiEvents)
 {
-	uiIntFlags.bTick_1mS = 0;
-	
+	static uint16_t uiTicks = 1;							//  10 mS Ticks Covered by the Running Delay
+	uint16_t uiStart;
+
+	if(uiEvents & EVT_TIMER)
+	{
+		uiCO2_Measure_Tmr += uiTicks;
+	}
+	uiStart = Prof_Start();
 	gas_daq_task();
+	Prof_End(PROF_GAS_DAQ, uiStart);
 
-	if(++ucCommTimeout > 4)
+	uiTicks = gas_daq_idle_ticks();
+	if(uiTicks > GAS_DAQ_MAX_IDLE_TICKS)
 	{
-		if(uiFlags.bUART_RcvInProcess)
-		{
-			//  Validate Message
-			if(RxBuff.Buff[0] == sHRegs.slave_address)		//  Confirm Address Match
-			{
-				if(Calc_crc(RxBuff) == 0)										//  Validate CRC
-				{
-					Handle_Rcvd_Msg();
-				}
-			}
-			uiFlags.bUART_RcvInProcess = false;						//  Cleanup
-			RxBuff.end = 0;
-		}
-		else if(uiFlags.bUART_XmtInProcess)
-		{
-			SET_BIT(USART1->ICR, USART_ICR_TCCF);					//  Ensure Bit Cleared
-			uiFlags.bUART_XmtInProcess = false;						//  Cleanup
-		}
-		else
-		{
-			ucCommTimeout = 0;
-		}
+		uiTicks = GAS_DAQ_MAX_IDLE_TICKS;
+	}
+	if(uiTicks > 1)
+	{
+		Sched_Delay(TASK_GAS_DAQ, uiTicks * 10u);
+	}
+	else
+	{
+		uiTicks = 1;													//  Periodic Reload Covers One Tick
+	}
+}
+
+/**
+  * @brief  Transmit Cleanup. Started by Each Send and Receive; if the Transfer
+  *         Complete Interrupt Has Not Ended the Transmission by the Time it
+  *         Expires, Clean Up Here.
+  * @param  uiEvents - EVT_TIMER
+  * @retval None
+  */
+void Handle_Comm_Timeout(uint16_t uiEvents)
+{
+	if(uiFlags.bUART_XmtInProcess)
+	{
+		SET_BIT(USART1->ICR, USART_ICR_TCCF);					//  Ensure Bit Cleared
+		uiFlags.bUART_XmtInProcess = false;						//  Cleanup
+		Clock_Release(CLOCK_CLIENT_COMM);
 	}
 }
 
-void Handle_Tick_10mS(void)
+/**
+  * @brief  Validate and Process a Received Modbus Frame. Called as Soon as the
+  *         USART Receiver Timeout Marks the End of the Frame.
+  * @param  uiEvents - EVT_MODBUS_FRAME
+  * @retval None
+  */
+void Handle_Modbus_Frame(uint16_t uiEvents)
 {
-	uiIntFlags.bTick_10mS = 0;
+	uint16_t uiStart;
 
-	uiCO2_Measure_Tmr ++;
+	if(RxBuff.Buff[0] == sHRegs.slave_address)		//  Confirm Address Match
+	{
+		if(uiRxCRC == 0)														//  Validate CRC (Accumulated on Receive)
+		{
+			uiStart = Prof_Start();
+			Handle_Rcvd_Msg(RxBuff, TxBuff);
+			Prof_End(PROF_MODBUS, uiStart);
+		}
+	}
+	if(!uiFlags.bUART_XmtInProcess)
+	{
+		Clock_Release(CLOCK_CLIENT_COMM);					//  No Response to Wait for
+	}
+	RxBuff.end = 0;																//  Cleanup
+	uiIntFlags.bModbus_Frame = false;							//  RxBuff Free for the Next Frame
 }
 
-void Handle_Tick_1S(void)
+void Handle_Tick_1S(uint16_t uiEvents)
 {
-	uiIntFlags.bTick_1S = 0;
+	uint16_t uiStart;
+	bool bQueued;
+
 	sIRegs.up_time ++;
 	
 	if(uiFlags.bFlashCommitInProcess == true)
 	{
 		if(++uiCommit_Timer >= FLASH_COMMIT_TIMEOUT)
 		{
-			FlashCommit();
-			uiFlags.bFlashCommitInProcess = false;
-			uiCommit_Timer = 0;	
+			uiStart = Prof_Start();
+			bQueued = FlashCommit();
+			Prof_End(PROF_FLASH_COMMIT, uiStart);
+			if(bQueued)												//  Queued - Else Busy, Retry Next Second
+			{
+				uiFlags.bFlashCommitInProcess = false;
+				uiCommit_Timer = 0;	
+			}
 		}
 	}
+	else
+	{
+		FlashService();										//  Spare Page Erase, Off the Commit Path
+	}
+	Abc_Tick_1S();
+	Prof_Publish();
 
 	LL_IWDG_ReloadCounter(IWDG);
 }
 
-void Handle_Robust(void)
+void Handle_Robust(uint16_t uiEvents)
 {
-	uiIntFlags.bRobust = 0;
-	
   GPIO_Init();
 	ADC1_Init();
 	TIM14_Init();
@@ -0,0 +1,141 @@
+
+#include "main.h"
+
+uint32_t ulStopCount = 0;							//  Times Stop Mode Was Entered
+
+static bool Power_StopAllowed(void);
+
+/**
+  * @brief  Low Power Initialization Function. Runs the RTC From the LSI With a
+  *         1 mS Sub Second Counter for the Stop Mode Wakeup Alarm, and Routes
+  *         the RTC and USART1 Wakeup Lines (EXTI 19 and 25) to the Core.
+  * @param  None
+  * @retval None
+  */
+void Power_Init(void)
+{
+	LL_RCC_LSI_Enable();
+	while(LL_RCC_LSI_IsReady() != 1)
+	{
+	}
+
+	LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_RTC);
+	if(LL_RCC_GetRTCClockSource() != LL_RCC_RTC_CLKSOURCE_LSI)
+	{
+		LL_RCC_ForceBackupDomainReset();					//  Only Way to Change the Source
+		LL_RCC_ReleaseBackupDomainReset();
+		LL_RCC_SetRTCClockSource(LL_RCC_RTC_CLKSOURCE_LSI);
+	}
+	LL_RCC_EnableRTC();
+
+	LL_RTC_DisableWriteProtection(RTC);
+	LL_RTC_EnableInitMode(RTC);
+	while(LL_RTC_IsActiveFlag_INIT(RTC) != 1)
+	{
+	}
+	LL_RTC_SetAsynchPrescaler(RTC, RTC_PREDIV_A);
+	LL_RTC_SetSynchPrescaler(RTC, RTC_PREDIV_S);
+	LL_RTC_DisableInitMode(RTC);
+	LL_RTC_EnableShadowRegBypass(RTC);				//  Read SSR Directly After Wakeup
+
+	LL_RTC_ALMA_Disable(RTC);
+	LL_RTC_ALMA_SetMask(RTC, LL_RTC_ALMA_MASK_ALL);
+	LL_RTC_ALMA_SetSubSecondMask(RTC, RTC_ALMA_SS_BITS);
+	LL_RTC_ClearFlag_ALRA(RTC);
+	LL_RTC_EnableIT_ALRA(RTC);
+	LL_RTC_EnableWriteProtection(RTC);
+
+	LL_EXTI_EnableIT_0_31(LL_EXTI_LINE_19 | LL_EXTI_LINE_25);
+	NVIC_SetPriority(RTC_IRQn, 3);
+	NVIC_EnableIRQ(RTC_IRQn);
+
+	LL_PWR_SetPowerMode(LL_PWR_MODE_STOP0);
+	LL_PWR_EnableFlashPowerDownInStop();
+}
+
+/**
+  * @brief  Idle Until the Next Interrupt. Called by the Scheduler With
+  *         Interrupts Masked and No Task Ready. If Nothing is in Progress and
+  *         the Next Task is Far Enough Away, the RTC Alarm is Set to Wake
+  *         1 mS Before it and the Core Enters Stop; a Modbus Start of Frame
+  *         Wakes it Through the USART. SysTick Stops With the Core, so the mS
+  *         Spent in Stop are Measured on the RTC and Added to ulTicks; the
+  *         Scheduler Takes Them Off its Task Delays (Which Also Keeps up_time).
+  * @param  uiNextMs - mS Until the Next Task Delay Expires, 0 = None Pending
+  * @retval mS Spent in Stop (0 if Only Slept)
+  */
+uint16_t Power_Idle(uint16_t uiNextMs)
+{
+#ifdef TICKLESS_IDLE
+	uint16_t uiStart, uiSleep, uiElapsed;
+
+	if(((uiNextMs == 0) || (uiNextMs > TICKLESS_MIN_MS)) && Power_StopAllowed())
+	{
+		uiSleep = ((uiNextMs == 0) || (uiNextMs > TICKLESS_MAX_MS)) ? TICKLESS_MAX_MS : uiNextMs - 1u;
+
+		uiStart = Power_GetSubSecond();						//  SS Counts Down
+		LL_RTC_DisableWriteProtection(RTC);
+		LL_RTC_ALMA_SetSubSecond(RTC, (uiStart + RTC_SS_PER_SECOND - uiSleep) % RTC_SS_PER_SECOND);
+		LL_RTC_ClearFlag_ALRA(RTC);
+		LL_RTC_ALMA_Enable(RTC);
+		LL_RTC_EnableWriteProtection(RTC);
+
+		SET_BIT(SCB->SCR, SCB_SCR_SLEEPDEEP_Msk);
+		__WFI();																	//  Stop - Back on HSI at the Same Divider
+		CLEAR_BIT(SCB->SCR, SCB_SCR_SLEEPDEEP_Msk);
+
+		LL_RTC_DisableWriteProtection(RTC);
+		LL_RTC_ALMA_Disable(RTC);
+		LL_RTC_EnableWriteProtection(RTC);
+
+		uiElapsed = (uiStart + RTC_SS_PER_SECOND - Power_GetSubSecond()) % RTC_SS_PER_SECOND;
+		ulTicks += uiElapsed;
+		ulStopCount ++;
+		return uiElapsed;
+	}
+#endif
+	__WFI();																		//  Sleep - SysTick Keeps Counting
+	return 0;
+}
+
+/**
+  * @brief  Function called from RTC IRQ Handler on Alarm A. Only Needs to End
+  *         the Stop; Power_Idle Does the Rest.
+  * @param  None
+  * @retval None
+  */
+void RTC_Alarm_Callback(void)
+{
+	LL_RTC_ClearFlag_ALRA(RTC);
+}
+
+/**
+  * @brief  Read the RTC Sub Second Counter. With the Shadow Registers Bypassed
+  *         Read Until Two Agree.
+  * @param  None
+  * @retval SS, RTC_PREDIV_S Down to 0
+  */
+uint16_t Power_GetSubSecond(void)
+{
+	uint32_t ulSS;
+
+	do
+	{
+		ulSS = LL_RTC_TIME_GetSubSecond(RTC);
+	} while(ulSS != LL_RTC_TIME_GetSubSecond(RTC));
+	return (uint16_t)ulSS;
+}
+
+/**
+  * @brief  Stop Gates Every Clock but the LSI and the USART Kernel Clock, so
+  *         Only Allow it When No Transfer, Measurement or Flash Job is in
+  *         Progress. I2C
+  *         Mode Stays Awake.
+  * @param  None
+  * @retval true if Stop May be Entered
+  */
+static bool Power_StopAllowed(void)
+{
+	return !(uiFlags.bI2C_Mode || uiFlags.bUART_RcvInProcess || uiFlags.bUART_XmtInProcess ||
+					 uiFlags.bCO2_MeasureInProcess || uiIntFlags.bModbus_Frame || FlashBusy());
+}
@@ -0,0 +1,91 @@
+
+#include "main.h"
+
+static ProfStat sProfStats[PROF_SECTION_COUNT];
+
+/**
+  * @brief  Start TIM17 Free Running at PROF_TIMER_HZ
+  * @param  None
+  * @retval None
+  */
+void Prof_Init(void)
+{
+  LL_TIM_InitTypeDef TIM_InitStruct = {0};
+
+  LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_TIM17);
+
+  TIM_InitStruct.Prescaler = __LL_TIM_CALC_PSC(SystemCoreClock, PROF_TIMER_HZ);
+  TIM_InitStruct.CounterMode = LL_TIM_COUNTERMODE_UP;
+  TIM_InitStruct.Autoreload = 0xffff;
+  TIM_InitStruct.ClockDivision = LL_TIM_CLOCKDIVISION_DIV1;
+  LL_TIM_Init(PROF_TIMER, &TIM_InitStruct);
+  LL_TIM_EnableCounter(PROF_TIMER);
+}
+
+/**
+  * @brief  Close a Section and Fold its Time Into the Statistics. Sections
+  *         Never Nest With Themselves, so Updates Can Not Interleave; the
+  *         Reader Takes its Copy With Interrupts Masked (Prof_Publish).
+  * @param  ucSection - PROF_SECTION
+  * @param  uiStart - Prof_Start() at Entry
+  * @retval None
+  */
+void Prof_End(uint8_t ucSection, uint16_t uiStart)
+{
+	ProfStat *pStat = &sProfStats[ucSection];
+	uint16_t uiTime = (uint16_t)(Prof_Start() - uiStart);
+
+	if(pStat->ulCount ++ == 0)
+	{
+		pStat->uiMin = uiTime;
+		pStat->uiMax = uiTime;
+		pStat->ulAvg = (uint32_t)uiTime << PROF_AVG_SHIFT;
+		return;
+	}
+	if(uiTime < pStat->uiMin)
+	{
+		pStat->uiMin = uiTime;
+	}
+	if(uiTime > pStat->uiMax)
+	{
+		pStat->uiMax = uiTime;
+	}
+	pStat->ulAvg += uiTime - (pStat->ulAvg >> PROF_AVG_SHIFT);
+}
+
+//  Copies One Section's Statistics to its Input Registers
+#define PROF_PUBLISH(X, Id, Name) \
+	Prof_Copy(PROF_##Id, &sStat); \
+	sIRegs.prof_##Name##_min = sStat.uiMin; \
+	sIRegs.prof_##Name##_max = sStat.uiMax; \
+	sIRegs.prof_##Name##_avg = (uint16_t)(sStat.ulAvg >> PROF_AVG_SHIFT); \
+	sIRegs.prof_##Name##_count = sStat.ulCount;
+
+/**
+  * @brief  Snapshot One Section's Statistics. The ISR Sections Update Them
+  *         From Interrupts, so the Copy is Taken With Interrupts Masked to
+  *         Keep Minimum, Maximum, Average and Count From the Same Update.
+  * @param  ucSection - PROF_SECTION
+  * @param  pStat - Copy Out
+  * @retval None
+  */
+static void Prof_Copy(uint8_t ucSection, ProfStat *pStat)
+{
+	uint32_t ulPrimask = __get_PRIMASK();
+
+	__disable_irq();
+	*pStat = sProfStats[ucSection];
+	__set_PRIMASK(ulPrimask);
+}
+
+/**
+  * @brief  Copy the Statistics to the Input Registers. Called Once a Second.
+  * @param  None
+  * @retval None
+  */
+void Prof_Publish(void)
+{
+	ProfStat sStat;
+
+	PROF_SECTION_LIST(PROF_PUBLISH, ~)
+}
@@ -14,7 +14,31 @@ bool SetDutyCycle(uint8_t uiDutyCycle)
 }
 
 /**
-  * @brief TIM14 Initialization Function
+  * @brief  Enable the TIM14 Update Interrupt (One per Lamp PWM Period)
+  * @param  None
+  * @retval None
+  */
+void TIM14_EnableUpdateIT(void)
+{
+	LL_TIM_ClearFlag_UPDATE(TIM14);
+	LL_TIM_EnableIT_UPDATE(TIM14);
+}
+
+/**
+  * @brief  Disable the TIM14 Update Interrupt
+  * @param  None
+  * @retval None
+  */
+void TIM14_DisableUpdateIT(void)
+{
+	LL_TIM_DisableIT_UPDATE(TIM14);
+	LL_TIM_ClearFlag_UPDATE(TIM14);
+}
+
+/**
+  * @brief TIM14 Initialization Function. Left Alone While a Measurement is
+  *        in Progress, as LL_TIM_Init Generates an Update Event That Restarts
+  *        the Counter and Would Cut Short the Current Lamp Phase.
   * @param None
   * @retval None
   */
@@ -26,6 +50,11 @@ void TIM14_Init(void)
   uint32_t timxPrescaler = __LL_TIM_CALC_PSC(SystemCoreClock, 50000);
 //  uint32_t timxPeriod = __LL_TIM_CALC_ARR(TimOutClock, timxPrescaler, 100);
 
+  if(uiFlags.bCO2_MeasureInProcess)
+  {
+    return;															//  Lamp Cycle Running - Leave it Be
+  }
+
   LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_TIM14); 		// Peripheral clock enable
 
   TIM_InitStruct.Prescaler = timxPrescaler;
@@ -51,6 +80,9 @@ void TIM14_Init(void)
   LL_TIM_CC_EnableChannel(TIM14, LL_TIM_CHANNEL_CH1);
   LL_TIM_EnableCounter(TIM14);
 
+  NVIC_SetPriority(TIM14_IRQn, 0);		//  Lamp Edges Pace the Measurement Cycle
+  NVIC_EnableIRQ(TIM14_IRQn);
+
 //	LL_TIM_GenerateEvent_UPDATE(TIM14);		/// ???
 	
 }
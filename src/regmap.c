@@ -0,0 +1,77 @@
+
+#include "main.h"
+
+//  One Descriptor per Register Number; a 32 Bit Value Gives Two, High Word First
+#define REG_DESC_U16(Regs, Name, Access, Validator) \
+	{ (uint16_t)offsetof(Regs, Name), UNSIGNED_INTEGER, Access, Validator },
+#define REG_DESC_U32(Regs, Name, Access, Validator) \
+	{ (uint16_t)(offsetof(Regs, Name) + 2u), UNSIGNED_LONG, Access, NULL }, \
+	{ (uint16_t)offsetof(Regs, Name), UNSIGNED_LONG, Access, NULL },
+#define REG_DESC_F32(Regs, Name, Access, Validator) \
+	{ (uint16_t)(offsetof(Regs, Name) + 2u), FLOAT_VALUE, Access, NULL }, \
+	{ (uint16_t)offsetof(Regs, Name), FLOAT_VALUE, Access, NULL },
+
+#define HREG_DESC(Type, Name, Default, Validator)	REG_DESC_##Type(HoldRegs, Name, REG_READ_WRITE, Validator)
+#define IREG_DESC(Type, Name, Default, Validator)	REG_DESC_##Type(InputRegs, Name, REG_READ_ONLY, Validator)
+#define HREG_FIELD(Type, Name, Default, Validator)	{ (uint16_t)offsetof(HoldRegs, Name), (uint8_t)sizeof(REG_CTYPE_##Type) },
+#define HREG_END(Type, Name, Default, Validator)	(uint16_t)(offsetof(HoldRegs, Name) + sizeof(REG_CTYPE_##Type)),
+
+const RegDesc sHRegMap[] =
+{
+	HOLDING_REGISTER_MAP(HREG_DESC)
+};
+
+const RegDesc sIRegMap[] =
+{
+	INPUT_REGISTER_MAP(IREG_DESC)
+};
+
+const uint16_t uiHRegCount = sizeof(sHRegMap) / sizeof(sHRegMap[0]);
+const uint16_t uiIRegCount = sizeof(sIRegMap) / sizeof(sIRegMap[0]);
+
+const RegField sHRegFields[] =
+{
+	HOLDING_REGISTER_MAP(HREG_FIELD)
+};
+const uint16_t uiHRegFieldCount = sizeof(sHRegFields) / sizeof(sHRegFields[0]);
+
+//  Flash Record is the Holding Registers up to the End of the Last One
+static constexpr uint16_t uiHRegEnd[] =
+{
+	HOLDING_REGISTER_MAP(HREG_END)
+};
+const uint16_t uiHRegRecordSize = uiHRegEnd[sizeof(uiHRegEnd) / sizeof(uiHRegEnd[0]) - 1u];
+
+/**
+  * @brief  Modbus Slave Addresses are 1 to 247
+  * @param  uiValue - Value Being Written
+  * @retval true if Valid
+  */
+bool Reg_Valid_Slave_Address(uint16_t uiValue)
+{
+	return (uiValue >= 1u) && (uiValue <= 247u);
+}
+
+/**
+  * @brief  Baud Rate, Either Literal or in Hundreds Below 1200 (See
+  *         USART1_GetBaudRate)
+  * @param  uiValue - Value Being Written
+  * @retval true if Valid
+  */
+bool Reg_Valid_Baud_Rate(uint16_t uiValue)
+{
+	uint32_t ulBaud = (uiValue < 1200u) ? (uint32_t)uiValue * 100u : uiValue;
+
+	return (ulBaud >= 1200u) && (ulBaud <= 115200u);
+}
+
+/**
+  * @brief  Averaging Control is One of the Avg_Ctrl_States or the Special
+  *         Media Feature
+  * @param  uiValue - Value Being Written
+  * @retval true if Valid
+  */
+bool Reg_Valid_Avg_Ctrl(uint16_t uiValue)
+{
+	return (uiValue <= EIGHTH_AVERAGING) || (uiValue == SPECIAL_MEDIA_FEATURE);
+}
@@ -0,0 +1,170 @@
+
+#include "main.h"
+
+volatile uint16_t uiSchedReady = 0;		//  Bit per Task, Set While it is Ready
+
+/**
+  * @brief  Scheduler Initialization Function. Starts Every Periodic Task's
+  *         Delay; Call Once the Peripherals are Up, Before Sched_Run.
+  * @param  None
+  * @retval None
+  */
+void Sched_Init(void)
+{
+	uint8_t i;
+
+	__disable_irq();
+	for(i = 0; i < SCHED_TASK_COUNT; i++)
+	{
+		sTasks[i].uiDelay = sTasks[i].uiPeriod;
+		sTasks[i].uiEvents = 0;
+		sTasks[i].ucState = TASK_WAITING;
+	}
+	uiSchedReady = 0;
+	__enable_irq();
+}
+
+/**
+  * @brief  Run Ready Tasks Forever, Highest Priority First, Each to Completion.
+  *         With Nothing Ready the Core Idles (See Power_Idle) Until an
+  *         Interrupt Posts an Event. Interrupts are Masked Around the Ready
+  *         Check so an Event Posted Just Before the WFI Still Wakes it (a
+  *         Pending Interrupt Ends WFI Even With PRIMASK Set; it is Taken Once
+  *         Unmasked).
+  * @param  None
+  * @retval None
+  */
+void Sched_Run(void)
+{
+	uint8_t ucTask;
+	uint16_t uiEvents;
+	Tcb *pTcb;
+
+	while(1)
+	{
+		__disable_irq();
+		if(uiSchedReady == 0)
+		{
+			Sched_Advance(Power_Idle(Sched_NextDelay()));
+			__enable_irq();
+			continue;
+		}
+
+		for(ucTask = 0; !(uiSchedReady & (1u << ucTask)); ucTask++)
+		{
+		}
+		pTcb = &sTasks[ucTask];
+		uiEvents = pTcb->uiEvents;							//  Take the Events Atomically
+		pTcb->uiEvents = 0;
+		pTcb->ucState = TASK_RUNNING;
+		uiSchedReady &= ~(1u << ucTask);
+		__enable_irq();
+
+		pTcb->pTask(uiEvents);
+
+		__disable_irq();
+		if(pTcb->ucState == TASK_RUNNING)					//  Unless Posted Again While Running
+		{
+			pTcb->ucState = TASK_WAITING;
+		}
+		__enable_irq();
+	}
+}
+
+/**
+  * @brief  Function called from SysTick IRQ Handler Every mS. Counts Down Each
+  *         Task's Delay and Posts EVT_TIMER When it Expires. Periodic Tasks are
+  *         Reloaded Here so Their Period Does Not Drift With Run Time.
+  * @param  None
+  * @retval None
+  */
+void Sched_Tick(void)
+{
+	uint8_t i;
+
+	for(i = 0; i < SCHED_TASK_COUNT; i++)
+	{
+		if(sTasks[i].uiDelay && (--sTasks[i].uiDelay == 0))
+		{
+			sTasks[i].uiDelay = sTasks[i].uiPeriod;
+			Sched_Post(i, EVT_TIMER);
+		}
+	}
+}
+
+/**
+  * @brief  Take Time Spent With SysTick Stopped Off the Task Delays. A Delay
+  *         That Would Have Expired is Left With 1 mS so the Next Tick Posts
+  *         it (and Reloads it) the Normal Way. Call With Interrupts Masked.
+  * @param  uiElapsed - mS
+  * @retval None
+  */
+void Sched_Advance(uint16_t uiElapsed)
+{
+	uint8_t i;
+
+	for(i = 0; (i < SCHED_TASK_COUNT) && uiElapsed; i++)
+	{
+		if(sTasks[i].uiDelay)
+		{
+			sTasks[i].uiDelay = (sTasks[i].uiDelay > uiElapsed) ? sTasks[i].uiDelay - uiElapsed : 1u;
+		}
+	}
+}
+
+/**
+  * @brief  mS Until the First Task Delay Expires. Call With Interrupts Masked.
+  * @param  None
+  * @retval mS, 0 if no Delay is Running
+  */
+uint16_t Sched_NextDelay(void)
+{
+	uint16_t uiNext = 0;
+	uint8_t i;
+
+	for(i = 0; i < SCHED_TASK_COUNT; i++)
+	{
+		if(sTasks[i].uiDelay && ((uiNext == 0) || (sTasks[i].uiDelay < uiNext)))
+		{
+			uiNext = sTasks[i].uiDelay;
+		}
+	}
+	return uiNext;
+}
+
+/**
+  * @brief  Post Events to a Task, Making it Ready if Any are in its Mask.
+  *         Callable From Interrupts and the Main Loop.
+  * @param  ucTask - SCHED_TASK
+  * @param  uiEvents - EVT_ Bits
+  * @retval None
+  */
+void Sched_Post(uint8_t ucTask, uint16_t uiEvents)
+{
+	uint32_t ulPrimask = __get_PRIMASK();
+
+	__disable_irq();
+	sTasks[ucTask].uiEvents |= uiEvents;
+	if(sTasks[ucTask].uiEvents & sTasks[ucTask].uiEventMask)
+	{
+		sTasks[ucTask].ucState = TASK_READY;
+		uiSchedReady |= 1u << ucTask;
+	}
+	__set_PRIMASK(ulPrimask);
+}
+
+/**
+  * @brief  (Re)Start a Task's Delay. For a Task With No Period This is a One
+  *         Shot Timer; 0 Cancels it. Callable From Interrupts and the Main Loop.
+  * @param  ucTask - SCHED_TASK
+  * @param  uiDelay - mS Until EVT_TIMER
+  * @retval None
+  */
+void Sched_Delay(uint8_t ucTask, uint16_t uiDelay)
+{
+	uint32_t ulPrimask = __get_PRIMASK();
+
+	__disable_irq();
+	sTasks[ucTask].uiDelay = uiDelay;
+	__set_PRIMASK(ulPrimask);
+}
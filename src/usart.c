@@ -3,11 +3,20 @@
 
 Buffer RxBuff;
 Buffer TxBuff;
-uint8_t ucCommTimeout = 0;
+uint8_t ucRxRing[RX_RING_SIZE];				//  Written by DMA, Every Byte on the Bus
+uint16_t uiRxRingHead = 0;						//  First Byte Not Yet Framed
+uint8_t ucRxAddress;									//  Address Byte, Read by the CPU
 uint16_t uiCommit_Timer = 0;
+static bool bFastBaud;								//  Frames Hold Full Speed (CLOCK_CLIENT_COMM)
+static uint32_t ulBaudRate;						//  As Programmed, for the Transmit Time
+
+static void RX_DMA_Init(void);
 
 /**
-  * @brief USART1 Initialization Function
+  * @brief USART1 Initialization Function. Left Alone While a Frame is Being
+  *        Received, Waits to be Answered or is Being Sent: Re-Arming the
+  *        Address Interrupt and Clearing RTOF Mid-Frame Would Take the Next
+  *        Data Byte for an Address. The Next Periodic Re-Init Catches Up.
   * @param None
   * @retval None
   */
@@ -15,16 +24,24 @@ void USART1_Init(void)
 {
   LL_USART_InitTypeDef USART_InitStruct = {0};		//  Initialize Structures
 
-  LL_RCC_SetUSARTClockSource(LL_RCC_USART1_CLKSOURCE_PCLK1);
+  if(uiFlags.bUART_RcvInProcess || uiFlags.bUART_XmtInProcess || uiIntFlags.bModbus_Frame)
+  {
+    return;
+  }
+
+  LL_RCC_HSIKER_SetDivider(LL_RCC_HSIKER_DIV_1);			//  48 MHz, Same as PCLK1
+  LL_RCC_SetUSARTClockSource(LL_RCC_USART1_CLKSOURCE_HSIKER);	//  Kernel Clock Available in Stop
 
   LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_USART1);	//  Enable Peripheral Clock
 
   NVIC_SetPriority(USART1_IRQn, 1);		//  Setup USART Interrupt
   NVIC_EnableIRQ(USART1_IRQn);
-  LL_USART_EnableIT_RXNE(USART1);
+  LL_USART_EnableIT_RXNE_RXFNE(USART1);		//  Address Byte Only - See USART1_Address_Callback
 
   USART_InitStruct.PrescalerValue = LL_USART_PRESCALER_DIV4;
-  USART_InitStruct.BaudRate = 19200;
+  USART_InitStruct.BaudRate = USART1_GetBaudRate();
+  bFastBaud = (USART_InitStruct.BaudRate > CLOCK_COMM_FAST_BAUD);
+  ulBaudRate = USART_InitStruct.BaudRate;
   USART_InitStruct.DataWidth = LL_USART_DATAWIDTH_9B;
   USART_InitStruct.StopBits = LL_USART_STOPBITS_1;
   USART_InitStruct.Parity = LL_USART_PARITY_EVEN;
@@ -34,13 +51,36 @@ void USART1_Init(void)
   LL_USART_Init(USART1, &USART_InitStruct);
   LL_USART_SetTXFIFOThreshold(USART1, LL_USART_FIFOTHRESHOLD_1_8);
   LL_USART_SetRXFIFOThreshold(USART1, LL_USART_FIFOTHRESHOLD_1_8);
-  LL_USART_DisableFIFO(USART1);
+  LL_USART_EnableFIFO(USART1);
   LL_USART_ConfigAsyncMode(USART1);
+	TX_DMA_Init(LL_DMAMUX_REQ_USART1_TX, LL_USART_DMA_GetRegAddr(USART1, LL_USART_DMA_REG_DATA_TRANSMIT));
+	RX_DMA_Init();
+
+	//  Frames for Other Slaves are Dropped by Mute Mode Until the Line Goes Idle
+	LL_USART_SetWakeUpMethod(USART1, LL_USART_WAKEUP_IDLELINE);
+	LL_USART_EnableMuteMode(USART1);
+
+	//  An Address Byte Wakes the Core From Stop (RXNE Interrupt, EXTI 25)
+	LL_USART_SetWKUPType(USART1, LL_USART_WAKEUP_ON_RXNE);
+	LL_USART_EnableInStopMode(USART1);
 
   /* USER CODE BEGIN WKUPType USART1 */
 	SET_BIT(USART1->CR2, USART_CR2_SWAP);
   /* USER CODE END WKUPType USART1 */
 
+	//  End of Frame is t3.5 of Line Silence, Timed by the Receiver in Bit Times
+	if(USART_InitStruct.BaudRate > MODBUS_FIXED_T35_BAUD)
+	{
+		LL_USART_SetRxTimeout(USART1, (MODBUS_FIXED_T35_US * (USART_InitStruct.BaudRate / 100u) + 9999u) / 10000u);
+	}
+	else
+	{
+		LL_USART_SetRxTimeout(USART1, (MODBUS_BITS_PER_CHAR * 35u + 9u) / 10u);
+	}
+	LL_USART_EnableRxTimeout(USART1);
+	LL_USART_ClearFlag_RTO(USART1);
+	LL_USART_EnableIT_RTO(USART1);
+
   LL_USART_Enable(USART1);
 	SET_BIT(USART1->ICR, USART_ICR_TCCF);		//  Clear Bit Before Enabling Interrupt
 	SET_BIT(USART1->CR1, USART_CR1_TCIE);
@@ -51,60 +91,251 @@ void USART1_Init(void)
   }
 
 	USART1_Error_Callback();
+	if(uiFlags.bI2C_Mode)
+	{
+		Clock_Release(CLOCK_CLIENT_COMM);				//  Held for I2C
+	}
 	uiFlags.bI2C_Mode = false;
 }
 
 /**
-  * @brief  Function called from USART IRQ Handler when RXNE flag is set
-  *         Function is in charge of reading character received on USART RX line.
+  * @brief  Configure DMA1 Channel 3 to Copy Every Received Byte Into the
+  *         Circular Ring. Left Alone if Already Running so the Periodic
+  *         Re-Init Does Not Lose a Frame in Progress.
+  * @param  None
+  * @retval None
+  */
+static void RX_DMA_Init(void)
+{
+  LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+
+  if(LL_DMA_IsEnabledChannel(DMA1, RX_DMA_CHANNEL))
+  {
+    return;
+  }
+
+  LL_DMA_SetPeriphRequest(DMA1, RX_DMA_CHANNEL, LL_DMAMUX_REQ_USART1_RX);
+  LL_DMA_ConfigTransfer(DMA1, RX_DMA_CHANNEL,
+                        LL_DMA_DIRECTION_PERIPH_TO_MEMORY |
+                        LL_DMA_MODE_CIRCULAR |
+                        LL_DMA_PERIPH_NOINCREMENT |
+                        LL_DMA_MEMORY_INCREMENT |
+                        LL_DMA_PDATAALIGN_BYTE |
+                        LL_DMA_MDATAALIGN_BYTE |
+                        LL_DMA_PRIORITY_HIGH);
+  LL_DMA_ConfigAddresses(DMA1, RX_DMA_CHANNEL,
+                         LL_USART_DMA_GetRegAddr(USART1, LL_USART_DMA_REG_DATA_RECEIVE),
+                         (uint32_t)(uintptr_t)ucRxRing,
+                         LL_DMA_DIRECTION_PERIPH_TO_MEMORY);
+  LL_DMA_SetDataLength(DMA1, RX_DMA_CHANNEL, RX_RING_SIZE);
+  LL_DMA_EnableIT_TE(DMA1, RX_DMA_CHANNEL);
+  LL_DMA_EnableChannel(DMA1, RX_DMA_CHANNEL);
+	uiRxRingHead = 0;
+}
+
+/**
+  * @brief  Function called from DMA IRQ Handler on a Receive Transfer Error.
+  *         Restarts the Ring; Any Partial Frame is Lost.
   * @param  None
   * @retval None
   */
-void USART1_CharReception_Callback(void)
+void RX_DMA_Error_Callback(void)
 {
-  __IO uint32_t received_char;
+	LL_DMA_DisableChannel(DMA1, RX_DMA_CHANNEL);
+	RX_DMA_Init();
+}
 
-  //  Read Received character. RXNE flag is cleared by reading of RDR register
-  received_char = LL_USART_ReceiveData8(USART1);
-	if(!uiFlags.bUART_RcvInProcess)
+/**
+  * @brief  Function called from USART IRQ Handler when RXNE flag is set. Only
+  *         Enabled Between Frames, so This is the Address Byte. For Us, the
+  *         Rest of the Frame is Left to DMA; Otherwise the Receiver is Muted
+  *         and Drops the Rest of the Frame in Hardware.
+  * @param  None
+  * @retval None
+  */
+void USART1_Address_Callback(void)
+{
+	ucRxAddress = LL_USART_ReceiveData8(USART1);
+	if((ucRxAddress == sHRegs.slave_address) && !uiIntFlags.bModbus_Frame)
 	{
-		RxBuff.ptr = 0;
+		LL_USART_DisableIT_RXNE_RXFNE(USART1);
+		uiRxRingHead = (RX_RING_SIZE - LL_DMA_GetDataLength(DMA1, RX_DMA_CHANNEL)) & (RX_RING_SIZE - 1);
+		LL_USART_EnableDMAReq_RX(USART1);
 		uiFlags.bUART_RcvInProcess = true;
+		if(bFastBaud)
+		{
+			Clock_Request(CLOCK_CLIENT_COMM);			//  Until the Response Has Gone Out
+		}
+	}
+	else
+	{
+		LL_USART_RequestRxDataFlush(USART1);
+		LL_USART_RequestEnterMuteMode(USART1);
 	}
-	queue_enqueue(RxBuff, received_char);
-	ucCommTimeout = 0;					//  Reset Timeout Timer
 }
 
 /**
-  * @brief  Function called from USART IRQ Handler when TC flag is set
-  *         Function is in charge of sending characters on USART TX line.
+  * @brief  Function called from USART IRQ Handler when RTOF flag is set, i.e.,
+  *         t3.5 After the Last Character. If the Frame Was Addressed to Us,
+  *         What the DMA Wrote Since the Address is the Rest of it; Copy it Out
+  *         of the Ring (Running the CRC on the Way) and Hand it to the Main
+  *         Loop. Either Way, Go Back to Waiting for an Address.
   * @param  None
   * @retval None
   */
-void USART1_SendMessage(void)
+void USART1_RxTimeout_Callback(void)
 {
-	uint16_t uiSend;
-	
-	if(uiFlags.bUART_XmtInProcess == false)
+	uint16_t uiTail, uiLength;
+
+	LL_USART_DisableDMAReq_RX(USART1);
+	uiTail = (RX_RING_SIZE - LL_DMA_GetDataLength(DMA1, RX_DMA_CHANNEL)) & (RX_RING_SIZE - 1);
+	uiLength = (uiTail - uiRxRingHead) & (RX_RING_SIZE - 1);
+
+	if(uiFlags.bUART_RcvInProcess && (uiLength < BUFFER_SIZE))
 	{
-		if(TxBuff.end != 0)
+		RxBuff.Buff[0] = ucRxAddress;
+		uiRxCRC = CRC_Update(CRC16_INIT_VALUE, ucRxAddress);
+		for(RxBuff.end = 1; RxBuff.end <= uiLength; RxBuff.end ++)
 		{
-			uiFlags.bUART_XmtInProcess = true;
-			TxBuff.ptr = 0;
+			RxBuff.Buff[RxBuff.end] = ucRxRing[uiRxRingHead];
+			uiRxCRC = CRC_Update(uiRxCRC, RxBuff.Buff[RxBuff.end]);	//  Frame CRC is 0 if Intact
+			uiRxRingHead = (uiRxRingHead + 1) & (RX_RING_SIZE - 1);
 		}
+		RxBuff.ptr = 0;
+		uiIntFlags.bModbus_Frame = true;
+		Sched_Post(TASK_MODBUS, EVT_MODBUS_FRAME);
+	}
+	else
+	{
+		Clock_Release(CLOCK_CLIENT_COMM);
 	}
+	uiFlags.bUART_RcvInProcess = false;
+	uiRxRingHead = uiTail;
+	LL_USART_EnableIT_RXNE_RXFNE(USART1);		//  Next Byte is an Address
+	Sched_Delay(TASK_COMM_TIMEOUT, COMM_TIMEOUT_MS);		//  Reset Timeout Timer
+}
 
-	SET_BIT(USART1->ICR, USART_ICR_TCCF);
-	if(TxBuff.ptr < TxBuff.end)
+/**
+  * @brief  Baud Rate From the Holding Register. Values Below 1200 are in
+  *         Hundreds of Baud so Rates Above 65535 Fit (e.g., 1152 = 115200).
+  * @param  None
+  * @retval Baud Rate
+  */
+uint32_t USART1_GetBaudRate(void)
+{
+	uint32_t ulBaud = sHRegs.baud_rate;
+
+	if(ulBaud < 1200u)
 	{
-		uiSend = TxBuff.Buff[TxBuff.ptr ++];
-		USART1->TDR = uiSend;
+		ulBaud *= 100u;
 	}
-	else
+	if((ulBaud < 1200u) || (ulBaud > 115200u))
 	{
-		uiFlags.bUART_XmtInProcess = false;
+		ulBaud = DEFAULT_BAUD_RATE;
 	}
-	ucCommTimeout = 0;					//  Reset Timeout Timer
+	return ulBaud;
+}
+
+/**
+  * @brief  Send a Frame. The Whole Frame is Handed to DMA; the USART TC
+  *         Interrupt Fires Once When the Last Stop Bit Has Gone Out. The
+  *         Cleanup Timeout Runs From the Frame's Line Time, as Stop Mode
+  *         (Allowed Once it Expires) Halts the DMA.
+  * @param  sTx - Frame to Send
+  * @retval None
+  */
+void USART1_SendMessage(Buffer &sTx)
+{
+	if(sTx.end == 0)
+	{
+		return;
+	}
+
+	uiFlags.bUART_XmtInProcess = true;
+	sTx.ptr = sTx.end;					//  Nothing Left for the CPU to Send
+
+	SET_BIT(USART1->ICR, USART_ICR_TCCF);
+	LL_USART_EnableDMAReq_TX(USART1);
+	TX_DMA_Start(sTx);
+	Sched_Delay(TASK_COMM_TIMEOUT, COMM_TIMEOUT_MS + (sTx.end * MODBUS_BITS_PER_CHAR * 1000u + ulBaudRate - 1u) / ulBaudRate);
+}
+
+/**
+  * @brief  Function called from USART IRQ Handler when TC flag is set
+  * @param  None
+  * @retval None
+  */
+void USART1_TxComplete_Callback(void)
+{
+	SET_BIT(USART1->ICR, USART_ICR_TCCF);
+	LL_USART_DisableDMAReq_TX(USART1);
+	LL_DMA_DisableChannel(DMA1, TX_DMA_CHANNEL);
+	uiFlags.bUART_XmtInProcess = false;
+	Sched_Delay(TASK_COMM_TIMEOUT, 0);
+	Clock_Release(CLOCK_CLIENT_COMM);
+}
+
+/**
+  * @brief  Configure the Transmit DMA Channel for a Peripheral. USART1 and
+  *         I2C1 Share the Channel; Only One of Them is in Use at a Time and
+  *         Each Claims it From its Init Function.
+  * @param  ulRequest - DMAMUX Request Line
+  * @param  ulPeriphAddr - Transmit Data Register Address
+  * @retval None
+  */
+void TX_DMA_Init(uint32_t ulRequest, uint32_t ulPeriphAddr)
+{
+  LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+
+  if(LL_DMA_IsEnabledChannel(DMA1, TX_DMA_CHANNEL))
+  {
+    return;															//  Response Going Out - Leave it Be
+  }
+
+  NVIC_SetPriority(DMA1_Channel2_3_IRQn, 1);
+  NVIC_EnableIRQ(DMA1_Channel2_3_IRQn);
+
+  LL_DMA_DisableChannel(DMA1, TX_DMA_CHANNEL);
+  LL_DMA_SetPeriphRequest(DMA1, TX_DMA_CHANNEL, ulRequest);
+  LL_DMA_ConfigTransfer(DMA1, TX_DMA_CHANNEL,
+                        LL_DMA_DIRECTION_MEMORY_TO_PERIPH |
+                        LL_DMA_MODE_NORMAL |
+                        LL_DMA_PERIPH_NOINCREMENT |
+                        LL_DMA_MEMORY_INCREMENT |
+                        LL_DMA_PDATAALIGN_BYTE |
+                        LL_DMA_MDATAALIGN_BYTE |
+                        LL_DMA_PRIORITY_MEDIUM);
+  LL_DMA_SetPeriphAddress(DMA1, TX_DMA_CHANNEL, ulPeriphAddr);
+  LL_DMA_EnableIT_TE(DMA1, TX_DMA_CHANNEL);
+}
+
+/**
+  * @brief  Start the Transmit DMA on a Frame
+  * @param  sTx - Frame, Bytes 0 to end - 1
+  * @retval None
+  */
+void TX_DMA_Start(const Buffer &sTx)
+{
+  LL_DMA_DisableChannel(DMA1, TX_DMA_CHANNEL);
+  LL_DMA_ClearFlag_GI2(DMA1);
+  LL_DMA_SetMemoryAddress(DMA1, TX_DMA_CHANNEL, (uint32_t)(uintptr_t)sTx.Buff);
+  LL_DMA_SetDataLength(DMA1, TX_DMA_CHANNEL, sTx.end);
+  LL_DMA_EnableChannel(DMA1, TX_DMA_CHANNEL);
+}
+
+/**
+  * @brief  Function called from DMA IRQ Handler on a Transmit Transfer Error.
+  *         Drops the Response; the Master Will Retry.
+  * @param  None
+  * @retval None
+  */
+void TX_DMA_Error_Callback(void)
+{
+	LL_DMA_DisableChannel(DMA1, TX_DMA_CHANNEL);
+	LL_USART_DisableDMAReq_TX(USART1);
+	LL_I2C_DisableDMAReq_TX(I2C1);
+	uiFlags.bUART_XmtInProcess = false;
+	uiFlags.bI2C_XmtInProcess = false;
 }
 
 /**
@@ -137,6 +368,10 @@ void USART1_Error_Callback(void)
 	{
 		SET_BIT(USART1->ICR, USART_ICR_IDLECF);
 	}
+	if(isr_reg & LL_USART_ISR_RTOF)
+	{
+		SET_BIT(USART1->ICR, USART_ICR_RTOCF);
+	}
 	if(isr_reg & LL_USART_ISR_TXFE)
 	{
 	  WRITE_REG(USART1->TDR, isr_reg);
@@ -177,7 +412,7 @@ bool queue_enqueue(Buffer &buff, uint8_t data)
  * Note that if the head and tail indexes are equal then there is nothing in the
  * queue, regardless if it wrapped around or not.
  *//*
-bool queue_dequeue(Buffer buff, uint8_t* data)
+bool queue_dequeue(Buffer &buff, uint8_t* data)
 {
   bool result = false;
 